@@ -7,6 +7,10 @@ namespace SharpDetect.Core.Commands;
 
 [Union((int)ProfilerCommandType.CreateStackSnapshot, typeof(CreateStackTraceSnapshotCommand))]
 [Union((int)ProfilerCommandType.CreateStackSnapshots, typeof(CreateStackTraceSnapshotsCommand))]
+[Union((int)ProfilerCommandType.SetMethodDescriptorActive, typeof(SetMethodDescriptorActiveCommand))]
+[Union((int)ProfilerCommandType.SetFieldsAccessInstrumentation, typeof(SetFieldsAccessInstrumentationCommand))]
+[Union((int)ProfilerCommandType.SetStackTraceCollectionMaxDepth, typeof(SetStackTraceCollectionMaxDepthCommand))]
+[Union((int)ProfilerCommandType.DrainBarrier, typeof(DrainBarrierCommand))]
 public interface IProfilerCommandArgs
 {
     
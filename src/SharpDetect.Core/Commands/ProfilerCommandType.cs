@@ -8,5 +8,11 @@ public enum ProfilerCommandType
     Unspecified = 0,
     
     CreateStackSnapshot = 1,
-    CreateStackSnapshots = 2
+    CreateStackSnapshots = 2,
+    
+    SetMethodDescriptorActive = 10,
+    SetFieldsAccessInstrumentation = 11,
+    SetStackTraceCollectionMaxDepth = 12,
+    
+    DrainBarrier = 20
 }
\ No newline at end of file
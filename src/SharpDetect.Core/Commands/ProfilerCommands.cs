@@ -13,3 +13,21 @@ public sealed record CreateStackTraceSnapshotCommand(
 [MessagePackObject]
 public sealed record CreateStackTraceSnapshotsCommand(
     [property: Key(0)] ThreadId[] ThreadIds) : IProfilerCommandArgs;
+
+[MessagePackObject]
+public sealed record SetMethodDescriptorActiveCommand(
+    [property: Key(0)] string DeclaringTypeFullName,
+    [property: Key(1)] string MethodName,
+    [property: Key(2)] bool IsActive) : IProfilerCommandArgs;
+
+[MessagePackObject]
+public sealed record SetFieldsAccessInstrumentationCommand(
+    [property: Key(0)] ModuleId[] ModuleIds,
+    [property: Key(1)] bool IsEnabled) : IProfilerCommandArgs;
+
+[MessagePackObject]
+public sealed record SetStackTraceCollectionMaxDepthCommand(
+    [property: Key(0)] uint MaxDepth) : IProfilerCommandArgs;
+
+[MessagePackObject]
+public sealed record DrainBarrierCommand : IProfilerCommandArgs;
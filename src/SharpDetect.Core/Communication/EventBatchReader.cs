@@ -10,6 +10,7 @@ public sealed class EventBatchReader
 {
     private readonly IRecordedEventParser _parser;
     private readonly uint _pid;
+    private readonly InternedStackTraces _stackTraces = new();
     private ReadOnlyMemory<byte> _batch;
     private int _offset;
     private bool _exhausted = true;
@@ -54,9 +55,44 @@ public sealed class EventBatchReader
                     lastFailure);
             }
 
+            if (format == (byte)RecordedEventType.StackTraceDefinition)
+            {
+                // Consumed here, enter events receive the resolved frames
+                if (FixedEventFormat.TryReadStackTraceDefinition(record.Span, out var stackTraceId, out var stackFrames))
+                {
+                    _stackTraces.Define(stackTraceId, stackFrames);
+                }
+                else
+                {
+                    failedRecords++;
+                    lastFailure = new InvalidDataException(
+                        $"Malformed stack trace definition record ({record.Length} bytes).");
+                }
+
+                continue;
+            }
+
+            if (format == (byte)RecordedEventType.StackSampleHistogram)
+            {
+                // Sampled by a native thread of the profiler, there is no managed thread to attribute it to
+                if (FixedEventFormat.TryReadStackSampleHistogram(record.Span, _stackTraces, out var histogramArgs))
+                {
+                    destination[count] = new RecordedEvent(new RecordedEventMetadata(_pid, default), histogramArgs);
+                    count++;
+                }
+                else
+                {
+                    failedRecords++;
+                    lastFailure = new InvalidDataException(
+                        $"Malformed stack sample histogram record ({record.Length} bytes).");
+                }
+
+                continue;
+            }
+
             if (format != FixedEventFormat.MsgPackFormat)
             {
-                if (FixedEventFormat.TryRead(format, record.Span, out var threadId, out var eventArgs))
+                if (FixedEventFormat.TryRead(format, record.Span, _stackTraces, out var threadId, out var eventArgs))
                 {
                     destination[count] = new RecordedEvent(new RecordedEventMetadata(_pid, threadId), eventArgs);
                     count++;
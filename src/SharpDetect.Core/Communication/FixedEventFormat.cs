@@ -20,10 +20,12 @@ public static class FixedEventFormat
 
     private const int BlobLengthSize = sizeof(uint);
     private const uint AbsentBlob = 0xFFFFFFFFu;
+    private const uint InternedStackTrace = 0xFFFFFFFEu;
 
     public static bool TryRead(
         byte format,
         ReadOnlySpan<byte> payload,
+        InternedStackTraces stackTraces,
         out ThreadId threadId,
         [NotNullWhen(true)] out IRecordedEventArgs? eventArgs)
     {
@@ -61,7 +63,7 @@ public static class FixedEventFormat
             
             case RecordedEventType.MethodEnterWithArguments:
             {
-                if (!TryReadBlobs(body, out var argumentValues, out var argumentInfos, out var stackFrames))
+                if (!TryReadBlobs(body, stackTraces, out var argumentValues, out var argumentInfos, out var stackFrames))
                     return false;
 
                 eventArgs = new MethodEnterWithArgumentsRecordedEvent(
@@ -71,7 +73,7 @@ public static class FixedEventFormat
 
             case RecordedEventType.MethodExitWithArguments:
             {
-                if (!TryReadBlobs(body, out var returnValue, out var byRefValues, out var byRefInfos)
+                if (!TryReadBlobs(body, stackTraces: null, out var returnValue, out var byRefValues, out var byRefInfos)
                     || byRefInfos is null)
                 {
                     return false;
@@ -89,9 +91,67 @@ public static class FixedEventFormat
         threadId = new ThreadId((nuint)rawThreadId);
         return true;
     }
+
+    /// <summary>
+    /// [u32 stackTraceId][frames], precedes the first enter event referring to the stack trace
+    /// </summary>
+    public static bool TryReadStackTraceDefinition(
+        ReadOnlySpan<byte> payload,
+        out uint stackTraceId,
+        [NotNullWhen(true)] out byte[]? stackFrames)
+    {
+        stackTraceId = 0;
+        stackFrames = null;
+
+        if (payload.Length < sizeof(uint))
+            return false;
+
+        stackTraceId = BinaryPrimitives.ReadUInt32LittleEndian(payload);
+        stackFrames = [.. payload[sizeof(uint)..]];
+        return true;
+    }
+    
+    /// <summary>
+    /// [u32 samplingPeriod][u32 walks][u32 count][count x (u32 stackTraceId, u32 samples)]
+    /// </summary>
+    public static bool TryReadStackSampleHistogram(
+        ReadOnlySpan<byte> payload,
+        InternedStackTraces stackTraces,
+        [NotNullWhen(true)] out StackSampleHistogramRecordedEvent? eventArgs)
+    {
+        eventArgs = null;
+
+        const int headerSize = 3 * sizeof(uint);
+        const int entrySize = 2 * sizeof(uint);
+        if (payload.Length < headerSize)
+            return false;
+
+        var samplingPeriod = BinaryPrimitives.ReadUInt32LittleEndian(payload);
+        var walks = BinaryPrimitives.ReadUInt32LittleEndian(payload[sizeof(uint)..]);
+        var count = BinaryPrimitives.ReadUInt32LittleEndian(payload[(2 * sizeof(uint))..]);
+        var entries = payload[headerSize..];
+        if ((long)count * entrySize != entries.Length)
+            return false;
+
+        var samples = new StackSample[count];
+        for (var index = 0; index < samples.Length; index++)
+        {
+            var entry = entries.Slice(index * entrySize, entrySize);
+            var stackTraceId = BinaryPrimitives.ReadUInt32LittleEndian(entry);
+            // Samples of stacks whose definition was lost by a sink are kept without frames
+            if (!stackTraces.TryResolve(stackTraceId, out var stackFrames))
+                stackFrames = [];
+
+            samples[index] = new StackSample(stackFrames, BinaryPrimitives.ReadUInt32LittleEndian(entry[sizeof(uint)..]));
+        }
+
+        eventArgs = new StackSampleHistogramRecordedEvent(samplingPeriod, walks, samples);
+        return true;
+    }
     
     private static bool TryReadBlobs(
         ReadOnlySpan<byte> body,
+        InternedStackTraces? stackTraces,
         [NotNullWhen(true)] out byte[]? first,
         [NotNullWhen(true)] out byte[]? second,
         out byte[]? third)
@@ -108,17 +168,32 @@ public static class FixedEventFormat
         var secondLength = BinaryPrimitives.ReadUInt32LittleEndian(body[BlobLengthSize..]);
         var thirdLength = BinaryPrimitives.ReadUInt32LittleEndian(body[(2 * BlobLengthSize)..]);
         var thirdIsAbsent = thirdLength == AbsentBlob;
+        // Interned stack traces are referred to by a u32 id in place of the blob
+        var thirdIsInterned = thirdLength == InternedStackTrace && stackTraces is not null;
         if (thirdIsAbsent)
             thirdLength = 0;
+        else if (thirdIsInterned)
+            thirdLength = sizeof(uint);
 
         var blobs = body[lengthsSize..];
         var declared = (long)firstLength + secondLength + thirdLength;
         if (declared != blobs.Length)
             return false;
 
+        var thirdBlob = blobs.Slice((int)(firstLength + secondLength), (int)thirdLength);
+        if (thirdIsInterned)
+        {
+            // The definition was lost by a sink, the event itself is still delivered
+            if (!stackTraces!.TryResolve(BinaryPrimitives.ReadUInt32LittleEndian(thirdBlob), out third))
+                third = [];
+        }
+        else
+        {
+            third = thirdIsAbsent ? null : [.. thirdBlob];
+        }
+
         first = [.. blobs[..(int)firstLength]];
         second = [.. blobs.Slice((int)firstLength, (int)secondLength)];
-        third = thirdIsAbsent ? null : [.. blobs.Slice((int)(firstLength + secondLength), (int)thirdLength)];
         return true;
     }
 }
@@ -0,0 +1,26 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+using System.Diagnostics.CodeAnalysis;
+
+namespace SharpDetect.Core.Communication;
+
+/// <summary>
+/// Stack frames interned by a single profiled process, referred to by ids in its enter events
+/// </summary>
+public sealed class InternedStackTraces
+{
+    private readonly Dictionary<uint, byte[]> _stackFrames = [];
+
+    public int Count => _stackFrames.Count;
+
+    public void Define(uint stackTraceId, byte[] stackFrames)
+    {
+        _stackFrames[stackTraceId] = stackFrames;
+    }
+
+    public bool TryResolve(uint stackTraceId, [NotNullWhen(true)] out byte[]? stackFrames)
+    {
+        return _stackFrames.TryGetValue(stackTraceId, out stackFrames);
+    }
+}
@@ -36,7 +36,9 @@ namespace SharpDetect.Core.Events;
 [Union((int)RecordedEventType.MethodBodyRewrite, typeof(MethodBodyRewriteRecordedEvent))]
 [Union((int)RecordedEventType.StackTraceSnapshot, typeof(StackTraceSnapshotRecordedEvent))]
 [Union((int)RecordedEventType.StackTraceSnapshots, typeof(StackTraceSnapshotsRecordedEvent))]
+[Union((int)RecordedEventType.DrainBarrier, typeof(DrainBarrierRecordedEvent))]
 [Union((int)RecordedEventType.FieldAccessInstrumentation, typeof(FieldAccessInstrumentationRecordedEvent))]
+[Union((int)RecordedEventType.StackSampleHistogram, typeof(StackSampleHistogramRecordedEvent))]
 public interface IRecordedEventArgs
 {
 }
@@ -40,7 +40,9 @@ public abstract class RecordedEventActionVisitorBase
             case MethodBodyRewriteRecordedEvent methodBodyRewriteArgs: Visit(metadata, methodBodyRewriteArgs); break;
             case StackTraceSnapshotRecordedEvent stackTraceSnapshotArgs: Visit(metadata, stackTraceSnapshotArgs); break;
             case StackTraceSnapshotsRecordedEvent stackTraceSnapshotsArgs: Visit(metadata, stackTraceSnapshotsArgs); break;
+            case DrainBarrierRecordedEvent drainBarrierArgs: Visit(metadata, drainBarrierArgs); break;
             case FieldAccessInstrumentationRecordedEvent fieldAccessInstrumentationArgs: Visit(metadata, fieldAccessInstrumentationArgs); break;
+            case StackSampleHistogramRecordedEvent stackSampleHistogramArgs: Visit(metadata, stackSampleHistogramArgs); break;
             default: throw new NotSupportedException($"{nameof(RecordedEventActionVisitorBase)} does not support {args.GetType()}.");
         }
     }
@@ -138,8 +140,14 @@ public abstract class RecordedEventActionVisitorBase
     protected virtual void Visit(RecordedEventMetadata metadata, StackTraceSnapshotsRecordedEvent args)
         => DefaultVisit(metadata, args);
     
+    protected virtual void Visit(RecordedEventMetadata metadata, DrainBarrierRecordedEvent args)
+        => DefaultVisit(metadata, args);
+    
     protected virtual void Visit(RecordedEventMetadata metadata, FieldAccessInstrumentationRecordedEvent args)
         => DefaultVisit(metadata, args);
+    
+    protected virtual void Visit(RecordedEventMetadata metadata, StackSampleHistogramRecordedEvent args)
+        => DefaultVisit(metadata, args);
 
     protected virtual void DefaultVisit(RecordedEventMetadata metadata, IRecordedEventArgs args)
         => throw new NotImplementedException($"{nameof(RecordedEventActionVisitorBase)} is missing implementation for {args.GetType()}.");
@@ -53,8 +53,10 @@ public enum RecordedEventType : ushort
     /* Stack trace snapshots */
     StackTraceSnapshot = 36,
     StackTraceSnapshots = 37,
-    //Reserved = 38,
-    //Reserved = 39,
+
+    /* Event stream */
+    DrainBarrier = 38,
+    StackTraceDefinition = 39,
 
     /* Instrumentation */
     FieldAccessInstrumentation = 40,
@@ -63,6 +65,9 @@ public enum RecordedEventType : ushort
     InstanceFieldRead = 43,
     InstanceFieldWrite = 44,
 
+    /* Sampling */
+    StackSampleHistogram = 45,
+
     /* Exceptions */
     MethodUnwound = 90,
 
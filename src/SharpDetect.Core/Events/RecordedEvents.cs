@@ -175,6 +175,23 @@ public sealed record StackTraceSnapshotRecordedEvent(
 public sealed record StackTraceSnapshotsRecordedEvent(
     [property: Key(0)] StackTraceSnapshotRecordedEvent[] Snapshots) : IRecordedEventArgs;
 
+[MessagePackObject]
+public sealed record StackSample(
+    [property: Key(0)] byte[] StackFrames,
+    [property: Key(1)] uint Count);
+
+[MessagePackObject]
+public sealed record StackSampleHistogramRecordedEvent(
+    [property: Key(0)] uint SamplingPeriodMilliseconds,
+    [property: Key(1)] uint Walks,
+    [property: Key(2)] StackSample[] Samples) : IRecordedEventArgs;
+
+[MessagePackObject]
+public sealed record DrainBarrierRecordedEvent(
+    [property: Key(0)] ulong Sequence,
+    [property: Key(1)] bool Flushed,
+    [property: Key(2)] ulong FlushedSequence) : IRecordedEventArgs;
+
 [MessagePackObject]
 public sealed record FieldAccessInstrumentationRecordedEvent(
     [property: Key(0)] ModuleId ModuleId,
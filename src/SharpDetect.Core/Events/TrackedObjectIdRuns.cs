@@ -0,0 +1,101 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+using System.Diagnostics.CodeAnalysis;
+using SharpDetect.Core.Events.Profiler;
+
+namespace SharpDetect.Core.Events;
+
+/// <summary>
+/// Compact encoding of tracked object id sets used by garbage collection events.
+/// [varint count] followed by [varint gap][varint runLength - 1] for every run of consecutive ids,
+/// where gap is the distance from the end of the previous run. Varints are unsigned LEB128.
+/// </summary>
+public static class TrackedObjectIdRuns
+{
+    private const int MaxVarintSize = 10;
+
+    public static byte[] Encode(IReadOnlyList<TrackedObjectId> sortedIds)
+    {
+        var buffer = new List<byte>();
+        WriteVarint(buffer, (ulong)sortedIds.Count);
+
+        ulong previousEnd = 0;
+        for (var begin = 0; begin < sortedIds.Count;)
+        {
+            var end = begin + 1;
+            while (end < sortedIds.Count && sortedIds[end].Value == sortedIds[end - 1].Value + 1)
+                end++;
+
+            var first = (ulong)sortedIds[begin].Value;
+            WriteVarint(buffer, first - previousEnd);
+            WriteVarint(buffer, (ulong)(end - begin - 1));
+            previousEnd = (ulong)sortedIds[end - 1].Value + 1;
+            begin = end;
+        }
+
+        return buffer.ToArray();
+    }
+
+    public static bool TryDecode(ReadOnlySpan<byte> payload, [NotNullWhen(true)] out TrackedObjectId[]? ids)
+    {
+        ids = null;
+        if (!TryReadVarint(ref payload, out var count) || count > int.MaxValue)
+            return false;
+
+        var result = new List<TrackedObjectId>((int)Math.Min(count, (ulong)payload.Length / 2 * 128));
+        ulong previousEnd = 0;
+        while (!payload.IsEmpty)
+        {
+            if (!TryReadVarint(ref payload, out var gap) ||
+                !TryReadVarint(ref payload, out var runLength) ||
+                runLength >= count - (ulong)result.Count)
+            {
+                return false;
+            }
+
+            // Runs must not wrap around the id space
+            if (gap > ulong.MaxValue - previousEnd || runLength > ulong.MaxValue - previousEnd - gap)
+                return false;
+
+            var begin = previousEnd + gap;
+            for (ulong offset = 0; offset <= runLength; offset++)
+                result.Add(new TrackedObjectId((nuint)(begin + offset)));
+            previousEnd = begin + runLength + 1;
+        }
+
+        if ((ulong)result.Count != count)
+            return false;
+
+        ids = result.ToArray();
+        return true;
+    }
+
+    private static void WriteVarint(List<byte> buffer, ulong value)
+    {
+        while (value >= 0x80)
+        {
+            buffer.Add((byte)(value | 0x80));
+            value >>= 7;
+        }
+
+        buffer.Add((byte)value);
+    }
+
+    private static bool TryReadVarint(ref ReadOnlySpan<byte> payload, out ulong value)
+    {
+        value = 0;
+        for (var index = 0; index < payload.Length && index < MaxVarintSize; index++)
+        {
+            var current = payload[index];
+            value |= (ulong)(current & 0x7F) << (7 * index);
+            if ((current & 0x80) == 0)
+            {
+                payload = payload[(index + 1)..];
+                return true;
+            }
+        }
+
+        return false;
+    }
+}
@@ -51,12 +51,21 @@ public sealed class Consumer : IDisposable
     {
         ObjectDisposedException.ThrowIf(_disposed, this);
 
-        if (timeout < TimeSpan.Zero || !_semaphore.Wait(timeout))
+        if ((timeout < TimeSpan.Zero && timeout != Timeout.InfiniteTimeSpan) || !_semaphore.Wait(timeout))
             return Error(DequeueErrorType.TimeoutExceeded);
 
         return _queue.Dequeue();
     }
 
+    /// <summary>
+    /// Wakes up a thread blocked in <see cref="TryDequeue(TimeSpan)"/>; the woken dequeue reports nothing to read.
+    /// </summary>
+    public void Wake()
+    {
+        ObjectDisposedException.ThrowIf(_disposed, this);
+        _semaphore.Release();
+    }
+
     public void Dispose()
     {
         if (_disposed)
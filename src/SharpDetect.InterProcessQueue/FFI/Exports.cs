@@ -187,7 +187,9 @@ internal static unsafe class Exports
 
         try
         {
-            var result = consumer.TryDequeue(TimeSpan.FromMilliseconds(timeoutMs));
+            // Negative timeout blocks until a message arrives or the consumer is woken up
+            var timeout = timeoutMs < 0 ? Timeout.InfiniteTimeSpan : TimeSpan.FromMilliseconds(timeoutMs);
+            var result = consumer.TryDequeue(timeout);
             return result.IsSuccess ? CopyToUnmanaged(result.Value, dataPtr, sizePtr) : result.Error;
         }
         catch (ObjectDisposedException)
@@ -196,6 +198,34 @@ internal static unsafe class Exports
         }
     }
 
+    [UnmanagedCallersOnly(EntryPoint = "ipq_consumer_wake")]
+    public static void WakeConsumer(nint consumerHandle)
+    {
+        try
+        {
+            WakeConsumerImpl(consumerHandle);
+        }
+        catch (Exception ex)
+        {
+            ReportUnexpectedError(nameof(WakeConsumer), ex);
+        }
+    }
+
+    internal static void WakeConsumerImpl(nint consumerHandle)
+    {
+        if (!Consumers.TryGetValue(consumerHandle, out var consumer))
+            return;
+
+        try
+        {
+            consumer.Wake();
+        }
+        catch (ObjectDisposedException)
+        {
+            // Consumer is being destroyed, there is nobody to wake up
+        }
+    }
+
     private static DequeueErrorType CopyToUnmanaged(QueueMessage message, byte** dataPtr, int* sizePtr)
     {
         using (message)
@@ -38,6 +38,12 @@ internal sealed class LinuxSemaphore : ISemaphore
     public bool Wait(TimeSpan timeout)
     {
         ObjectDisposedException.ThrowIf(_isDisposed, this);
+        if (timeout == Timeout.InfiniteTimeSpan)
+        {
+            LinuxSemaphoreInterop.Wait(_handle);
+            return true;
+        }
+
         return LinuxSemaphoreInterop.Wait(_handle, timeout);
     }
 
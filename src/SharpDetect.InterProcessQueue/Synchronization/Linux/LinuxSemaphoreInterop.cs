@@ -40,6 +40,22 @@ internal static partial class LinuxSemaphoreInterop
         throw new UnreachableException();
     }
     
+    public static void Wait(IntPtr handle)
+    {
+        const int EINTR = 4;
+        int error;
+
+        do
+        {
+            if (SemaphoreWait(handle) == 0)
+                return;
+
+            error = Marshal.GetLastPInvokeError();
+        } while (error == EINTR);
+
+        ThrowInteropFailed();
+    }
+
     public static bool Wait(IntPtr handle, TimeSpan timeout)
     {
         var deadline = DateTimeOffset.UtcNow.Add(timeout);
@@ -109,6 +125,9 @@ internal static partial class LinuxSemaphoreInterop
     [LibraryImport(Library, EntryPoint = "sem_trywait", SetLastError = true)]
     private static partial int SemaphoreTryWait(nint semaphore);
     
+    [LibraryImport(Library, EntryPoint = "sem_wait", SetLastError = true)]
+    private static partial int SemaphoreWait(nint semaphore);
+
     [LibraryImport(Library, EntryPoint = "sem_timedwait", SetLastError = true)]
     private static partial int SemaphoreTimedWait(nint semaphore, ref Timespec absTime);
 
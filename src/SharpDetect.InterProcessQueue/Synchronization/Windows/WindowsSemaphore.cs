@@ -40,6 +40,10 @@ internal sealed class WindowsSemaphore : ISemaphore
     private static int ToTimeoutMs(TimeSpan timeout)
     {
         // Value 0xFFFFFFFF is reserved for INFINITE
+        const int infinite = -1;
+        if (timeout == Timeout.InfiniteTimeSpan)
+            return infinite;
+
         var totalMs = timeout.TotalMilliseconds;
         return totalMs >= int.MaxValue - 1 ? int.MaxValue - 1 : (int)totalMs;
     }
@@ -0,0 +1,89 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <string>
+
+#include "doctest.h"
+#include "Configuration.h"
+
+namespace
+{
+    Profiler::Configuration Parse(const std::string& settings, const std::string& additionalData)
+    {
+        return nlohmann::json::parse(
+        R"({
+            "eventMask": 0,
+            "sharedMemoryName": "events",
+            "sharedMemorySize": 1024,
+            "sharedMemorySemaphoreName": "eventsSemaphore",
+            "commandQueueName": "commands",
+            "commandQueueSize": 1024,
+            "commandSemaphoreName": "commandsSemaphore",
+            "registrationQueueName": "registrations",
+            "registrationQueueSize": 1024,
+            )" + settings + R"(
+            "additionalData": {
+                "methodDescriptors": [],
+                "typeInjectionDescriptors": [],
+                )" + additionalData + R"(
+                "enableFieldsAccessInstrumentation": false
+            }
+        })").get<Profiler::Configuration>();
+    }
+}
+
+TEST_CASE("Configuration keeps defaults of omitted native settings")
+{
+    auto const configuration = Parse("", "");
+
+    CHECK(configuration.eventSink == "ipq");
+    CHECK(configuration.secondaryEventSinks.empty());
+    CHECK_FALSE(configuration.traceFilePath.has_value());
+    CHECK_FALSE(configuration.socketEndpoint.has_value());
+    CHECK(configuration.deferGcBookkeeping == FALSE);
+    CHECK(configuration.stackTraceCaptureMode == "snapshot");
+    CHECK(configuration.stackSamplingPeriod == 0);
+}
+
+TEST_CASE("Configuration reads native settings from the additional data")
+{
+    auto const configuration = Parse("",
+    R"(
+        "eventSink": "socket",
+        "secondaryEventSinks": [ "traceFile" ],
+        "traceFilePath": "trace",
+        "socketEndpoint": "127.0.0.1:9000",
+        "trackedObjectCacheSize": 16,
+        "deferGcBookkeeping": true,
+        "stackTraceCaptureMode": "shadowStack",
+        "stackSamplingPeriod": 5,
+        "stackSamplingReportPeriod": 500,
+    )");
+
+    CHECK(configuration.eventSink == "socket");
+    CHECK(configuration.secondaryEventSinks == std::vector<std::string> { "traceFile" });
+    REQUIRE(configuration.traceFilePath.has_value());
+    CHECK(configuration.traceFilePath->starts_with("trace."));
+    CHECK(configuration.socketEndpoint == "127.0.0.1:9000");
+    CHECK(configuration.trackedObjectCacheSize == 16);
+    CHECK(configuration.deferGcBookkeeping == TRUE);
+    CHECK(configuration.stackTraceCaptureMode == "shadowStack");
+    CHECK(configuration.stackSamplingPeriod == 5);
+    CHECK(configuration.stackSamplingReportPeriod == 500);
+}
+
+TEST_CASE("Configuration prefers top-level native settings over the additional data")
+{
+    auto const configuration = Parse(
+    R"(
+        "eventSink": "traceFile",
+        "stackSamplingPeriod": 10,
+    )",
+    R"(
+        "eventSink": "socket",
+        "stackSamplingPeriod": 5,
+    )");
+
+    CHECK(configuration.eventSink == "traceFile");
+    CHECK(configuration.stackSamplingPeriod == 10);
+}
@@ -25,6 +25,21 @@ void Profiler::to_json(nlohmann::json& json, const Configuration& descriptor)
         json["registrationQueueFile"] = descriptor.registrationQueueFile.value();
     json["registrationQueueSize"] = descriptor.registrationQueueSize;
 
+    json["eventSink"] = descriptor.eventSink;
+    json["secondaryEventSinks"] = descriptor.secondaryEventSinks;
+    json["secondaryEventSinkBufferSize"] = descriptor.secondaryEventSinkBufferSize;
+    if (descriptor.traceFilePath.has_value())
+        json["traceFilePath"] = descriptor.traceFilePath.value();
+    json["traceFileSegmentSize"] = descriptor.traceFileSegmentSize;
+    json["traceFileMaxSize"] = descriptor.traceFileMaxSize;
+    if (descriptor.socketEndpoint.has_value())
+        json["socketEndpoint"] = descriptor.socketEndpoint.value();
+    json["trackedObjectCacheSize"] = descriptor.trackedObjectCacheSize;
+    json["deferGcBookkeeping"] = descriptor.deferGcBookkeeping;
+    json["stackTraceCaptureMode"] = descriptor.stackTraceCaptureMode;
+    json["stackSamplingPeriod"] = descriptor.stackSamplingPeriod;
+    json["stackSamplingReportPeriod"] = descriptor.stackSamplingReportPeriod;
+
     json["additionalData"]["methodDescriptors"] = descriptor.methodDescriptors;
     json["additionalData"]["fieldAccessIntrinsicDescriptors"] = descriptor.fieldAccessIntrinsicDescriptors;
     json["additionalData"]["typeInjectionDescriptors"] = descriptor.typeInjectionDescriptors;
@@ -33,6 +48,7 @@ void Profiler::to_json(nlohmann::json& json, const Configuration& descriptor)
     json["additionalData"]["enableStackTraceCollection"] = descriptor.enableStackTraceCollection;
     json["additionalData"]["stackTraceCollectionMaxDepth"] = descriptor.stackTraceCollectionMaxDepth;
     json["additionalData"]["stackTraceCollectionForFields"] = descriptor.stackTraceCollectionForFields;
+    json["additionalData"]["enableRuntimeReconfiguration"] = descriptor.enableRuntimeReconfiguration;
 }
 
 void Profiler::from_json(const nlohmann::json& json, Configuration& descriptor)
@@ -78,7 +94,44 @@ void Profiler::from_json(const nlohmann::json& json, Configuration& descriptor)
     }
     descriptor.registrationQueueSize = json.at("registrationQueueSize");
 
+    // Native-only settings are optional and may also be passed through the additional data (which is
+    // all the managed launcher writes), top-level values take precedence
     const auto& additionalData = json.at("additionalData");
+    const auto findSetting = [&](const char* name) -> const nlohmann::json*
+    {
+        if (const auto it = json.find(name); it != json.cend())
+            return &*it;
+        if (const auto it = additionalData.find(name); it != additionalData.cend())
+            return &*it;
+        return nullptr;
+    };
+
+    // The live IPC queue is used by default
+    if (const auto* eventSink = findSetting("eventSink"))
+        descriptor.eventSink = *eventSink;
+    if (const auto* secondaryEventSinks = findSetting("secondaryEventSinks"))
+        descriptor.secondaryEventSinks = secondaryEventSinks->get<std::vector<std::string>>();
+    if (const auto* secondaryEventSinkBufferSize = findSetting("secondaryEventSinkBufferSize"))
+        descriptor.secondaryEventSinkBufferSize = *secondaryEventSinkBufferSize;
+    if (const auto* traceFilePath = findSetting("traceFilePath"); traceFilePath != nullptr && !traceFilePath->is_null())
+        descriptor.traceFilePath = traceFilePath->get<std::string>() + pidSuffix;
+    if (const auto* traceFileSegmentSize = findSetting("traceFileSegmentSize"))
+        descriptor.traceFileSegmentSize = *traceFileSegmentSize;
+    if (const auto* traceFileMaxSize = findSetting("traceFileMaxSize"))
+        descriptor.traceFileMaxSize = *traceFileMaxSize;
+    if (const auto* socketEndpoint = findSetting("socketEndpoint"); socketEndpoint != nullptr && !socketEndpoint->is_null())
+        descriptor.socketEndpoint = socketEndpoint->get<std::string>();
+    if (const auto* trackedObjectCacheSize = findSetting("trackedObjectCacheSize"))
+        descriptor.trackedObjectCacheSize = *trackedObjectCacheSize;
+    if (const auto* deferGcBookkeeping = findSetting("deferGcBookkeeping"))
+        descriptor.deferGcBookkeeping = *deferGcBookkeeping;
+    if (const auto* stackTraceCaptureMode = findSetting("stackTraceCaptureMode"))
+        descriptor.stackTraceCaptureMode = *stackTraceCaptureMode;
+    if (const auto* stackSamplingPeriod = findSetting("stackSamplingPeriod"))
+        descriptor.stackSamplingPeriod = *stackSamplingPeriod;
+    if (const auto* stackSamplingReportPeriod = findSetting("stackSamplingReportPeriod"))
+        descriptor.stackSamplingReportPeriod = *stackSamplingReportPeriod;
+
     descriptor.methodDescriptors = additionalData.at("methodDescriptors").get<std::vector<MethodDescriptor>>();
     if (additionalData.contains("fieldAccessIntrinsicDescriptors"))
         descriptor.fieldAccessIntrinsicDescriptors = additionalData.at("fieldAccessIntrinsicDescriptors").get<std::vector<FieldAccessIntrinsicDescriptor>>();
@@ -92,4 +145,6 @@ void Profiler::from_json(const nlohmann::json& json, Configuration& descriptor)
         descriptor.stackTraceCollectionMaxDepth = additionalData.at("stackTraceCollectionMaxDepth");
     if (additionalData.contains("stackTraceCollectionForFields"))
         descriptor.stackTraceCollectionForFields = additionalData.at("stackTraceCollectionForFields").get<std::vector<std::string>>();
+    if (additionalData.contains("enableRuntimeReconfiguration"))
+        descriptor.enableRuntimeReconfiguration = additionalData.at("enableRuntimeReconfiguration");
 }
@@ -34,6 +34,26 @@ namespace Profiler
         std::optional<std::string> registrationQueueFile;
         UINT registrationQueueSize;
 
+        std::string eventSink {"ipq"};
+        std::vector<std::string> secondaryEventSinks;
+        UINT64 secondaryEventSinkBufferSize {64 * 1024 * 1024};
+        std::optional<std::string> traceFilePath;
+        UINT64 traceFileSegmentSize {64 * 1024 * 1024};
+        UINT64 traceFileMaxSize {1024 * 1024 * 1024};
+        std::optional<std::string> socketEndpoint;
+        // Entries of the per-thread tracked objects lookup cache, 0 disables it
+        UINT trackedObjectCacheSize {1024};
+        // Rebuild the tracked heap on a background thread instead of during the GC pause
+        // Off by default, lookups (including those of the ELT hooks) block until the deferred rebuild finishes
+        BOOL deferGcBookkeeping {FALSE};
+        // How stacks are captured on method enter: "snapshot" walks the stack of the thread,
+        // "shadowStack" copies the hooked frames tracked by the enter/leave callbacks
+        std::string stackTraceCaptureMode {"snapshot"};
+        // Period of the in-process stack sampler in milliseconds, 0 disables it
+        UINT stackSamplingPeriod {0};
+        // How often the sampled stacks are reported (as counts per stack) in milliseconds
+        UINT stackSamplingReportPeriod {10000};
+
         std::vector<MethodDescriptor> methodDescriptors;
         std::vector<FieldAccessIntrinsicDescriptor> fieldAccessIntrinsicDescriptors;
         std::vector<TypeInjectionDescriptor> typeInjectionDescriptors;
@@ -42,6 +62,7 @@ namespace Profiler
         BOOL enableStackTraceCollection {FALSE};
         UINT stackTraceCollectionMaxDepth {8};
         std::vector<std::string> stackTraceCollectionForFields;
+        BOOL enableRuntimeReconfiguration {FALSE};
     };
 
 	void to_json(nlohmann::json& json, const Configuration& descriptor);
@@ -70,6 +70,13 @@ HRESULT ILRewriter::Import()
     IfFailRet(m_pICorProfilerInfo->GetILFunctionBody(
         m_moduleId, m_tkMethod, &pMethodBytes, NULL));
 
+    return Import(pMethodBytes);
+}
+
+HRESULT ILRewriter::Import(LPCBYTE pMethodBytes)
+{
+    HRESULT hr = S_OK;
+
     COR_ILMETHOD_DECODER decoder((COR_ILMETHOD*)pMethodBytes);
 
     // Import the header flags
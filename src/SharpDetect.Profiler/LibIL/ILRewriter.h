@@ -275,6 +275,8 @@ public:
     //
     ////////////////////////////////////////////////////////////////////////////////////////////////
     HRESULT Import();
+    // Imports the given method (header, IL and EH sections) instead of the current method body
+    HRESULT Import(LPCBYTE pMethodBytes);
     HRESULT ImportIL(LPCBYTE pIL);
     HRESULT ImportEH(const COR_ILMETHOD_SECT_EH* pILEH, unsigned nEH);
     HRESULT ComputeStackTypes();
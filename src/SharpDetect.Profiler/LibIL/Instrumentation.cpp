@@ -112,7 +112,9 @@ HRESULT LibProfiler::PatchMethodBody(
 	IN const BOOL enableFieldsAccessInstrumentation,
 	IN const std::vector<std::string>& skipInstrumentationForAssemblies,
 	IN const BOOL enableStackTraceCollection,
-	IN const std::vector<std::string>& stackTraceFieldPatterns)
+	IN const std::vector<std::string>& stackTraceFieldPatterns,
+	IN ICorProfilerFunctionControl* functionControl,
+	IN LPCBYTE originalMethodBody)
 {
 	if (tokensToPatch.empty() && (!enableFieldsAccessInstrumentation || injectedMethods.empty()))
 		return E_FAIL;
@@ -126,9 +128,9 @@ HRESULT LibProfiler::PatchMethodBody(
 	auto addedLocals = std::vector<std::pair<PCCOR_SIGNATURE, ULONG>>{};
 	auto ownedSignatures = std::deque<std::vector<BYTE>>{};
 
-	// Obtain current method
-	ILRewriter rewriter(&corProfilerInfo, nullptr, moduleDef.GetModuleId(), mdMethodDef);
-	HRESULT hr = rewriter.Import();
+	// Obtain current method (ReJIT must start from the original body, the current one may be already instrumented)
+	ILRewriter rewriter(&corProfilerInfo, functionControl, moduleDef.GetModuleId(), mdMethodDef);
+	HRESULT hr = originalMethodBody != nullptr ? rewriter.Import(originalMethodBody) : rewriter.Import();
 	if (FAILED(hr))
 	{
         if (hr != CORPROF_E_FUNCTION_NOT_IL)
@@ -34,7 +34,9 @@ namespace LibProfiler
 		IN BOOL enableFieldsAccessInstrumentation,
 		IN const std::vector<std::string>& skipInstrumentationForAssemblies,
 		IN BOOL enableStackTraceCollection,
-		IN const std::vector<std::string>& stackTraceFieldPatterns);
+		IN const std::vector<std::string>& stackTraceFieldPatterns,
+		IN ICorProfilerFunctionControl* functionControl = nullptr,
+		IN LPCBYTE originalMethodBody = nullptr);
 
 	HRESULT CreateManagedWrapperMethod(
 		IN ICorProfilerInfo& corProfilerInfo,
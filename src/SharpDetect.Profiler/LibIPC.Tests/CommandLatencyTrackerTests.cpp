@@ -0,0 +1,101 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+
+#include "doctest.h"
+
+#include "CommandLatencyTracker.h"
+
+using LibIPC::CommandLatencyTracker;
+using namespace std::chrono_literals;
+
+TEST_CASE("CommandLatencyTracker: Empty tracker reports no commands")
+{
+	CommandLatencyTracker tracker;
+
+	const auto summary = tracker.GetSummary();
+
+	CHECK(summary.completed == 0);
+	CHECK(summary.pending == 0);
+}
+
+TEST_CASE("CommandLatencyTracker: Measures latency between reception and response")
+{
+	CommandLatencyTracker tracker;
+	const auto start = CommandLatencyTracker::Clock::now();
+
+	tracker.OnCommandReceived(1, start);
+	tracker.OnCommandReceived(2, start);
+	tracker.OnResponseEnqueued(1, start + 100us);
+	tracker.OnResponseEnqueued(2, start + 300us);
+	const auto summary = tracker.GetSummary();
+
+	CHECK(summary.completed == 2);
+	CHECK(summary.pending == 0);
+	CHECK(summary.min == 100us);
+	CHECK(summary.max == 300us);
+	CHECK(summary.mean == 200us);
+}
+
+TEST_CASE("CommandLatencyTracker: Unanswered commands remain pending")
+{
+	CommandLatencyTracker tracker;
+	const auto start = CommandLatencyTracker::Clock::now();
+
+	tracker.OnCommandReceived(1, start);
+	tracker.OnCommandReceived(2, start);
+	tracker.OnResponseEnqueued(2, start + 10us);
+	const auto summary = tracker.GetSummary();
+
+	CHECK(summary.completed == 1);
+	CHECK(summary.pending == 1);
+}
+
+TEST_CASE("CommandLatencyTracker: Dropped commands are no longer pending")
+{
+	CommandLatencyTracker tracker;
+	const auto start = CommandLatencyTracker::Clock::now();
+
+	tracker.OnCommandReceived(1, start);
+	tracker.OnCommandReceived(2, start);
+	tracker.OnCommandDropped(1);
+	tracker.OnResponseEnqueued(1, start + 10us);
+	const auto summary = tracker.GetSummary();
+
+	CHECK(summary.completed == 0);
+	CHECK(summary.pending == 1);
+}
+
+TEST_CASE("CommandLatencyTracker: Responses to unknown commands are ignored")
+{
+	CommandLatencyTracker tracker;
+
+	tracker.OnResponseEnqueued(42);
+	const auto summary = tracker.GetSummary();
+
+	CHECK(summary.completed == 0);
+	CHECK(summary.pending == 0);
+}
+
+TEST_CASE("CommandLatencyTracker: Percentiles are bounded by histogram buckets")
+{
+	CommandLatencyTracker tracker;
+	const auto start = CommandLatencyTracker::Clock::now();
+
+	// 99 fast commands and a single slow outlier
+	for (UINT64 commandId = 0; commandId < 99; ++commandId)
+	{
+		tracker.OnCommandReceived(commandId, start);
+		tracker.OnResponseEnqueued(commandId, start + 5us);
+	}
+	tracker.OnCommandReceived(99, start);
+	tracker.OnResponseEnqueued(99, start + 10ms);
+	const auto summary = tracker.GetSummary();
+
+	CHECK(summary.completed == 100);
+	CHECK(summary.p50 >= 5us);
+	CHECK(summary.p50 <= 8us);
+	CHECK(summary.p99 <= 8us);
+	CHECK(summary.max == 10ms);
+}
@@ -0,0 +1,129 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+
+#include "CommandWorkerPool.h"
+
+using LibIPC::CommandWorkerPool;
+using namespace std::chrono_literals;
+
+namespace
+{
+	constexpr INT32 SlowCommand = 1;
+	constexpr INT32 FastCommand = 2;
+
+	bool WaitUntil(const std::atomic<INT>& value, const INT expected)
+	{
+		const auto deadline = std::chrono::steady_clock::now() + 5s;
+		while (value.load() < expected)
+		{
+			if (std::chrono::steady_clock::now() > deadline)
+				return false;
+			std::this_thread::sleep_for(1ms);
+		}
+		return true;
+	}
+}
+
+TEST_CASE("CommandWorkerPool: Executes submitted commands")
+{
+	CommandWorkerPool pool(2);
+	std::atomic<INT> executed = 0;
+
+	for (auto i = 0; i < 10; ++i)
+		pool.Submit(FastCommand, [&]() { ++executed; });
+
+	CHECK(WaitUntil(executed, 10));
+}
+
+TEST_CASE("CommandWorkerPool: Long command does not block other command types")
+{
+	CommandWorkerPool pool(2);
+	pool.SetConcurrencyLimit(SlowCommand, 1);
+	std::promise<void> release;
+	auto released = release.get_future().share();
+	std::atomic<INT> fastExecuted = 0;
+
+	pool.Submit(SlowCommand, [released]() { released.wait(); });
+	pool.Submit(FastCommand, [&]() { ++fastExecuted; });
+
+	CHECK(WaitUntil(fastExecuted, 1));
+	release.set_value();
+}
+
+TEST_CASE("CommandWorkerPool: Respects per-type concurrency limit")
+{
+	CommandWorkerPool pool(4);
+	pool.SetConcurrencyLimit(SlowCommand, 1);
+	std::atomic<INT> running = 0;
+	std::atomic<INT> maxRunning = 0;
+	std::atomic<INT> executed = 0;
+
+	for (auto i = 0; i < 8; ++i)
+	{
+		pool.Submit(SlowCommand, [&]()
+		{
+			const auto current = ++running;
+			auto observed = maxRunning.load();
+			while (observed < current && !maxRunning.compare_exchange_weak(observed, current)) { }
+			std::this_thread::sleep_for(2ms);
+			--running;
+			++executed;
+		});
+	}
+
+	CHECK(WaitUntil(executed, 8));
+	CHECK(maxRunning.load() == 1);
+}
+
+TEST_CASE("CommandWorkerPool: Commands of the same type start in submission order")
+{
+	CommandWorkerPool pool(3);
+	pool.SetConcurrencyLimit(SlowCommand, 1);
+	std::mutex mutex;
+	std::vector<INT> order;
+	std::atomic<INT> executed = 0;
+
+	for (auto i = 0; i < 16; ++i)
+	{
+		pool.Submit(SlowCommand, [&, i]()
+		{
+			std::lock_guard guard(mutex);
+			order.push_back(i);
+			++executed;
+		});
+	}
+
+	REQUIRE(WaitUntil(executed, 16));
+	CHECK(std::is_sorted(order.cbegin(), order.cend()));
+}
+
+TEST_CASE("CommandWorkerPool: Stop waits for running commands and drops queued ones")
+{
+	CommandWorkerPool pool(1);
+	std::promise<void> started;
+	std::atomic<INT> executed = 0;
+
+	pool.Submit(SlowCommand, [&]()
+	{
+		started.set_value();
+		std::this_thread::sleep_for(20ms);
+		++executed;
+	});
+	pool.Submit(SlowCommand, [&]() { ++executed; });
+	started.get_future().wait();
+	pool.Stop();
+	const auto submittedAfterStop = pool.Submit(SlowCommand, [&]() { ++executed; });
+
+	CHECK_FALSE(submittedAfterStop);
+	CHECK(executed.load() == 1);
+}
@@ -1,6 +1,8 @@
 // Copyright 2026 Andrej Čižmárik and Contributors
 // SPDX-License-Identifier: Apache-2.0
 
+#include <atomic>
+#include <chrono>
 #include <cstring>
 #include <mutex>
 #include <thread>
@@ -150,6 +152,60 @@ TEST_CASE("EventDispatcher leaves no record unflushed in the sink")
 	CHECK(sink.UnflushedRecords() == 0);
 }
 
+TEST_CASE("EventDispatcher flushes all events preceding a drain barrier")
+{
+	constexpr std::int32_t count = 500;
+	RecordingSink sink;
+	EventDispatcher dispatcher(sink, 8 * 1024 * 1024);
+	dispatcher.Start();
+
+	for (std::int32_t i = 0; i < count; ++i)
+	{
+		const auto payload = MakePayload(0, i);
+		dispatcher.Enqueue(payload.data(), payload.size());
+	}
+
+	const auto barrier = dispatcher.GetSequence();
+	CHECK(barrier == static_cast<std::uint64_t>(count));
+
+	// Events enqueued after the barrier must not delay it
+	std::atomic_bool producing = true;
+	std::thread producer([&dispatcher, &producing]
+	{
+		for (std::int32_t i = 0; producing; ++i)
+		{
+			const auto payload = MakePayload(1, i);
+			dispatcher.Enqueue(payload.data(), payload.size());
+		}
+	});
+
+	REQUIRE(dispatcher.WaitForFlush(barrier, std::chrono::seconds(10)));
+	const auto records = sink.Records();
+	producing = false;
+	producer.join();
+
+	REQUIRE(records.size() >= static_cast<std::size_t>(count));
+	for (std::int32_t i = 0; i < count; ++i)
+	{
+		CHECK(FieldA(records[i]) == 0);
+		CHECK(FieldB(records[i]) == i);
+	}
+
+	dispatcher.Stop();
+}
+
+TEST_CASE("EventDispatcher releases drain barrier waiters once stopped")
+{
+	RecordingSink sink;
+	EventDispatcher dispatcher(sink, 8 * 1024 * 1024);
+	dispatcher.Start();
+	CHECK(dispatcher.WaitForFlush(0, std::chrono::seconds(10)));
+	dispatcher.Stop();
+
+	// Nothing will ever be enqueued with this sequence
+	CHECK_FALSE(dispatcher.WaitForFlush(1, std::chrono::seconds(10)));
+}
+
 TEST_CASE("EventDispatcher loses nothing and preserves per-thread order under contention")
 {
 	constexpr std::int32_t threadCount = 4;
@@ -0,0 +1,234 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "doctest.h"
+
+#include "SocketChannel.h"
+#include "SocketEventSink.h"
+#include "SocketStreamFormat.h"
+
+using LibIPC::SocketChannel;
+using LibIPC::SocketEventSink;
+namespace SocketStreamFormat = LibIPC::SocketStreamFormat;
+
+namespace
+{
+	struct ReceivedStream
+	{
+		bool headerValid = false;
+		std::vector<std::int32_t> values;
+		UINT64 frames = 0;
+		UINT64 bytes = 0;
+	};
+
+	// Stand-in for a remote analyzer: accepts a single connection and decodes frames until the peer disconnects
+	void Receive(const SocketChannel& listener, ReceivedStream& stream, const UINT64 maxFrames = UINT64_MAX)
+	{
+		const auto connection = listener.Accept();
+		REQUIRE(connection.IsValid());
+
+		SocketStreamFormat::StreamHeader header { };
+		REQUIRE(connection.ReceiveAll(reinterpret_cast<char*>(&header), sizeof(header)));
+		stream.headerValid = header.magic == SocketStreamFormat::StreamMagic && header.version == SocketStreamFormat::Version;
+
+		std::vector<char> batch;
+		SocketStreamFormat::FrameHeader frame { };
+		while (stream.frames < maxFrames && connection.ReceiveAll(reinterpret_cast<char*>(&frame), sizeof(frame)))
+		{
+			batch.resize(frame.size);
+			REQUIRE(connection.ReceiveAll(batch.data(), batch.size()));
+			REQUIRE(frame.firstSequence == stream.values.size());
+
+			std::size_t offset = 0;
+			for (UINT32 i = 0; i < frame.recordCount; ++i)
+			{
+				std::int32_t size = 0;
+				std::int32_t value = 0;
+				std::memcpy(&size, batch.data() + offset, sizeof(size));
+				std::memcpy(&value, batch.data() + offset + sizeof(size), sizeof(value));
+				stream.values.push_back(value);
+				offset += sizeof(size) + static_cast<std::size_t>(size);
+			}
+			CHECK(offset == batch.size());
+			stream.bytes += sizeof(frame) + frame.size;
+			++stream.frames;
+		}
+	}
+
+	void StreamRecords(const std::string& endpoint, const std::int32_t count, const std::size_t recordSize)
+	{
+		SocketEventSink sink(endpoint);
+		std::vector<char> record(recordSize, '.');
+		for (std::int32_t i = 0; i < count; ++i)
+		{
+			std::memcpy(record.data(), &i, sizeof(i));
+			sink.Send(record);
+			if (i % 1000 == 999)
+				sink.Flush();
+		}
+		sink.Flush();
+		CHECK(sink.GetDroppedRecordsCount() == 0);
+	}
+}
+
+TEST_CASE("SocketEventSink streams every record over TCP loopback")
+{
+	constexpr std::int32_t count = 200000;
+	constexpr std::size_t recordSize = 64;
+	const auto listener = SocketChannel::Listen("tcp://127.0.0.1:0");
+	REQUIRE(listener.IsValid());
+	const auto port = listener.GetLocalPort();
+	REQUIRE(port > 0);
+
+	ReceivedStream stream;
+	std::thread receiver([&listener, &stream]() { Receive(listener, stream); });
+	const auto start = std::chrono::steady_clock::now();
+	StreamRecords("tcp://127.0.0.1:" + std::to_string(port), count, recordSize);
+	receiver.join();
+	const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	CHECK(stream.headerValid);
+	REQUIRE(stream.values.size() == count);
+	for (std::int32_t i = 0; i < count; ++i)
+		CHECK(stream.values[i] == i);
+	CHECK(stream.bytes > count * recordSize);
+	CHECK(elapsed > 0);
+}
+
+#ifndef _WIN32
+TEST_CASE("SocketEventSink streams every record over a Unix-domain socket")
+{
+	constexpr std::int32_t count = 50000;
+	const auto path = (std::filesystem::temp_directory_path() / "SharpDetect.SocketEventSinkTests.sock").string();
+	const auto listener = SocketChannel::Listen("unix://" + path);
+	REQUIRE(listener.IsValid());
+
+	ReceivedStream stream;
+	std::thread receiver([&listener, &stream]() { Receive(listener, stream); });
+	StreamRecords("unix://" + path, count, 128);
+	receiver.join();
+	std::filesystem::remove(path);
+
+	CHECK(stream.headerValid);
+	CHECK(stream.values.size() == count);
+}
+#endif
+
+#ifndef _WIN32
+TEST_CASE("SocketChannel gives up connecting to an unresponsive endpoint")
+{
+	// A listener with a full backlog drops incoming SYNs, a blocking connect would retry them for minutes
+	const auto listener = socket(AF_INET, SOCK_STREAM, 0);
+	REQUIRE(listener >= 0);
+	sockaddr_in address { };
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	socklen_t length = sizeof(address);
+	REQUIRE(bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0);
+	REQUIRE(listen(listener, 0) == 0);
+	REQUIRE(getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) == 0);
+	const auto endpoint = "tcp://127.0.0.1:" + std::to_string(ntohs(address.sin_port));
+
+	constexpr UINT timeoutMilliseconds = 200;
+	const auto queued = SocketChannel::Connect(endpoint, timeoutMilliseconds);
+	const auto start = std::chrono::steady_clock::now();
+	const auto channel = SocketChannel::Connect(endpoint, timeoutMilliseconds);
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	close(listener);
+
+	CHECK(queued.IsValid());
+	CHECK_FALSE(channel.IsValid());
+	CHECK(elapsed >= std::chrono::milliseconds(timeoutMilliseconds / 2));
+	CHECK(elapsed < std::chrono::seconds(3));
+}
+#endif
+
+TEST_CASE("SocketEventSink drops batches while the receiver is unavailable")
+{
+	auto listener = SocketChannel::Listen("tcp://127.0.0.1:0");
+	REQUIRE(listener.IsValid());
+	const auto endpoint = "tcp://127.0.0.1:" + std::to_string(listener.GetLocalPort());
+
+	ReceivedStream stream;
+	std::thread receiver([&listener, &stream]() { Receive(listener, stream, 1); });
+	SocketEventSink sink(endpoint);
+	std::vector<char> record(16, '.');
+	sink.Send(record);
+	sink.Flush();
+	receiver.join();
+	listener.Close();
+	const auto connectedDiscontinuities = sink.GetDiscontinuitiesCount();
+
+	// The accepted connection was closed by the receiver, eventually sends start failing
+	for (auto i = 0; i < 100 && sink.GetDroppedRecordsCount() == 0; ++i)
+	{
+		sink.Send(record);
+		sink.Flush();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	CHECK(stream.values.size() == 1);
+	CHECK(sink.GetDroppedRecordsCount() > 0);
+	CHECK(sink.GetDiscontinuitiesCount() > connectedDiscontinuities);
+}
+
+TEST_CASE("SocketEventSink drops records until the receiver is reachable")
+{
+	auto listener = SocketChannel::Listen("tcp://127.0.0.1:0");
+	REQUIRE(listener.IsValid());
+	const auto port = listener.GetLocalPort();
+	listener.Close();
+
+	SocketEventSink sink("tcp://127.0.0.1:" + std::to_string(port));
+	std::vector<char> record(16, '.');
+	sink.Send(record);
+	sink.Flush();
+
+	CHECK(sink.GetDroppedRecordsCount() == 1);
+	CHECK(sink.GetDiscontinuitiesCount() > 0);
+}
+
+TEST_CASE("SocketEventSink connects to a receiver that starts later")
+{
+	auto unavailable = SocketChannel::Listen("tcp://127.0.0.1:0");
+	REQUIRE(unavailable.IsValid());
+	const auto endpoint = "tcp://127.0.0.1:" + std::to_string(unavailable.GetLocalPort());
+	unavailable.Close();
+
+	auto sink = std::make_unique<SocketEventSink>(endpoint);
+	const auto listener = SocketChannel::Listen(endpoint);
+	REQUIRE(listener.IsValid());
+	ReceivedStream stream;
+	std::thread receiver([&listener, &stream]() { Receive(listener, stream); });
+
+	// Connecting is retried once the reconnect interval elapses
+	std::this_thread::sleep_for(SocketEventSink::ReconnectInterval);
+	std::vector<char> record(16, '.');
+	for (std::int32_t i = 0; i < 10; ++i)
+	{
+		std::memcpy(record.data(), &i, sizeof(i));
+		sink->Send(record);
+	}
+	sink->Flush();
+	CHECK(sink->GetDroppedRecordsCount() == 0);
+
+	// The receiver stops once the sink disconnects
+	sink.reset();
+	receiver.join();
+	CHECK(stream.headerValid);
+	CHECK(stream.values.size() == 10);
+}
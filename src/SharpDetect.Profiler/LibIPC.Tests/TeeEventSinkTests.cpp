@@ -0,0 +1,141 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+
+#include "BufferedEventSink.h"
+#include "EventSink.h"
+#include "TeeEventSink.h"
+
+using LibIPC::BufferedEventSink;
+using LibIPC::TeeEventSink;
+
+namespace
+{
+	class CollectingSink : public LibIPC::IEventSink
+	{
+	public:
+		explicit CollectingSink(std::vector<std::int32_t>& values, std::chrono::milliseconds delay = { }) :
+			_values(values),
+			_delay(delay)
+		{
+		}
+
+		void Send(std::vector<char>& buffer) override
+		{
+			if (_delay.count() > 0)
+				std::this_thread::sleep_for(_delay);
+
+			std::int32_t value = 0;
+			std::memcpy(&value, buffer.data(), sizeof(value));
+			std::lock_guard guard(_mutex);
+			_values.push_back(value);
+		}
+
+		void Flush() override
+		{
+		}
+
+	private:
+		std::mutex _mutex;
+		std::vector<std::int32_t>& _values;
+		std::chrono::milliseconds _delay;
+	};
+
+	std::vector<char> MakeRecord(const std::int32_t value)
+	{
+		std::vector<char> record(64, '.');
+		std::memcpy(record.data(), &value, sizeof(value));
+		return record;
+	}
+}
+
+TEST_CASE("TeeEventSink forwards every record to all sinks in order")
+{
+	constexpr std::int32_t count = 10000;
+	std::vector<std::int32_t> primaryValues;
+	std::vector<std::int32_t> firstSecondaryValues;
+	std::vector<std::int32_t> secondSecondaryValues;
+	{
+		std::vector<std::unique_ptr<LibIPC::IEventSink>> secondaries;
+		secondaries.push_back(std::make_unique<CollectingSink>(firstSecondaryValues));
+		secondaries.push_back(std::make_unique<CollectingSink>(secondSecondaryValues));
+		TeeEventSink sink(std::make_unique<CollectingSink>(primaryValues), std::move(secondaries), 64 * 1024 * 1024);
+		for (std::int32_t i = 0; i < count; ++i)
+		{
+			auto record = MakeRecord(i);
+			sink.Send(record);
+			if (i % 100 == 99)
+				sink.Flush();
+		}
+	}
+
+	for (const auto* values : { &primaryValues, &firstSecondaryValues, &secondSecondaryValues })
+	{
+		REQUIRE(values->size() == count);
+		for (std::int32_t i = 0; i < count; ++i)
+			CHECK((*values)[i] == i);
+	}
+}
+
+TEST_CASE("TeeEventSink does not stall the primary sink behind a slow secondary")
+{
+	constexpr std::int32_t count = 2000;
+	std::vector<std::int32_t> primaryValues;
+	std::vector<std::int32_t> secondaryValues;
+	{
+		std::vector<std::unique_ptr<LibIPC::IEventSink>> secondaries;
+		secondaries.push_back(std::make_unique<CollectingSink>(secondaryValues, std::chrono::milliseconds(1)));
+		TeeEventSink sink(std::make_unique<CollectingSink>(primaryValues), std::move(secondaries), 4 * 1024);
+
+		const auto start = std::chrono::steady_clock::now();
+		for (std::int32_t i = 0; i < count; ++i)
+		{
+			auto record = MakeRecord(i);
+			sink.Send(record);
+			if (i % 10 == 9)
+				sink.Flush();
+		}
+		// Forwarding synchronously would take at least count milliseconds
+		CHECK(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(count / 2));
+		// Drops of the secondary are visible through the tee
+		CHECK(sink.GetDiscontinuitiesCount() > 0);
+	}
+
+	CHECK(primaryValues.size() == count);
+	CHECK(secondaryValues.size() < count);
+}
+
+TEST_CASE("BufferedEventSink drops whole batches once its buffer is full")
+{
+	constexpr std::int32_t count = 2000;
+	std::vector<std::int32_t> values;
+	UINT64 dropped = 0;
+	UINT64 discontinuities = 0;
+	{
+		BufferedEventSink sink(std::make_unique<CollectingSink>(values, std::chrono::milliseconds(1)), 4 * 1024);
+		for (std::int32_t i = 0; i < count; ++i)
+		{
+			auto record = MakeRecord(i);
+			sink.Send(record);
+			if (i % 10 == 9)
+				sink.Flush();
+		}
+		dropped = sink.GetDroppedRecordsCount();
+		discontinuities = sink.GetDiscontinuitiesCount();
+	}
+
+	CHECK(dropped > 0);
+	CHECK(discontinuities > 0);
+	CHECK(values.size() + dropped == count);
+	for (std::size_t i = 1; i < values.size(); ++i)
+		CHECK(values[i] > values[i - 1]);
+}
@@ -0,0 +1,93 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "doctest.h"
+
+#include "TraceFileFormat.h"
+#include "TraceFileReader.h"
+#include "TraceFileSink.h"
+
+using LibIPC::TraceBatch;
+using LibIPC::TraceFileReader;
+using LibIPC::TraceFileSink;
+
+namespace
+{
+	std::string PrepareBasePath(const std::string& name)
+	{
+		const auto directory = std::filesystem::temp_directory_path() / name;
+		std::filesystem::remove_all(directory);
+		std::filesystem::create_directories(directory);
+		return (directory / "trace").string();
+	}
+
+	void RecordTrace(const std::string& basePath, const std::int32_t count, const std::size_t recordSize)
+	{
+		TraceFileSink sink(basePath, 1, 0);
+		for (std::int32_t i = 0; i < count; ++i)
+		{
+			std::vector<char> record(recordSize, '.');
+			std::memcpy(record.data(), &i, sizeof(i));
+			sink.Send(record);
+		}
+	}
+
+	std::vector<std::int32_t> ReadAllRecords(TraceFileReader& reader)
+	{
+		std::vector<std::int32_t> values;
+		TraceBatch batch { };
+		while (reader.ReadNextBatch(batch))
+		{
+			REQUIRE(batch.firstSequence == values.size());
+			std::size_t offset = 0;
+			const char* record = nullptr;
+			std::size_t size = 0;
+			UINT32 recordCount = 0;
+			while (TraceFileReader::TryReadRecord(batch, offset, record, size))
+			{
+				std::int32_t value = 0;
+				std::memcpy(&value, record, sizeof(value));
+				values.push_back(value);
+				++recordCount;
+			}
+			CHECK(offset == batch.size);
+			CHECK(recordCount == batch.recordCount);
+		}
+		return values;
+	}
+}
+
+TEST_CASE("TraceFileReader reads back every record written by TraceFileSink")
+{
+	constexpr std::int32_t count = 3000;
+	const auto basePath = PrepareBasePath("SharpDetect.TraceFileReaderTests.RoundTrip");
+	RecordTrace(basePath, count, 512);
+
+	TraceFileReader reader(basePath);
+	CHECK(reader.GetSegments().size() > 1);
+	const auto values = ReadAllRecords(reader);
+	REQUIRE(values.size() == count);
+	for (std::int32_t i = 0; i < count; ++i)
+		CHECK(values[i] == i);
+
+	reader.Rewind();
+	CHECK(ReadAllRecords(reader).size() == count);
+	std::filesystem::remove_all(std::filesystem::path(basePath).parent_path());
+}
+
+TEST_CASE("TraceFileReader discovers segments missing from the index")
+{
+	constexpr std::int32_t count = 1000;
+	const auto basePath = PrepareBasePath("SharpDetect.TraceFileReaderTests.Unindexed");
+	RecordTrace(basePath, count, 512);
+	std::filesystem::remove(LibIPC::TraceFileFormat::GetIndexPath(basePath));
+
+	TraceFileReader reader(basePath);
+	CHECK(ReadAllRecords(reader).size() == count);
+	std::filesystem::remove_all(std::filesystem::path(basePath).parent_path());
+}
@@ -0,0 +1,220 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "doctest.h"
+
+#include "TraceFileFormat.h"
+#include "TraceFileSink.h"
+
+using LibIPC::TraceFileSink;
+namespace TraceFileFormat = LibIPC::TraceFileFormat;
+
+namespace
+{
+	class TemporaryDirectory
+	{
+	public:
+		explicit TemporaryDirectory(const std::string& name) :
+			_path(std::filesystem::temp_directory_path() / name)
+		{
+			std::filesystem::remove_all(_path);
+			std::filesystem::create_directories(_path);
+		}
+
+		~TemporaryDirectory()
+		{
+			std::error_code error;
+			std::filesystem::remove_all(_path, error);
+		}
+
+		[[nodiscard]] std::string BasePath() const { return (_path / "trace").string(); }
+
+	private:
+		std::filesystem::path _path;
+	};
+
+	std::vector<char> ReadAll(const std::string& path)
+	{
+		std::ifstream stream(path, std::ios::binary);
+		return { std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+	}
+
+	std::vector<char> MakeRecord(const std::int32_t value, const std::size_t totalSize = 16)
+	{
+		std::vector<char> record(totalSize, '.');
+		std::memcpy(record.data(), &value, sizeof(value));
+		return record;
+	}
+
+	// Returns the first field of every record stored in the segment
+	std::vector<std::int32_t> ReadSegmentRecords(const std::string& path, TraceFileFormat::SegmentHeader& header)
+	{
+		const auto content = ReadAll(path);
+		REQUIRE(content.size() >= sizeof(header));
+		std::memcpy(&header, content.data(), sizeof(header));
+		REQUIRE(header.magic == TraceFileFormat::SegmentMagic);
+
+		std::vector<std::int32_t> values;
+		auto offset = sizeof(header);
+		const auto end = sizeof(header) + header.dataSize;
+		while (offset < end)
+		{
+			TraceFileFormat::BatchHeader batch { };
+			std::memcpy(&batch, content.data() + offset, sizeof(batch));
+			offset += sizeof(batch);
+			REQUIRE(batch.firstSequence == header.firstSequence + values.size());
+
+			const auto batchEnd = offset + batch.size;
+			for (UINT32 i = 0; i < batch.recordCount; ++i)
+			{
+				std::int32_t size = 0;
+				std::memcpy(&size, content.data() + offset, sizeof(size));
+				std::int32_t value = 0;
+				std::memcpy(&value, content.data() + offset + sizeof(size), sizeof(value));
+				values.push_back(value);
+				offset += sizeof(size) + static_cast<std::size_t>(size);
+			}
+			REQUIRE(offset == batchEnd);
+		}
+		return values;
+	}
+
+	std::vector<TraceFileFormat::IndexEntry> ReadIndex(const std::string& basePath)
+	{
+		const auto content = ReadAll(TraceFileFormat::GetIndexPath(basePath));
+		REQUIRE(content.size() >= sizeof(TraceFileFormat::IndexHeader));
+		TraceFileFormat::IndexHeader header { };
+		std::memcpy(&header, content.data(), sizeof(header));
+		REQUIRE(header.magic == TraceFileFormat::IndexMagic);
+		REQUIRE(content.size() == sizeof(header) + header.entryCount * sizeof(TraceFileFormat::IndexEntry));
+
+		std::vector<TraceFileFormat::IndexEntry> entries(header.entryCount);
+		std::memcpy(entries.data(), content.data() + sizeof(header), entries.size() * sizeof(TraceFileFormat::IndexEntry));
+		return entries;
+	}
+}
+
+TEST_CASE("TraceFileSink stores records in order within a single segment")
+{
+	TemporaryDirectory directory("SharpDetect.TraceFileSinkTests.Single");
+	{
+		TraceFileSink sink(directory.BasePath(), 1024 * 1024, 0);
+		for (std::int32_t i = 0; i < 100; ++i)
+		{
+			auto record = MakeRecord(i);
+			sink.Send(record);
+			if (i % 10 == 9)
+				sink.Flush();
+		}
+	}
+
+	const auto entries = ReadIndex(directory.BasePath());
+	REQUIRE(entries.size() == 1);
+	CHECK(entries[0].firstSequence == 0);
+	CHECK(entries[0].recordCount == 100);
+
+	TraceFileFormat::SegmentHeader header { };
+	const auto segmentPath = TraceFileFormat::GetSegmentPath(directory.BasePath(), 0);
+	const auto values = ReadSegmentRecords(segmentPath, header);
+	REQUIRE(values.size() == 100);
+	for (std::int32_t i = 0; i < 100; ++i)
+		CHECK(values[i] == i);
+	// Sealed segment is trimmed to the bytes actually written
+	CHECK(std::filesystem::file_size(segmentPath) == entries[0].segmentSize);
+}
+
+TEST_CASE("TraceFileSink rotates segments and indexes their sequence ranges")
+{
+	constexpr std::int32_t count = 2000;
+	constexpr std::size_t recordSize = 1024;
+	TemporaryDirectory directory("SharpDetect.TraceFileSinkTests.Rotation");
+	{
+		// Minimal segment size is enforced by the sink, so this rotates roughly every 68 KiB
+		TraceFileSink sink(directory.BasePath(), 1, 0);
+		const auto initialDiscontinuities = sink.GetDiscontinuitiesCount();
+		for (std::int32_t i = 0; i < count; ++i)
+		{
+			auto record = MakeRecord(i, recordSize);
+			sink.Send(record);
+		}
+		CHECK(sink.GetRecordCount() == count);
+		// Every new segment is a point from which the trace may be read
+		CHECK(sink.GetDiscontinuitiesCount() > initialDiscontinuities);
+	}
+
+	const auto entries = ReadIndex(directory.BasePath());
+	REQUIRE(entries.size() > 1);
+
+	UINT64 expectedSequence = 0;
+	for (const auto& entry : entries)
+	{
+		CHECK(entry.firstSequence == expectedSequence);
+		TraceFileFormat::SegmentHeader header { };
+		const auto values = ReadSegmentRecords(TraceFileFormat::GetSegmentPath(directory.BasePath(), entry.segmentIndex), header);
+		REQUIRE(values.size() == entry.recordCount);
+		for (std::size_t i = 0; i < values.size(); ++i)
+			CHECK(values[i] == static_cast<std::int32_t>(expectedSequence + i));
+		expectedSequence += entry.recordCount;
+	}
+	CHECK(expectedSequence == count);
+}
+
+TEST_CASE("TraceFileSink drops oldest segments once the maximum size is reached")
+{
+	constexpr std::int32_t count = 4000;
+	constexpr std::size_t recordSize = 1024;
+	constexpr UINT64 maxSize = 512 * 1024;
+	TemporaryDirectory directory("SharpDetect.TraceFileSinkTests.MaxSize");
+	{
+		TraceFileSink sink(directory.BasePath(), 1, maxSize);
+		for (std::int32_t i = 0; i < count; ++i)
+		{
+			auto record = MakeRecord(i, recordSize);
+			sink.Send(record);
+		}
+	}
+
+	const auto entries = ReadIndex(directory.BasePath());
+	REQUIRE_FALSE(entries.empty());
+	CHECK(entries.front().segmentIndex > 0);
+
+	UINT64 totalSize = 0;
+	for (std::size_t i = 0; i < entries.size(); ++i)
+	{
+		totalSize += entries[i].segmentSize;
+		if (i > 0)
+			CHECK(entries[i].firstSequence == entries[i - 1].firstSequence + entries[i - 1].recordCount);
+	}
+	CHECK(totalSize <= maxSize);
+	CHECK(entries.back().firstSequence + entries.back().recordCount == count);
+	CHECK_FALSE(std::filesystem::exists(TraceFileFormat::GetSegmentPath(directory.BasePath(), 0)));
+}
+
+TEST_CASE("TraceFileSink stores an oversized batch in a segment of its own")
+{
+	TemporaryDirectory directory("SharpDetect.TraceFileSinkTests.Oversized");
+	{
+		TraceFileSink sink(directory.BasePath(), 1, 0);
+		auto small = MakeRecord(0);
+		auto oversized = MakeRecord(1, 512 * 1024);
+		sink.Send(small);
+		sink.Flush();
+		sink.Send(oversized);
+		auto trailing = MakeRecord(2);
+		sink.Send(trailing);
+	}
+
+	const auto entries = ReadIndex(directory.BasePath());
+	REQUIRE(entries.size() == 3);
+	CHECK(entries[0].recordCount == 1);
+	CHECK(entries[1].recordCount == 1);
+	CHECK(entries[1].segmentSize > 512 * 1024);
+	CHECK(entries[2].firstSequence == 2);
+}
@@ -0,0 +1,164 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "doctest.h"
+
+#include "TrackedObjectIdRuns.h"
+
+namespace TrackedObjectIdRuns = LibIPC::TrackedObjectIdRuns;
+
+namespace
+{
+	std::vector<UINT64> RoundTrip(const std::vector<UINT64>& ids, std::vector<BYTE>& payload)
+	{
+		TrackedObjectIdRuns::Encode(ids, payload);
+		std::vector<UINT64> decoded;
+		REQUIRE(TrackedObjectIdRuns::Decode(payload, decoded));
+		return decoded;
+	}
+}
+
+TEST_CASE("TrackedObjectIdRuns: Empty set is encoded as zero count")
+{
+	std::vector<BYTE> payload;
+
+	const auto decoded = RoundTrip({ }, payload);
+
+	const std::vector<BYTE> expected { 0x00 };
+	CHECK(payload == expected);
+	CHECK(decoded.empty());
+}
+
+TEST_CASE("TrackedObjectIdRuns: Consecutive ids are encoded as runs")
+{
+	const std::vector<UINT64> ids { 1, 2, 3, 10, 200 };
+	std::vector<BYTE> payload;
+
+	const auto decoded = RoundTrip(ids, payload);
+
+	// Shared with the managed decoder tests
+	const std::vector<BYTE> expected { 0x05, 0x01, 0x02, 0x06, 0x00, 0xBD, 0x01, 0x00 };
+	CHECK(payload == expected);
+	CHECK(decoded == ids);
+}
+
+TEST_CASE("TrackedObjectIdRuns: Random sets survive a round trip")
+{
+	std::mt19937_64 random(42);
+	for (auto iteration = 0; iteration < 100; iteration++)
+	{
+		std::vector<UINT64> ids;
+		UINT64 id = random() % 1000;
+		const auto count = random() % 5000;
+		for (UINT64 index = 0; index < count; index++)
+		{
+			ids.push_back(id);
+			// Mostly dense with occasional large gaps
+			id += random() % 8 == 0 ? 1 + random() % 100000 : 1;
+		}
+		std::vector<BYTE> payload;
+
+		const auto decoded = RoundTrip(ids, payload);
+
+		REQUIRE(decoded == ids);
+	}
+}
+
+TEST_CASE("TrackedObjectIdRuns: Large ids survive a round trip")
+{
+	const std::vector<UINT64> ids { 0, 0x7FFFFFFFFFFFFFFFull, 0xFFFFFFFFFFFFFFFEull, 0xFFFFFFFFFFFFFFFFull };
+	std::vector<BYTE> payload;
+
+	const auto decoded = RoundTrip(ids, payload);
+
+	CHECK(decoded == ids);
+}
+
+// A msgpack array of the same ids takes 5 bytes per id (uint32 format)
+constexpr std::size_t MeasuredIdsCount = 1'000'000;
+constexpr std::size_t RawPayloadSize = MeasuredIdsCount * 5;
+
+TEST_CASE("TrackedObjectIdRuns: Whole collected generation fits into a few bytes")
+{
+	std::vector<UINT64> ids(MeasuredIdsCount);
+	std::iota(ids.begin(), ids.end(), 1'000'000);
+	std::vector<BYTE> payload;
+
+	const auto decoded = RoundTrip(ids, payload);
+
+	CHECK(decoded == ids);
+	CHECK(payload.size() == 9);
+}
+
+TEST_CASE("TrackedObjectIdRuns: Alternating ids take two bytes per id")
+{
+	std::vector<UINT64> ids(MeasuredIdsCount);
+	for (std::size_t index = 0; index < MeasuredIdsCount; index++)
+		ids[index] = 1'000'000 + 2 * index;
+	std::vector<BYTE> payload;
+
+	const auto decoded = RoundTrip(ids, payload);
+
+	CHECK(decoded == ids);
+	CHECK(payload.size() <= 2 * MeasuredIdsCount + 16);
+}
+
+TEST_CASE("TrackedObjectIdRuns: Randomly collected half of the ids takes under a quarter of the raw size")
+{
+	std::mt19937_64 random(42);
+	std::vector<UINT64> ids;
+	for (UINT64 id = 1'000'000; ids.size() < MeasuredIdsCount; id++)
+	{
+		if (random() % 2 == 0)
+			ids.push_back(id);
+	}
+	std::vector<BYTE> payload;
+
+	const auto decoded = RoundTrip(ids, payload);
+
+	CHECK(decoded == ids);
+	CHECK(payload.size() < RawPayloadSize / 4);
+}
+
+TEST_CASE("TrackedObjectIdRuns: Empty payload is rejected")
+{
+	std::vector<UINT64> decoded;
+
+	CHECK_FALSE(TrackedObjectIdRuns::Decode({ }, decoded));
+}
+
+TEST_CASE("TrackedObjectIdRuns: Truncated varint is rejected")
+{
+	const std::vector<BYTE> payload { 0x02, 0x01, 0x80 };
+	std::vector<UINT64> decoded;
+
+	CHECK_FALSE(TrackedObjectIdRuns::Decode(payload, decoded));
+}
+
+TEST_CASE("TrackedObjectIdRuns: Missing run length is rejected")
+{
+	const std::vector<BYTE> payload { 0x01, 0x01 };
+	std::vector<UINT64> decoded;
+
+	CHECK_FALSE(TrackedObjectIdRuns::Decode(payload, decoded));
+}
+
+TEST_CASE("TrackedObjectIdRuns: Runs exceeding the count are rejected")
+{
+	const std::vector<BYTE> payload { 0x02, 0x01, 0x05 };
+	std::vector<UINT64> decoded;
+
+	CHECK_FALSE(TrackedObjectIdRuns::Decode(payload, decoded));
+}
+
+TEST_CASE("TrackedObjectIdRuns: Runs falling short of the count are rejected")
+{
+	const std::vector<BYTE> payload { 0x03, 0x01, 0x00 };
+	std::vector<UINT64> decoded;
+
+	CHECK_FALSE(TrackedObjectIdRuns::Decode(payload, decoded));
+}
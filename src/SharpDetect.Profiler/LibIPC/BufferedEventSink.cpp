@@ -0,0 +1,124 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstring>
+#include <utility>
+
+#include "../lib/loguru/loguru.hpp"
+
+#include "BufferedEventSink.h"
+
+LibIPC::BufferedEventSink::BufferedEventSink(std::unique_ptr<IEventSink> sink, const std::size_t maxBufferedBytes) :
+	_sink(std::move(sink)),
+	_maxBufferedBytes(maxBufferedBytes),
+	_pending { { }, 0 },
+	_bufferedBytes(0),
+	_droppedRecords(0),
+	_discontinuities(0),
+	_terminating(false)
+{
+	_pending.data.reserve(FlushThresholdBytes);
+	_workerThread = std::thread(&LibIPC::BufferedEventSink::WorkerThreadLoop, this);
+}
+
+LibIPC::BufferedEventSink::~BufferedEventSink()
+{
+	Flush();
+	{
+		std::lock_guard guard(_mutex);
+		_terminating = true;
+	}
+	_batchAvailable.notify_one();
+	_workerThread.join();
+
+	if (_droppedRecords > 0)
+		LOG_F(WARNING, "Buffered event sink dropped %llu records.", static_cast<unsigned long long>(_droppedRecords));
+}
+
+void LibIPC::BufferedEventSink::Send(std::vector<char>& buffer)
+{
+	const auto size = static_cast<UINT32>(buffer.size());
+	const auto sizeBytes = reinterpret_cast<const char*>(&size);
+	_pending.data.insert(_pending.data.end(), sizeBytes, sizeBytes + RecordHeaderSize);
+	_pending.data.insert(_pending.data.end(), buffer.begin(), buffer.end());
+	++_pending.recordCount;
+
+	if (_pending.data.size() >= FlushThresholdBytes)
+		Flush();
+}
+
+void LibIPC::BufferedEventSink::Flush()
+{
+	if (_pending.recordCount == 0)
+		return;
+
+	PendingBatch batch { { }, 0 };
+	batch.data.reserve(FlushThresholdBytes);
+	std::swap(batch, _pending);
+	{
+		std::lock_guard guard(_mutex);
+		if (_bufferedBytes + batch.data.size() > _maxBufferedBytes)
+		{
+			// Secondary sink is lagging behind, never let it stall the caller
+			_droppedRecords += batch.recordCount;
+			_discontinuities.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		_bufferedBytes += batch.data.size();
+		_batches.push_back(std::move(batch));
+	}
+	_batchAvailable.notify_one();
+}
+
+UINT64 LibIPC::BufferedEventSink::GetDroppedRecordsCount() const
+{
+	std::lock_guard guard(_mutex);
+	return _droppedRecords;
+}
+
+UINT64 LibIPC::BufferedEventSink::GetDiscontinuitiesCount() const
+{
+	return _discontinuities.load(std::memory_order_relaxed) + _sink->GetDiscontinuitiesCount();
+}
+
+void LibIPC::BufferedEventSink::WorkerThreadLoop()
+{
+	while (true)
+	{
+		PendingBatch batch;
+		{
+			std::unique_lock lock(_mutex);
+			_batchAvailable.wait(lock, [this]() { return _terminating || !_batches.empty(); });
+			if (_batches.empty())
+				break;
+
+			batch = std::move(_batches.front());
+			_batches.pop_front();
+		}
+
+		Forward(batch);
+		{
+			std::lock_guard guard(_mutex);
+			_bufferedBytes -= batch.data.size();
+		}
+	}
+
+	_sink->Flush();
+}
+
+void LibIPC::BufferedEventSink::Forward(const PendingBatch& batch)
+{
+	std::size_t offset = 0;
+	while (offset + RecordHeaderSize <= batch.data.size())
+	{
+		UINT32 size = 0;
+		std::memcpy(&size, batch.data.data() + offset, RecordHeaderSize);
+		offset += RecordHeaderSize;
+		_record.assign(batch.data.data() + offset, batch.data.data() + offset + size);
+		offset += size;
+		_sink->Send(_record);
+	}
+
+	_sink->Flush();
+}
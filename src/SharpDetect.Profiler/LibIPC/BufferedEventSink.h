@@ -0,0 +1,66 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cor.h"
+#include "EventSink.h"
+
+namespace LibIPC
+{
+	// Decouples a (possibly slow) sink from the caller by handing batches over to a worker thread.
+	// Once the bounded buffer is full, further batches are dropped instead of stalling the caller.
+	class BufferedEventSink : public IEventSink
+	{
+	public:
+		static constexpr std::size_t RecordHeaderSize = sizeof(UINT32);
+		static constexpr std::size_t FlushThresholdBytes = 64 * 1024;
+
+		BufferedEventSink(std::unique_ptr<IEventSink> sink, std::size_t maxBufferedBytes);
+		~BufferedEventSink() override;
+		BufferedEventSink(const BufferedEventSink&) = delete;
+		BufferedEventSink& operator=(const BufferedEventSink&) = delete;
+		BufferedEventSink(BufferedEventSink&&) = delete;
+		BufferedEventSink& operator=(BufferedEventSink&&) = delete;
+
+		void Send(std::vector<char>& buffer) override;
+		void Flush() override;
+		// Includes the discontinuities of the wrapped sink
+		[[nodiscard]] UINT64 GetDiscontinuitiesCount() const override;
+
+		[[nodiscard]] UINT64 GetDroppedRecordsCount() const;
+
+	private:
+		struct PendingBatch
+		{
+			std::vector<char> data;
+			UINT32 recordCount;
+		};
+
+		void WorkerThreadLoop();
+		void Forward(const PendingBatch& batch);
+
+		std::unique_ptr<IEventSink> _sink;
+		const std::size_t _maxBufferedBytes;
+		PendingBatch _pending;
+		std::vector<char> _record;
+
+		mutable std::mutex _mutex;
+		std::condition_variable _batchAvailable;
+		std::deque<PendingBatch> _batches;
+		std::size_t _bufferedBytes;
+		UINT64 _droppedRecords;
+		std::atomic<UINT64> _discontinuities;
+		bool _terminating;
+		std::thread _workerThread;
+	};
+}
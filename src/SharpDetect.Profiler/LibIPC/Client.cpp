@@ -1,6 +1,7 @@
 // Copyright 2026 Andrej Čižmárik and Contributors
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
 #include <cstdlib>
 #include <stdexcept>
 #include <utility>
@@ -11,11 +12,15 @@
 
 #include "Client.h"
 #include "Messages.h"
+#include "SocketEventSink.h"
+#include "TeeEventSink.h"
+#include "TraceFileSink.h"
 
 LibIPC::Client::Client(
     const QueueEndpoint& commandQueue,
     const QueueEndpoint& eventQueue,
-    const RegistrationEndpoint& registrationQueue) :
+    const RegistrationEndpoint& registrationQueue,
+    const EventSinkOptions& sinkOptions) :
 	_commandReceivingEnabled(true),
 	_shutdownCompleted(false)
 {
@@ -44,9 +49,7 @@ LibIPC::Client::Client(
 
 	_library = std::make_unique<IpqLibrary>(ipqPath);
 
-	// Create producer for events
-	LOG_F(INFO, "IPC event worker configuration: { name: %s, file: %s, size: %d }", eventQueue.name.c_str(), eventQueue.file.c_str(), eventQueue.size);
-	_producer = std::make_unique<IpqProducer>(*_library, eventQueue.name, eventQueue.file, eventQueue.semaphoreName, static_cast<INT>(eventQueue.size));
+	_sink = CreateEventSink(eventQueue, sinkOptions);
 
 	const auto currentPid = static_cast<INT>(LibProfiler::PAL_GetCurrentPid());
 	LOG_F(INFO, "Registering process %d via table: { name: %s, file: %s, size: %d }", currentPid, registrationQueue.name.c_str(), registrationQueue.file.c_str(), registrationQueue.size);
@@ -61,8 +64,8 @@ LibIPC::Client::Client(
 	LOG_F(INFO, "IPC command worker configuration: { name: %s, file: %s, size: %d }", commandQueue.name.c_str(), commandQueue.file.c_str(), commandQueue.size);
 	_consumer = std::make_unique<IpqConsumer>(*_library, commandQueue.name, commandQueue.file, commandQueue.semaphoreName, static_cast<INT>(commandQueue.size));
 
-	_events = std::make_unique<EventDispatcher>(*_producer, eventQueueMaxBytes);
-	_commands = std::make_unique<CommandDispatcher>(*_consumer);
+	_events = std::make_unique<EventDispatcher>(*_sink, eventQueueMaxBytes);
+	_commands = std::make_unique<CommandDispatcher>(*_consumer, *_events, _commandLatency);
 
 	LOG_F(INFO, "Communication library initialized with command receiving enabled.");
 	_events->Start();
@@ -74,9 +77,62 @@ LibIPC::Client::~Client()
 	Shutdown();
 }
 
+std::unique_ptr<LibIPC::IEventSink> LibIPC::Client::CreateEventSink(
+	const QueueEndpoint& eventQueue,
+	const EventSinkOptions& sinkOptions) const
+{
+	auto primary = CreateEventSink(sinkOptions.kind, eventQueue, sinkOptions);
+
+	// Sinks of the same kind share their configuration, a repeated kind would write the same events twice
+	std::vector<EventSinkKind> usedKinds { sinkOptions.kind };
+	std::vector<std::unique_ptr<IEventSink>> secondaries;
+	for (const auto kind : sinkOptions.secondaryKinds)
+	{
+		if (std::ranges::find(usedKinds, kind) != usedKinds.cend())
+		{
+			LOG_F(WARNING, "Ignoring secondary event sink %d, a sink of the same kind is already configured.", static_cast<INT>(kind));
+			continue;
+		}
+		usedKinds.push_back(kind);
+		secondaries.push_back(CreateEventSink(kind, eventQueue, sinkOptions));
+	}
+
+	if (secondaries.empty())
+		return primary;
+
+	LOG_F(INFO, "Forwarding events to %zu secondary sinks (buffer: %zu bytes each).", secondaries.size(), sinkOptions.secondaryBufferMaxBytes);
+	return std::make_unique<TeeEventSink>(std::move(primary), std::move(secondaries), sinkOptions.secondaryBufferMaxBytes);
+}
+
+std::unique_ptr<LibIPC::IEventSink> LibIPC::Client::CreateEventSink(
+	const EventSinkKind kind,
+	const QueueEndpoint& eventQueue,
+	const EventSinkOptions& sinkOptions) const
+{
+	switch (kind)
+	{
+	case EventSinkKind::TraceFile:
+	{
+		const auto& traceFile = sinkOptions.traceFile;
+		LOG_F(INFO, "Trace file configuration: { path: %s, segmentSize: %llu, maxSize: %llu }",
+			traceFile.path.c_str(),
+			static_cast<unsigned long long>(traceFile.segmentSize),
+			static_cast<unsigned long long>(traceFile.maxSize));
+		return std::make_unique<TraceFileSink>(traceFile.path, traceFile.segmentSize, traceFile.maxSize);
+	}
+	case EventSinkKind::Socket:
+		LOG_F(INFO, "Event stream configuration: { endpoint: %s }", sinkOptions.socketEndpoint.c_str());
+		return std::make_unique<SocketEventSink>(sinkOptions.socketEndpoint);
+	case EventSinkKind::Ipq:
+	default:
+		LOG_F(INFO, "IPC event worker configuration: { name: %s, file: %s, size: %d }", eventQueue.name.c_str(), eventQueue.file.c_str(), eventQueue.size);
+		return std::make_unique<IpqProducer>(*_library, eventQueue.name, eventQueue.file, eventQueue.semaphoreName, static_cast<INT>(eventQueue.size));
+	}
+}
+
 void LibIPC::Client::Shutdown()
 {
-	if (_producer == nullptr)
+	if (_sink == nullptr)
 		return;
 
 	if (_shutdownCompleted.exchange(true, std::memory_order_acq_rel))
@@ -84,7 +140,10 @@ void LibIPC::Client::Shutdown()
 
 	_events->Stop();
 	if (_commandReceivingEnabled)
+	{
 		_commands->Stop();
+		_commandLatency.LogSummary();
+	}
 
 	// Notify managed that we are gracefully terminating
 	const auto destroyMsg = Helpers::CreateProfilerDestroyMsg(
@@ -95,6 +154,6 @@ void LibIPC::Client::Shutdown()
 	buffer.reserve(sizeof(BYTE) + sbuf.size());
 	buffer.push_back(static_cast<char>(FixedEvents::MsgPackFormat));
 	buffer.insert(buffer.end(), sbuf.data(), sbuf.data() + sbuf.size());
-	_producer->Send(buffer);
-	_producer->Flush();
+	_sink->Send(buffer);
+	_sink->Flush();
 }
@@ -10,7 +10,10 @@
 #include "../lib/msgpack-c/include/msgpack.hpp"
 #include "cor.h"
 #include "CommandDispatcher.h"
+#include "CommandLatencyTracker.h"
 #include "EventDispatcher.h"
+#include "EventSink.h"
+#include "EventSinkOptions.h"
 #include "FixedEvents.h"
 #include "IpqConsumer.h"
 #include "IpqLibrary.h"
@@ -26,7 +29,8 @@ namespace LibIPC
 		Client(
 			const QueueEndpoint& commandQueue,
 			const QueueEndpoint& eventQueue,
-			const RegistrationEndpoint& registrationQueue);
+			const RegistrationEndpoint& registrationQueue,
+			const EventSinkOptions& sinkOptions);
 		Client(Client&& other) = delete;
 		Client& operator=(Client&&) = delete;
 		Client(Client& other) = delete;
@@ -57,13 +61,32 @@ namespace LibIPC
 			_events->Enqueue(data, size);
 		}
 
+		// Changes whenever a sink may have lost records, see IEventSink::GetDiscontinuitiesCount
+		[[nodiscard]] UINT64 GetEventDiscontinuitiesCount() const { return _sink->GetDiscontinuitiesCount(); }
+
 		void SetCommandHandler(ICommandHandler* handler)
 		{
 		    _commands->SetCommandHandler(handler);
 		}
 		[[nodiscard]] bool IsCommandReceivingEnabled() const { return _commandReceivingEnabled; }
 
+		// Must be called after the response to a command has been sent
+		void OnCommandCompleted(const UINT64 commandId)
+		{
+			_commandLatency.OnResponseEnqueued(commandId);
+			// Do not let the response linger in a partially filled batch
+			_events->RequestFlush(_events->GetSequence());
+		}
+
 	private:
+		[[nodiscard]] std::unique_ptr<IEventSink> CreateEventSink(
+			const QueueEndpoint& eventQueue,
+			const EventSinkOptions& sinkOptions) const;
+		[[nodiscard]] std::unique_ptr<IEventSink> CreateEventSink(
+			EventSinkKind kind,
+			const QueueEndpoint& eventQueue,
+			const EventSinkOptions& sinkOptions) const;
+
 		static void PrepareMsgPackBuffer(msgpack::sbuffer& buffer)
 		{
 			constexpr auto format = static_cast<char>(FixedEvents::MsgPackFormat);
@@ -74,8 +97,9 @@ namespace LibIPC
 		bool _commandReceivingEnabled;
 		std::atomic_bool _shutdownCompleted;
 		std::unique_ptr<IpqLibrary> _library;
-		std::unique_ptr<IpqProducer> _producer;
+		std::unique_ptr<IEventSink> _sink;
 		std::unique_ptr<IpqConsumer> _consumer;
+		CommandLatencyTracker _commandLatency;
 		std::unique_ptr<EventDispatcher> _events;
 		std::unique_ptr<CommandDispatcher> _commands;
 	};
@@ -1,17 +1,32 @@
 // Copyright 2026 Andrej Čižmárik and Contributors
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
 #include "../lib/loguru/loguru.hpp"
 #include "../lib/msgpack-c/include/msgpack.hpp"
 
 #include "CommandDispatcher.h"
-#include "Messages.h"
 
-LibIPC::CommandDispatcher::CommandDispatcher(const IpqConsumer& consumer) :
+LibIPC::CommandDispatcher::CommandDispatcher(const IpqConsumer& consumer, EventDispatcher& events, CommandLatencyTracker& latencyTracker) :
 	_consumer(consumer),
+	_events(events),
+	_latencyTracker(latencyTracker),
+	_workers(WorkersCount),
 	_terminating(false),
-	_commandHandler(nullptr)
+	_commandHandler(nullptr),
+	_snapshotScheduled(false)
 {
+	// Stack snapshots suspend the whole runtime, running them concurrently would only serialize on the suspension
+	_workers.SetConcurrencyLimit(static_cast<INT32>(ProfilerCommandType::CreateStackSnapshots), 1);
+	// Reconfigurations of the same kind must be applied in the order they were issued
+	_workers.SetConcurrencyLimit(static_cast<INT32>(ProfilerCommandType::SetMethodDescriptorActive), 1);
+	_workers.SetConcurrencyLimit(static_cast<INT32>(ProfilerCommandType::SetFieldsAccessInstrumentation), 1);
+	_workers.SetConcurrencyLimit(static_cast<INT32>(ProfilerCommandType::SetStackTraceCollectionMaxDepth), 1);
+	// Waiting barriers must not occupy all workers, they are also answered in the order they were issued
+	_workers.SetConcurrencyLimit(static_cast<INT32>(ProfilerCommandType::DrainBarrier), 1);
 }
 
 void LibIPC::CommandDispatcher::Start()
@@ -22,23 +37,34 @@ void LibIPC::CommandDispatcher::Start()
 void LibIPC::CommandDispatcher::Stop()
 {
 	_terminating.store(true, std::memory_order_release);
+	// The worker blocks on the command queue until a command arrives, wake it up to observe termination
+	_consumer.Wake();
 	if (_thread.joinable())
 		_thread.join();
+	_workers.Stop();
 }
 
 void LibIPC::CommandDispatcher::CommandThreadLoop()
 {
-	constexpr INT dequeueTimeoutMs = 50;
+	constexpr INT maxFailureBackoffMs = 50;
 
 	LOG_F(INFO, "IPC command worker thread started.");
 
+	INT consecutiveFailures = 0;
 	while (!_terminating)
 	{
 		BYTE* dataPtr = nullptr;
 		INT size = 0;
 
-		if (!_consumer.TryDequeue(&dataPtr, &size, dequeueTimeoutMs))
+		if (!_consumer.TryDequeue(&dataPtr, &size, IpqConsumer::InfiniteTimeout))
+		{
+			// Wake-ups and spurious semaphore signals return immediately, back off only if the queue keeps failing
+			if (++consecutiveFailures > 1 && !_terminating)
+				std::this_thread::sleep_for(std::chrono::milliseconds(std::min(consecutiveFailures, maxFailureBackoffMs)));
 			continue;
+		}
+
+		consecutiveFailures = 0;
 
 		try
 		{
@@ -63,6 +89,7 @@ void LibIPC::CommandDispatcher::CommandThreadLoop()
 			}
 
 			const UINT64 commandId = metadataObj.via.array.ptr[1].as<UINT64>();
+			const auto receivedAt = CommandLatencyTracker::Clock::now();
 
 			// Extract union: [discriminator, args]
 			const auto& unionObj = obj.via.array.ptr[1];
@@ -77,40 +104,105 @@ void LibIPC::CommandDispatcher::CommandThreadLoop()
 			const auto& argsObj = unionObj.via.array.ptr[1];
 
 			// Handle based on command type
-			if (_commandHandler != nullptr)
+			switch (static_cast<ProfilerCommandType>(discriminator))
 			{
-				switch (static_cast<ProfilerCommandType>(discriminator))
+			case ProfilerCommandType::CreateStackSnapshot:
+			{
+				if (argsObj.type == msgpack::type::ARRAY && argsObj.via.array.size == 1)
+				{
+					const UINT64 targetThreadId = argsObj.via.array.ptr[0].as<UINT64>();
+					ScheduleStackSnapshot({ commandId, ProfilerCommandType::CreateStackSnapshot, { targetThreadId } }, receivedAt);
+				}
+				else
 				{
-				case ProfilerCommandType::CreateStackSnapshot:
+					LOG_F(WARNING, "Invalid CreateStackSnapshot arguments.");
+				}
+				break;
+			}
+			case ProfilerCommandType::CreateStackSnapshots:
+			{
+				if (argsObj.type == msgpack::type::ARRAY && argsObj.via.array.size == 1)
+				{
+					auto threadIds = argsObj.via.array.ptr[0].as<std::vector<UINT64>>();
+					ScheduleStackSnapshot({ commandId, ProfilerCommandType::CreateStackSnapshots, std::move(threadIds) }, receivedAt);
+				}
+				else
+				{
+					LOG_F(WARNING, "Invalid CreateStackSnapshots arguments.");
+				}
+				break;
+			}
+			case ProfilerCommandType::SetMethodDescriptorActive:
+			{
+				if (argsObj.type == msgpack::type::ARRAY && argsObj.via.array.size == 3)
 				{
-					if (argsObj.type == msgpack::type::ARRAY && argsObj.via.array.size == 1)
+					auto declaringTypeFullName = argsObj.via.array.ptr[0].as<std::string>();
+					auto methodName = argsObj.via.array.ptr[1].as<std::string>();
+					const auto active = argsObj.via.array.ptr[2].as<bool>();
+					ScheduleCommand(ProfilerCommandType::SetMethodDescriptorActive, commandId, receivedAt, [=, this]()
 					{
-						const UINT64 targetThreadId = argsObj.via.array.ptr[0].as<UINT64>();
-						_commandHandler->OnCreateStackSnapshot(commandId, targetThreadId);
-					}
-					else
+						_commandHandler->OnSetMethodDescriptorActive(commandId, declaringTypeFullName, methodName, active);
+					});
+				}
+				else
+				{
+					LOG_F(WARNING, "Invalid SetMethodDescriptorActive arguments.");
+				}
+				break;
+			}
+			case ProfilerCommandType::SetFieldsAccessInstrumentation:
+			{
+				if (argsObj.type == msgpack::type::ARRAY && argsObj.via.array.size == 2)
+				{
+					auto moduleIds = argsObj.via.array.ptr[0].as<std::vector<UINT64>>();
+					const auto enabled = argsObj.via.array.ptr[1].as<bool>();
+					ScheduleCommand(ProfilerCommandType::SetFieldsAccessInstrumentation, commandId, receivedAt, [=, this]()
 					{
-						LOG_F(WARNING, "Invalid CreateStackSnapshot arguments.");
-					}
-					break;
+						_commandHandler->OnSetFieldsAccessInstrumentation(commandId, moduleIds, enabled);
+					});
 				}
-				case ProfilerCommandType::CreateStackSnapshots:
+				else
 				{
-					if (argsObj.type == msgpack::type::ARRAY && argsObj.via.array.size == 1)
+					LOG_F(WARNING, "Invalid SetFieldsAccessInstrumentation arguments.");
+				}
+				break;
+			}
+			case ProfilerCommandType::SetStackTraceCollectionMaxDepth:
+			{
+				if (argsObj.type == msgpack::type::ARRAY && argsObj.via.array.size == 1)
+				{
+					const auto maxDepth = argsObj.via.array.ptr[0].as<UINT>();
+					ScheduleCommand(ProfilerCommandType::SetStackTraceCollectionMaxDepth, commandId, receivedAt, [=, this]()
 					{
-						auto threadIds = argsObj.via.array.ptr[0].as<std::vector<UINT64>>();
-						_commandHandler->OnCreateStackSnapshots(commandId, threadIds);
-					}
-					else
+						_commandHandler->OnSetStackTraceCollectionMaxDepth(commandId, maxDepth);
+					});
+				}
+				else
+				{
+					LOG_F(WARNING, "Invalid SetStackTraceCollectionMaxDepth arguments.");
+				}
+				break;
+			}
+			case ProfilerCommandType::DrainBarrier:
+			{
+				if (argsObj.type == msgpack::type::ARRAY && argsObj.via.array.size == 0)
+				{
+					// The cut point is the sequence current at command receipt, not at execution
+					const auto sequence = _events.GetSequence();
+					ScheduleCommand(ProfilerCommandType::DrainBarrier, commandId, receivedAt, [=, this]()
 					{
-						LOG_F(WARNING, "Invalid CreateStackSnapshots arguments.");
-					}
-					break;
+						ExecuteDrainBarrier(commandId, sequence);
+					});
 				}
-				default:
-					LOG_F(WARNING, "Unknown command type. Discriminator: %d", discriminator);
-					break;
+				else
+				{
+					LOG_F(WARNING, "Invalid DrainBarrier arguments.");
 				}
+				break;
+			}
+			default:
+				LOG_F(WARNING, "Unknown command type. Discriminator: %d", discriminator);
+				break;
 			}
 		}
 		catch (const std::exception& ex)
@@ -122,3 +214,77 @@ void LibIPC::CommandDispatcher::CommandThreadLoop()
 	}
 	LOG_F(INFO, "IPC command worker thread terminated.");
 }
+
+void LibIPC::CommandDispatcher::ScheduleCommand(
+	const ProfilerCommandType commandType,
+	const UINT64 commandId,
+	const CommandLatencyTracker::Clock::time_point receivedAt,
+	CommandWorkerPool::Work work)
+{
+	if (_commandHandler == nullptr)
+		return;
+
+	// Registered before submitting, the response may be enqueued before Submit returns
+	_latencyTracker.OnCommandReceived(commandId, receivedAt);
+	if (!_workers.Submit(static_cast<INT32>(commandType), std::move(work)))
+		_latencyTracker.OnCommandDropped(commandId);
+}
+
+void LibIPC::CommandDispatcher::ScheduleStackSnapshot(StackSnapshotRequest&& request, const CommandLatencyTracker::Clock::time_point receivedAt)
+{
+	if (_commandHandler == nullptr)
+		return;
+
+	_latencyTracker.OnCommandReceived(request.commandId, receivedAt);
+	bool schedule;
+	{
+		std::lock_guard guard(_snapshotsMutex);
+		_pendingSnapshots.push_back(std::move(request));
+		schedule = !_snapshotScheduled;
+		_snapshotScheduled = true;
+	}
+
+	// Requests arriving before the scheduled execution starts are merged into it
+	if (schedule && !_workers.Submit(
+		static_cast<INT32>(ProfilerCommandType::CreateStackSnapshots),
+		[this]() { ExecuteStackSnapshots(); }))
+	{
+		std::lock_guard guard(_snapshotsMutex);
+		for (const auto& pending : _pendingSnapshots)
+			_latencyTracker.OnCommandDropped(pending.commandId);
+		_pendingSnapshots.clear();
+		_snapshotScheduled = false;
+	}
+}
+
+void LibIPC::CommandDispatcher::ExecuteStackSnapshots()
+{
+	std::vector<StackSnapshotRequest> requests;
+	{
+		std::lock_guard guard(_snapshotsMutex);
+		requests.swap(_pendingSnapshots);
+		_snapshotScheduled = false;
+	}
+
+	if (requests.size() > 1)
+		LOG_F(INFO, "Merged %zu stack snapshot commands into a single capture.", requests.size());
+
+	if (_commandHandler != nullptr && !requests.empty())
+		_commandHandler->OnCreateStackSnapshots(requests);
+}
+
+void LibIPC::CommandDispatcher::ExecuteDrainBarrier(const UINT64 commandId, const UINT64 sequence)
+{
+	// The barrier is always answered, otherwise the analyzer waiting for it would hang
+	const auto flushed = _events.WaitForFlush(sequence, DrainBarrierTimeout);
+	const auto flushedSequence = flushed ? sequence : _events.GetFlushedSequence();
+	if (!flushed)
+	{
+		LOG_F(WARNING, "Drain barrier %llu could not flush events up to sequence %llu, flushed up to %llu.",
+			static_cast<unsigned long long>(commandId),
+			static_cast<unsigned long long>(sequence),
+			static_cast<unsigned long long>(flushedSequence));
+	}
+
+	_commandHandler->OnDrainBarrier(commandId, sequence, flushed, flushedSequence);
+}
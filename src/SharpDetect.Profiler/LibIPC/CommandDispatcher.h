@@ -4,26 +4,55 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
 #include "cor.h"
+#include "CommandLatencyTracker.h"
+#include "CommandWorkerPool.h"
+#include "EventDispatcher.h"
 #include "IpqConsumer.h"
+#include "Messages.h"
 
 namespace LibIPC
 {
+	struct StackSnapshotRequest
+	{
+		UINT64 commandId;
+		// Determines the shape of the response (single snapshot or a list of snapshots)
+		ProfilerCommandType commandType;
+		std::vector<UINT64> targetThreadIds;
+	};
+
 	class ICommandHandler
 	{
 	public:
 		virtual ~ICommandHandler() = default;
-		virtual void OnCreateStackSnapshot(UINT64 commandId, UINT64 targetThreadId) = 0;
-		virtual void OnCreateStackSnapshots(UINT64 commandId, const std::vector<UINT64>& targetThreadIds) = 0;
+		// Requests that arrived while another snapshot was in progress are delivered together
+		// and are expected to be served by a single runtime suspension
+		virtual void OnCreateStackSnapshots(const std::vector<StackSnapshotRequest>& requests) = 0;
+		virtual void OnSetMethodDescriptorActive(
+			UINT64 commandId,
+			const std::string& declaringTypeFullName,
+			const std::string& methodName,
+			bool active) = 0;
+		virtual void OnSetFieldsAccessInstrumentation(UINT64 commandId, const std::vector<UINT64>& moduleIds, bool enabled) = 0;
+		virtual void OnSetStackTraceCollectionMaxDepth(UINT64 commandId, UINT maxDepth) = 0;
+		// Either all events preceding the sequence were flushed to the sink, or the flush timed out
+		// and only events preceding flushedSequence are known to be flushed
+		virtual void OnDrainBarrier(UINT64 commandId, UINT64 sequence, bool flushed, UINT64 flushedSequence) = 0;
 	};
 
 	class CommandDispatcher
 	{
 	public:
-		explicit CommandDispatcher(const IpqConsumer& consumer);
+		static constexpr std::size_t WorkersCount = 2;
+		static constexpr std::chrono::milliseconds DrainBarrierTimeout = std::chrono::seconds(5);
+
+		CommandDispatcher(const IpqConsumer& consumer, EventDispatcher& events, CommandLatencyTracker& latencyTracker);
 		~CommandDispatcher() = default;
 		CommandDispatcher(const CommandDispatcher&) = delete;
 		CommandDispatcher& operator=(const CommandDispatcher&) = delete;
@@ -37,10 +66,22 @@ namespace LibIPC
 
 	private:
 		void CommandThreadLoop();
+		// Commands are awaited by the latency tracker only once scheduled, rejected ones are never answered
+		void ScheduleStackSnapshot(StackSnapshotRequest&& request, CommandLatencyTracker::Clock::time_point receivedAt);
+		void ScheduleCommand(ProfilerCommandType commandType, UINT64 commandId, CommandLatencyTracker::Clock::time_point receivedAt, CommandWorkerPool::Work work);
+		void ExecuteStackSnapshots();
+		void ExecuteDrainBarrier(UINT64 commandId, UINT64 sequence);
 
 		const IpqConsumer& _consumer;
+		EventDispatcher& _events;
+		CommandLatencyTracker& _latencyTracker;
+		CommandWorkerPool _workers;
 		std::thread _thread;
 		std::atomic_bool _terminating;
 		ICommandHandler* _commandHandler;
+
+		std::mutex _snapshotsMutex;
+		std::vector<StackSnapshotRequest> _pendingSnapshots;
+		bool _snapshotScheduled;
 	};
 }
@@ -0,0 +1,101 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "../lib/loguru/loguru.hpp"
+
+#include "CommandLatencyTracker.h"
+
+LibIPC::CommandLatencyTracker::CommandLatencyTracker() :
+	_buckets { },
+	_completed(0),
+	_total(0),
+	_min(std::chrono::microseconds::max()),
+	_max(0)
+{
+}
+
+void LibIPC::CommandLatencyTracker::OnCommandReceived(const UINT64 commandId, const Clock::time_point timestamp)
+{
+	std::lock_guard guard(_mutex);
+	_pending.insert_or_assign(commandId, timestamp);
+}
+
+void LibIPC::CommandLatencyTracker::OnResponseEnqueued(const UINT64 commandId, const Clock::time_point timestamp)
+{
+	std::lock_guard guard(_mutex);
+	const auto it = _pending.find(commandId);
+	if (it == _pending.cend())
+		return;
+
+	const auto latency = std::max(
+		std::chrono::microseconds(0),
+		std::chrono::duration_cast<std::chrono::microseconds>(timestamp - it->second));
+	_pending.erase(it);
+
+	const auto bucket = std::min<std::size_t>(
+		std::bit_width(static_cast<UINT64>(latency.count())),
+		BucketsCount - 1);
+	++_buckets[bucket];
+	++_completed;
+	_total += latency;
+	_min = std::min(_min, latency);
+	_max = std::max(_max, latency);
+}
+
+void LibIPC::CommandLatencyTracker::OnCommandDropped(const UINT64 commandId)
+{
+	std::lock_guard guard(_mutex);
+	_pending.erase(commandId);
+}
+
+LibIPC::CommandLatencyTracker::Summary LibIPC::CommandLatencyTracker::GetSummary() const
+{
+	std::lock_guard guard(_mutex);
+	Summary summary { };
+	summary.completed = _completed;
+	summary.pending = _pending.size();
+	if (_completed == 0)
+		return summary;
+
+	summary.min = _min;
+	summary.max = _max;
+	summary.mean = _total / static_cast<INT64>(_completed);
+	summary.p50 = GetPercentile(0.50);
+	summary.p99 = GetPercentile(0.99);
+	return summary;
+}
+
+void LibIPC::CommandLatencyTracker::LogSummary() const
+{
+	const auto summary = GetSummary();
+	if (summary.completed == 0 && summary.pending == 0)
+		return;
+
+	LOG_F(
+		INFO,
+		"Command round-trip latency: { completed: %llu, pending: %llu, min: %lld us, mean: %lld us, p50: <%lld us, p99: <%lld us, max: %lld us }",
+		static_cast<unsigned long long>(summary.completed),
+		static_cast<unsigned long long>(summary.pending),
+		static_cast<long long>(summary.min.count()),
+		static_cast<long long>(summary.mean.count()),
+		static_cast<long long>(summary.p50.count()),
+		static_cast<long long>(summary.p99.count()),
+		static_cast<long long>(summary.max.count()));
+}
+
+std::chrono::microseconds LibIPC::CommandLatencyTracker::GetPercentile(const double percentile) const
+{
+	const auto rank = static_cast<UINT64>(std::ceil(percentile * static_cast<double>(_completed)));
+	UINT64 seen = 0;
+	for (std::size_t bucket = 0; bucket < BucketsCount; ++bucket)
+	{
+		seen += _buckets[bucket];
+		if (seen >= rank)
+			return std::min(std::chrono::microseconds(UINT64 { 1 } << bucket), _max);
+	}
+	return _max;
+}
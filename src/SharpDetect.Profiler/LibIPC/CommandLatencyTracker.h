@@ -0,0 +1,61 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
+#include "cor.h"
+
+namespace LibIPC
+{
+	// Measures command round-trip latency: from a command's arrival to its response being enqueued
+	class CommandLatencyTracker
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+		// Bucket i holds latencies in [2^(i-1), 2^i) microseconds
+		static constexpr std::size_t BucketsCount = 32;
+
+		struct Summary
+		{
+			UINT64 completed;
+			UINT64 pending;
+			std::chrono::microseconds min;
+			std::chrono::microseconds max;
+			std::chrono::microseconds mean;
+			// Percentiles are upper bounds of the histogram bucket they fall into
+			std::chrono::microseconds p50;
+			std::chrono::microseconds p99;
+		};
+
+		CommandLatencyTracker();
+		~CommandLatencyTracker() = default;
+		CommandLatencyTracker(const CommandLatencyTracker&) = delete;
+		CommandLatencyTracker& operator=(const CommandLatencyTracker&) = delete;
+		CommandLatencyTracker(CommandLatencyTracker&&) = delete;
+		CommandLatencyTracker& operator=(CommandLatencyTracker&&) = delete;
+
+		void OnCommandReceived(UINT64 commandId, Clock::time_point timestamp = Clock::now());
+		void OnResponseEnqueued(UINT64 commandId, Clock::time_point timestamp = Clock::now());
+		// Forgets a received command that will never be answered
+		void OnCommandDropped(UINT64 commandId);
+
+		[[nodiscard]] Summary GetSummary() const;
+		void LogSummary() const;
+
+	private:
+		[[nodiscard]] std::chrono::microseconds GetPercentile(double percentile) const;
+
+		mutable std::mutex _mutex;
+		std::unordered_map<UINT64, Clock::time_point> _pending;
+		std::array<UINT64, BucketsCount> _buckets;
+		UINT64 _completed;
+		std::chrono::microseconds _total;
+		std::chrono::microseconds _min;
+		std::chrono::microseconds _max;
+	};
+}
@@ -0,0 +1,115 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+#include "../lib/loguru/loguru.hpp"
+
+#include "CommandWorkerPool.h"
+
+LibIPC::CommandWorkerPool::CommandWorkerPool(const std::size_t workersCount) :
+	_terminating(false)
+{
+	const auto count = std::max<std::size_t>(workersCount, 1);
+	_workers.reserve(count);
+	for (std::size_t i = 0; i < count; ++i)
+		_workers.emplace_back(&LibIPC::CommandWorkerPool::WorkerLoop, this);
+}
+
+LibIPC::CommandWorkerPool::~CommandWorkerPool()
+{
+	Stop();
+}
+
+void LibIPC::CommandWorkerPool::SetConcurrencyLimit(const INT32 commandType, const std::size_t limit)
+{
+	std::lock_guard guard(_mutex);
+	_limits.insert_or_assign(commandType, std::max<std::size_t>(limit, 1));
+}
+
+bool LibIPC::CommandWorkerPool::Submit(const INT32 commandType, Work work)
+{
+	{
+		std::lock_guard guard(_mutex);
+		if (_terminating)
+			return false;
+
+		_queue.push_back({ commandType, std::move(work) });
+	}
+	// Any idle worker may be the one able to run it, limits are re-evaluated under the lock
+	_signal.notify_all();
+	return true;
+}
+
+void LibIPC::CommandWorkerPool::Stop()
+{
+	std::size_t droppedCount;
+	{
+		std::lock_guard guard(_mutex);
+		if (_terminating && _workers.empty())
+			return;
+
+		_terminating = true;
+		droppedCount = _queue.size();
+		_queue.clear();
+	}
+	_signal.notify_all();
+
+	for (auto& worker : _workers)
+	{
+		if (worker.joinable())
+			worker.join();
+	}
+	_workers.clear();
+
+	if (droppedCount > 0)
+		LOG_F(WARNING, "Dropped %zu commands that were not started before termination.", droppedCount);
+}
+
+bool LibIPC::CommandWorkerPool::TryTakeRunnable(PendingWork& result)
+{
+	for (auto it = _queue.begin(); it != _queue.end(); ++it)
+	{
+		const auto limit = _limits.find(it->commandType);
+		if (limit != _limits.cend() && _running[it->commandType] >= limit->second)
+			continue;
+
+		result = std::move(*it);
+		_queue.erase(it);
+		++_running[result.commandType];
+		return true;
+	}
+	return false;
+}
+
+void LibIPC::CommandWorkerPool::WorkerLoop()
+{
+	while (true)
+	{
+		PendingWork pending;
+		{
+			std::unique_lock lock(_mutex);
+			_signal.wait(lock, [&]() { return _terminating || TryTakeRunnable(pending); });
+			if (!pending.work)
+				return;
+		}
+
+		try
+		{
+			pending.work();
+		}
+		catch (const std::exception& ex)
+		{
+			LOG_F(ERROR, "Error executing command: %s", ex.what());
+		}
+
+		{
+			std::lock_guard guard(_mutex);
+			--_running[pending.commandType];
+		}
+		// A slot for this command type was released, a blocked command may now be runnable
+		_signal.notify_all();
+	}
+}
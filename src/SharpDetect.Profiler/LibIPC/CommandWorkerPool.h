@@ -0,0 +1,57 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "cor.h"
+
+namespace LibIPC
+{
+	// Executes commands on a fixed set of workers, limiting how many commands of each type run at once
+	class CommandWorkerPool
+	{
+	public:
+		using Work = std::function<void()>;
+
+		explicit CommandWorkerPool(std::size_t workersCount);
+		~CommandWorkerPool();
+		CommandWorkerPool(const CommandWorkerPool&) = delete;
+		CommandWorkerPool& operator=(const CommandWorkerPool&) = delete;
+		CommandWorkerPool(CommandWorkerPool&&) = delete;
+		CommandWorkerPool& operator=(CommandWorkerPool&&) = delete;
+
+		// Commands without an explicit limit may occupy all workers
+		void SetConcurrencyLimit(INT32 commandType, std::size_t limit);
+		// Commands of the same type start in submission order, returns false once the pool is stopping
+		bool Submit(INT32 commandType, Work work);
+		// Waits for running commands to finish, commands that did not start yet are dropped
+		void Stop();
+
+	private:
+		struct PendingWork
+		{
+			INT32 commandType;
+			Work work;
+		};
+
+		[[nodiscard]] bool TryTakeRunnable(PendingWork& result);
+		void WorkerLoop();
+
+		std::mutex _mutex;
+		std::condition_variable _signal;
+		std::deque<PendingWork> _queue;
+		std::unordered_map<INT32, std::size_t> _limits;
+		std::unordered_map<INT32, std::size_t> _running;
+		std::vector<std::thread> _workers;
+		bool _terminating;
+	};
+}
@@ -29,6 +29,11 @@ void LibIPC::EventDispatcher::Stop()
 		_eventThread.join();
 	
 	DrainAvailableEvents();
+
+	// Release barrier waiters, whatever could be flushed has been flushed by now
+	std::lock_guard guard(_flushMutex);
+	_stopped = true;
+	_flushCondition.notify_all();
 }
 
 void LibIPC::EventDispatcher::Enqueue(const char* payload, const std::size_t size)
@@ -86,6 +91,55 @@ void LibIPC::EventDispatcher::EnqueueOverflowEvent(const char* payload, const st
 	WakeDrain();
 }
 
+UINT64 LibIPC::EventDispatcher::GetSequence() const
+{
+	return _sequence.load(std::memory_order_acquire);
+}
+
+void LibIPC::EventDispatcher::RequestFlush(const UINT64 sequence)
+{
+	auto requested = _requestedFlushSequence.load(std::memory_order_relaxed);
+	while (requested < sequence && !_requestedFlushSequence.compare_exchange_weak(requested, sequence, std::memory_order_seq_cst))
+	{
+		// Keep the highest requested sequence
+	}
+
+	if (_flushedSequence.load(std::memory_order_seq_cst) < sequence)
+		_drainSignal.release();
+}
+
+bool LibIPC::EventDispatcher::WaitForFlush(const UINT64 sequence, const std::chrono::milliseconds timeout)
+{
+	RequestFlush(sequence);
+
+	std::unique_lock lock(_flushMutex);
+	return _flushCondition.wait_for(lock, timeout, [this, sequence]()
+	{
+		return _flushedSequence.load(std::memory_order_seq_cst) >= sequence || _stopped;
+	}) && _flushedSequence.load(std::memory_order_seq_cst) >= sequence;
+}
+
+UINT64 LibIPC::EventDispatcher::GetFlushedSequence() const
+{
+	return _flushedSequence.load(std::memory_order_seq_cst);
+}
+
+void LibIPC::EventDispatcher::FlushSink()
+{
+	_sink.Flush();
+
+	const auto previous = _flushedSequence.load(std::memory_order_relaxed);
+	if (_nextSequenceToEmit <= previous)
+		return;
+
+	_flushedSequence.store(_nextSequenceToEmit, std::memory_order_seq_cst);
+	if (_requestedFlushSequence.load(std::memory_order_seq_cst) > previous)
+	{
+		std::lock_guard guard(_flushMutex);
+		_flushCondition.notify_all();
+	}
+}
+
 void LibIPC::EventDispatcher::WakeDrain()
 {
 	std::atomic_thread_fence(std::memory_order_seq_cst);
@@ -125,7 +179,7 @@ bool LibIPC::EventDispatcher::DrainAvailableEvents()
 
 		if (minSequence == std::numeric_limits<UINT64>::max())
 		{
-			_sink.Flush();
+			FlushSink();
 			_lanes.PruneClosed();
 			return progress;
 		}
@@ -133,7 +187,7 @@ bool LibIPC::EventDispatcher::DrainAvailableEvents()
 		if (minSequence > _nextSequenceToEmit)
 		{
 			// A producer claimed the next sequence but has not published it yet
-			_sink.Flush();
+			FlushSink();
 			if (gapStart == std::chrono::steady_clock::time_point { })
 				gapStart = std::chrono::steady_clock::now();
 
@@ -180,6 +234,11 @@ bool LibIPC::EventDispatcher::DrainAvailableEvents()
 				++_nextSequenceToEmit;
 			}
 		}
+
+		// Do not wait for the drain to run out of events when a barrier was just reached
+		const auto requestedFlush = _requestedFlushSequence.load(std::memory_order_relaxed);
+		if (requestedFlush > _flushedSequence.load(std::memory_order_relaxed) && _nextSequenceToEmit >= requestedFlush)
+			FlushSink();
 	}
 }
 
@@ -4,7 +4,10 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <mutex>
 #include <semaphore>
 #include <thread>
 #include <vector>
@@ -33,11 +36,21 @@ namespace LibIPC
 		void Enqueue(const char* payload, std::size_t size);
 		void EnqueuePriority(const char* payload, std::size_t size);
 
+		// Sequence that will be assigned to the next enqueued event
+		[[nodiscard]] UINT64 GetSequence() const;
+		// Asks the drain to flush the sink once all events preceding the sequence were emitted
+		void RequestFlush(UINT64 sequence);
+		// Blocks until all events preceding the sequence were emitted and flushed
+		bool WaitForFlush(UINT64 sequence, std::chrono::milliseconds timeout);
+		// All events preceding this sequence were emitted and flushed
+		[[nodiscard]] UINT64 GetFlushedSequence() const;
+
 	private:
 		void EnqueueOverflowEvent(const char* payload, std::size_t size);
 		void WakeDrain();
 		bool DrainAvailableEvents();
 		void ParkDrain();
+		void FlushSink();
 		bool AnyEventPending();
 		void EventThreadLoop();
 
@@ -54,5 +67,11 @@ namespace LibIPC
 
 		UINT64 _nextSequenceToEmit = 0;
 		std::vector<char> _drainScratch;
+
+		std::atomic<UINT64> _requestedFlushSequence = 0;
+		std::atomic<UINT64> _flushedSequence = 0;
+		std::mutex _flushMutex;
+		std::condition_variable _flushCondition;
+		bool _stopped = false;
 	};
 }
@@ -5,6 +5,8 @@
 
 #include <vector>
 
+#include "cor.h"
+
 namespace LibIPC
 {
 	class IEventSink
@@ -13,5 +15,9 @@ namespace LibIPC
 		virtual ~IEventSink() = default;
 		virtual void Send(std::vector<char>& buffer) = 0;
 		virtual void Flush() = 0;
+
+		// Grows whenever records may have been lost (dropped, reconnected or a trace segment started)
+		// State that is described only once, such as stack trace definitions, must be described again
+		[[nodiscard]] virtual UINT64 GetDiscontinuitiesCount() const { return 0; }
 	};
 }
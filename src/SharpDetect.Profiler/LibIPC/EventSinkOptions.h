@@ -0,0 +1,52 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "cor.h"
+
+namespace LibIPC
+{
+	enum class EventSinkKind
+	{
+		// Live IPC event queue consumed by the analyzer
+		Ipq,
+		// Segmented memory-mapped trace file for offline analysis
+		TraceFile,
+		// TCP or Unix-domain socket stream to a (possibly remote) receiver
+		Socket
+	};
+
+	struct TraceFileEndpoint
+	{
+		std::string path;
+		UINT64 segmentSize;
+		UINT64 maxSize;
+	};
+
+	struct EventSinkOptions
+	{
+		EventSinkKind kind { EventSinkKind::Ipq };
+		// Additional sinks receiving a copy of every event (e.g. archival next to live analysis)
+		std::vector<EventSinkKind> secondaryKinds;
+		std::size_t secondaryBufferMaxBytes { 64 * 1024 * 1024 };
+		TraceFileEndpoint traceFile;
+		std::string socketEndpoint;
+	};
+
+	inline std::optional<EventSinkKind> TryParseEventSinkKind(const std::string& value)
+	{
+		if (value == "ipq")
+			return EventSinkKind::Ipq;
+		if (value == "traceFile")
+			return EventSinkKind::TraceFile;
+		if (value == "socket")
+			return EventSinkKind::Socket;
+		return std::nullopt;
+	}
+}
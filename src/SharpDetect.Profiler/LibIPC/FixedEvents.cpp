@@ -78,16 +78,16 @@ void LibIPC::FixedEvents::WriteMethodEnterWithArguments(
 	const USHORT interpretation,
 	const ByteSpanView argumentValues,
 	const ByteSpanView argumentInfos,
-	const std::optional<ByteSpanView> stackFrames)
+	const std::optional<UINT32> stackTraceId)
 {
 	WriteHeader(buffer, RecordedEventType::MethodEnterWithArguments, threadId, moduleId, methodToken, interpretation);
 	Append(buffer, BlobLength(argumentValues));
 	Append(buffer, BlobLength(argumentInfos));
-	Append(buffer, stackFrames.has_value() ? BlobLength(*stackFrames) : AbsentBlob);
+	Append(buffer, stackTraceId.has_value() ? InternedStackTrace : AbsentBlob);
 	AppendBlob(buffer, argumentValues);
 	AppendBlob(buffer, argumentInfos);
-	if (stackFrames.has_value())
-		AppendBlob(buffer, *stackFrames);
+	if (stackTraceId.has_value())
+		Append(buffer, *stackTraceId);
 }
 
 void LibIPC::FixedEvents::WriteMethodExitWithArguments(
@@ -108,3 +108,33 @@ void LibIPC::FixedEvents::WriteMethodExitWithArguments(
 	AppendBlob(buffer, byRefArgumentValues);
 	AppendBlob(buffer, byRefArgumentInfos);
 }
+
+void LibIPC::FixedEvents::WriteStackTraceDefinition(
+	std::vector<char>& buffer,
+	const UINT32 stackTraceId,
+	const ByteSpanView stackFrames)
+{
+	buffer.clear();
+	Append(buffer, static_cast<BYTE>(RecordedEventType::StackTraceDefinition));
+	Append(buffer, stackTraceId);
+	AppendBlob(buffer, stackFrames);
+}
+
+void LibIPC::FixedEvents::WriteStackSampleHistogram(
+	std::vector<char>& buffer,
+	const UINT32 samplingPeriod,
+	const UINT32 walks,
+	const std::unordered_map<UINT32, UINT32>& histogram)
+{
+	buffer.clear();
+	buffer.reserve(sizeof(BYTE) + 3 * sizeof(UINT32) + histogram.size() * 2 * sizeof(UINT32));
+	Append(buffer, static_cast<BYTE>(RecordedEventType::StackSampleHistogram));
+	Append(buffer, samplingPeriod);
+	Append(buffer, walks);
+	Append(buffer, static_cast<UINT32>(histogram.size()));
+	for (const auto& [stackTraceId, samples] : histogram)
+	{
+		Append(buffer, stackTraceId);
+		Append(buffer, samples);
+	}
+}
@@ -5,6 +5,7 @@
 
 #include <cstddef>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include "cor.h"
@@ -19,6 +20,8 @@ namespace LibIPC
 		constexpr std::size_t HeaderSize = 22;
 		constexpr BYTE MsgPackFormat = 0;
 		constexpr UINT32 AbsentBlob = 0xFFFFFFFFu;
+		// Stack frames slot referring to an interned stack trace, its u32 id follows the other blobs
+		constexpr UINT32 InternedStackTrace = 0xFFFFFFFEu;
 
 		void WriteMethodEnter(
 			std::vector<char>& buffer,
@@ -42,7 +45,7 @@ namespace LibIPC
 			USHORT interpretation,
 			ByteSpanView argumentValues,
 			ByteSpanView argumentInfos,
-			std::optional<ByteSpanView> stackFrames);
+			std::optional<UINT32> stackTraceId);
 
 		void WriteMethodExitWithArguments(
 			std::vector<char>& buffer,
@@ -53,5 +56,19 @@ namespace LibIPC
 			ByteSpanView returnValue,
 			ByteSpanView byRefArgumentValues,
 			ByteSpanView byRefArgumentInfos);
+
+		// [u32 stackTraceId][frames], sent before the first event referring to the stack trace
+		void WriteStackTraceDefinition(
+			std::vector<char>& buffer,
+			UINT32 stackTraceId,
+			ByteSpanView stackFrames);
+
+		// [u32 samplingPeriod][u32 walks][u32 count][count x (u32 stackTraceId, u32 samples)]
+		// Stack trace ids refer to previously sent definitions, the sampling period is in milliseconds
+		void WriteStackSampleHistogram(
+			std::vector<char>& buffer,
+			UINT32 samplingPeriod,
+			UINT32 walks,
+			const std::unordered_map<UINT32, UINT32>& histogram);
 	}
 }
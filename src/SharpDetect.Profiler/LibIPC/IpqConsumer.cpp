@@ -34,6 +34,11 @@ bool LibIPC::IpqConsumer::TryDequeue(BYTE** data, INT* size, const INT timeoutMs
 	return _library.DequeueTimeout(_handle, data, size, timeoutMs) == 0;
 }
 
+void LibIPC::IpqConsumer::Wake() const
+{
+	_library.WakeConsumer(_handle);
+}
+
 void LibIPC::IpqConsumer::Free(BYTE* data) const
 {
 	_library.FreeMemory(data);
@@ -13,6 +13,9 @@ namespace LibIPC
 	class IpqConsumer
 	{
 	public:
+		// Blocks until a message arrives or the consumer is woken up
+		static constexpr INT InfiniteTimeout = -1;
+
 		IpqConsumer(
 			const IpqLibrary& library,
 			const std::string& name,
@@ -26,6 +29,7 @@ namespace LibIPC
 		IpqConsumer& operator=(IpqConsumer&&) = delete;
 		
 		[[nodiscard]] bool TryDequeue(BYTE** data, INT* size, INT timeoutMs) const;
+		void Wake() const;
 		void Free(BYTE* data) const;
 
 	private:
@@ -25,6 +25,7 @@ LibIPC::IpqLibrary::IpqLibrary(const std::string& libraryPath) :
 	_consumerCreate(nullptr),
 	_consumerDestroy(nullptr),
 	_consumerDequeueTimeout(nullptr),
+	_consumerWake(nullptr),
 	_freeMemory(nullptr)
 {
 	_moduleHandle = LibProfiler::PAL_LoadLibrary(libraryPath);
@@ -41,6 +42,7 @@ LibIPC::IpqLibrary::IpqLibrary(const std::string& libraryPath) :
 	_consumerCreate = ResolveSymbol<ipq_consumer_create>(_moduleHandle, "ipq_consumer_create");
 	_consumerDestroy = ResolveSymbol<ipq_consumer_destroy>(_moduleHandle, "ipq_consumer_destroy");
 	_consumerDequeueTimeout = ResolveSymbol<ipq_consumer_dequeue_timeout>(_moduleHandle, "ipq_consumer_dequeue_timeout");
+	_consumerWake = ResolveSymbol<ipq_consumer_wake>(_moduleHandle, "ipq_consumer_wake");
 	_freeMemory = ResolveSymbol<ipq_free_memory>(_moduleHandle, "ipq_free_memory");
 
 	if (_producerCreate == nullptr ||
@@ -50,6 +52,7 @@ LibIPC::IpqLibrary::IpqLibrary(const std::string& libraryPath) :
 		_consumerCreate == nullptr ||
 		_consumerDestroy == nullptr ||
 		_consumerDequeueTimeout == nullptr ||
+		_consumerWake == nullptr ||
 		_freeMemory == nullptr)
 	{
 		LOG_F(FATAL, "Communication library does not contain expected symbols.");
@@ -95,6 +98,11 @@ INT LibIPC::IpqLibrary::DequeueTimeout(PVOID consumer, BYTE** data, INT* size, c
 	return _consumerDequeueTimeout(consumer, data, size, timeoutMs);
 }
 
+void LibIPC::IpqLibrary::WakeConsumer(PVOID consumer) const
+{
+	_consumerWake(consumer);
+}
+
 void LibIPC::IpqLibrary::FreeMemory(BYTE* data) const
 {
 	_freeMemory(data);
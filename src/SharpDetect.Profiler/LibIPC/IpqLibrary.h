@@ -37,6 +37,7 @@ namespace LibIPC
 			INT size) const;
 		void DestroyConsumer(PVOID consumer) const;
 		[[nodiscard]] INT DequeueTimeout(PVOID consumer, BYTE** data, INT* size, INT timeoutMs) const;
+		void WakeConsumer(PVOID consumer) const;
 		void FreeMemory(BYTE* data) const;
 
 	private:
@@ -47,6 +48,7 @@ namespace LibIPC
 		using ipq_consumer_create = PVOID(*)(const char*, const char*, const char*, INT);
 		using ipq_consumer_destroy = void (*)(PVOID);
 		using ipq_consumer_dequeue_timeout = INT(*)(PVOID, BYTE**, INT*, INT);
+		using ipq_consumer_wake = void (*)(PVOID);
 		using ipq_free_memory = void (*)(BYTE*);
 
 		MODULE_HANDLE _moduleHandle;
@@ -57,6 +59,7 @@ namespace LibIPC
 		ipq_consumer_create _consumerCreate;
 		ipq_consumer_destroy _consumerDestroy;
 		ipq_consumer_dequeue_timeout _consumerDequeueTimeout;
+		ipq_consumer_wake _consumerWake;
 		ipq_free_memory _freeMemory;
 	};
 }
@@ -17,7 +17,8 @@ LibIPC::IpqProducer::IpqProducer(
 	const std::string& semaphore,
 	const INT size) :
 	_library(library),
-	_handle(library.CreateProducer(name, file, semaphore, size))
+	_handle(library.CreateProducer(name, file, semaphore, size)),
+	_discontinuities(0)
 {
 	if (_handle == nullptr)
 	{
@@ -41,6 +42,7 @@ void LibIPC::IpqProducer::Send(std::vector<char>& buffer)
 	if (size > maxRecordSize)
 	{
 		LOG_F(ERROR, "Dropping IPC message (%zu bytes): record exceeds the maximum size.", size);
+		_discontinuities.fetch_add(1, std::memory_order_relaxed);
 		return;
 	}
 
@@ -74,6 +76,25 @@ void LibIPC::IpqProducer::Flush()
 	}
 }
 
+UINT64 LibIPC::IpqProducer::GetDiscontinuitiesCount() const
+{
+	return _discontinuities.load(std::memory_order_relaxed);
+}
+
+void LibIPC::IpqProducer::SendBatch(const char* data, const std::size_t size)
+{
+	if (size > static_cast<std::size_t>(std::numeric_limits<INT>::max()))
+	{
+		LOG_F(ERROR, "Dropping IPC batch (%zu bytes): batch exceeds the maximum size.", size);
+		_discontinuities.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	// Preserve ordering with records that were sent individually
+	Flush();
+	SendMessage(const_cast<char*>(data), size);
+}
+
 void LibIPC::IpqProducer::SendMessage(char* data, const std::size_t size)
 {
 	constexpr INT enqueueOk = 0;
@@ -95,6 +116,7 @@ void LibIPC::IpqProducer::SendMessage(char* data, const std::size_t size)
 				"Dropping IPC message (%zu bytes) after non-recoverable enqueue error: %d.",
 				size,
 				result);
+			_discontinuities.fetch_add(1, std::memory_order_relaxed);
 			return;
 		}
 
@@ -112,6 +134,7 @@ void LibIPC::IpqProducer::SendMessage(char* data, const std::size_t size)
 				"Dropping IPC message (%zu bytes): consumer did not drain the queue within %lld seconds.",
 				size,
 				static_cast<long long>(maxRetryDuration.count()));
+			_discontinuities.fetch_add(1, std::memory_order_relaxed);
 			return;
 		}
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <string>
@@ -35,11 +36,16 @@ namespace LibIPC
 
 		void Send(std::vector<char>& buffer) override;
 		void Flush() override;
+		[[nodiscard]] UINT64 GetDiscontinuitiesCount() const override;
+
+		// Enqueues an already framed batch (e.g. read back from a recorded trace) as a single message
+		void SendBatch(const char* data, std::size_t size);
 
 	private:
 		void SendMessage(char* data, std::size_t size);
 		const IpqLibrary& _library;
 		PVOID _handle;
 		std::vector<char> _batch;
+		std::atomic<UINT64> _discontinuities;
 	};
 }
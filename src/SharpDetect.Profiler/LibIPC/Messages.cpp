@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "Messages.h"
+#include "TrackedObjectIdRuns.h"
 
 using namespace LibIPC;
 using namespace LibIPC::Helpers;
@@ -70,16 +71,20 @@ GarbageCollectionStartMsg Helpers::CreateGarbageCollectionStartMsg(MetadataMsg&&
     return { std::move(metadataMsg), GarbageCollectionStartMsgArgsInstance(discriminator, GarbageCollectionStartMsgArgs()) };
 }
 
-GarbageCollectedTrackedObjectsMsg Helpers::CreateGarbageCollectedTrackedObjectsMsg(MetadataMsg&& metadataMsg, std::vector<UINT64>&& removedTrackedObjects)
+GarbageCollectedTrackedObjectsMsg Helpers::CreateGarbageCollectedTrackedObjectsMsg(MetadataMsg&& metadataMsg, std::span<const UINT64> removedTrackedObjects)
 {
     constexpr auto discriminator = static_cast<INT32>(RecordedEventType::GarbageCollectedTrackedObjects);
-    return { std::move(metadataMsg), GarbageCollectedTrackedObjectsMsgArgsInstance(discriminator, GarbageCollectedTrackedObjectsMsgArgs(std::move(removedTrackedObjects)))};
+    std::vector<BYTE> payload;
+    TrackedObjectIdRuns::Encode(removedTrackedObjects, payload);
+    return { std::move(metadataMsg), GarbageCollectedTrackedObjectsMsgArgsInstance(discriminator, GarbageCollectedTrackedObjectsMsgArgs(std::move(payload)))};
 }
 
-FinalizationQueuedTrackedObjectsMsg Helpers::CreateFinalizationQueuedTrackedObjectsMsg(MetadataMsg&& metadataMsg, std::vector<UINT64>&& finalizationQueuedTrackedObjects)
+FinalizationQueuedTrackedObjectsMsg Helpers::CreateFinalizationQueuedTrackedObjectsMsg(MetadataMsg&& metadataMsg, std::span<const UINT64> finalizationQueuedTrackedObjects)
 {
     constexpr auto discriminator = static_cast<INT32>(RecordedEventType::FinalizationQueuedTrackedObjects);
-    return { std::move(metadataMsg), FinalizationQueuedTrackedObjectsMsgArgsInstance(discriminator, FinalizationQueuedTrackedObjectsMsgArgs(std::move(finalizationQueuedTrackedObjects)))};
+    std::vector<BYTE> payload;
+    TrackedObjectIdRuns::Encode(finalizationQueuedTrackedObjects, payload);
+    return { std::move(metadataMsg), FinalizationQueuedTrackedObjectsMsgArgsInstance(discriminator, FinalizationQueuedTrackedObjectsMsgArgs(std::move(payload)))};
 }
 
 GarbageCollectionFinishMsg Helpers::CreateGarbageCollectionFinishMsg(MetadataMsg&& metadataMsg, UINT64 oldTrackedObjectsCount, UINT64 newTrackedObjectsCount)
@@ -202,6 +207,12 @@ StackTraceSnapshotsMsg Helpers::CreateStackTraceSnapshotsMsg(MetadataMsg&& metad
     return { std::move(metadataMsg), StackTraceSnapshotsMsgArgsInstance(discriminator, StackTraceSnapshotsMsgArgs(std::move(snapshots))) };
 }
 
+DrainBarrierMsg Helpers::CreateDrainBarrierMsg(MetadataMsg&& metadataMsg, UINT64 sequence, bool flushed, UINT64 flushedSequence)
+{
+    constexpr auto discriminator = static_cast<INT32>(RecordedEventType::DrainBarrier);
+    return { std::move(metadataMsg), DrainBarrierMsgArgsInstance(discriminator, DrainBarrierMsgArgs(sequence, flushed, flushedSequence)) };
+}
+
 FieldAccessInstrumentationMsg Helpers::CreateFieldAccessInstrumentationMsg(MetadataMsg&& metadataMsg, UINT64 moduleId, UINT32 mdMethodDef, UINT32 methodOffset, UINT32 fieldToken, UINT64 instrumentationMark, FieldAccessKind accessKind)
 {
 	constexpr auto discriminator = static_cast<INT32>(RecordedEventType::FieldAccessInstrumentation);
@@ -7,6 +7,7 @@
 #include <string>
 #include <vector>
 #include <optional>
+#include <span>
 
 #include "../lib/msgpack-c/include/msgpack.hpp"
 #include "cor.h"
@@ -69,8 +70,10 @@ namespace LibIPC
 		/* Stack trace snapshots */
 		StackTraceSnapshot = 36,
 		StackTraceSnapshots = 37,
-		//Reserved = 38,
-		//Reserved = 39,
+
+		/* Event stream */
+		DrainBarrier = 38,
+		StackTraceDefinition = 39,
 
 		/* Instrumentation */
 		FieldAccessInstrumentation = 40,
@@ -79,6 +82,9 @@ namespace LibIPC
 		InstanceFieldRead = 43,
 		InstanceFieldWrite = 44,
 
+		/* Sampling */
+		StackSampleHistogram = 45,
+
 		/* Exceptions */
 		MethodUnwound = 90,
 	};
@@ -89,7 +95,15 @@ namespace LibIPC
 
 		/* Stack snapshot commands */
 		CreateStackSnapshot = 1,
-		CreateStackSnapshots = 2
+		CreateStackSnapshots = 2,
+
+		/* Runtime reconfiguration commands */
+		SetMethodDescriptorActive = 10,
+		SetFieldsAccessInstrumentation = 11,
+		SetStackTraceCollectionMaxDepth = 12,
+
+		/* Event stream commands */
+		DrainBarrier = 20
 	};
 
 	struct ByteSpanView
@@ -146,11 +160,12 @@ namespace LibIPC
 	using GarbageCollectionStartMsgArgsInstance = msgpack::type::tuple<INT32, GarbageCollectionStartMsgArgs>;
 	using GarbageCollectionStartMsg = msgpack::type::tuple<MetadataMsg, GarbageCollectionStartMsgArgsInstance>;
 
-	using GarbageCollectedTrackedObjectsMsgArgs = msgpack::type::tuple<std::vector<UINT64>>;
+	// Tracked object ids are encoded as TrackedObjectIdRuns
+	using GarbageCollectedTrackedObjectsMsgArgs = msgpack::type::tuple<std::vector<BYTE>>;
 	using GarbageCollectedTrackedObjectsMsgArgsInstance = msgpack::type::tuple<INT32, GarbageCollectedTrackedObjectsMsgArgs>;
 	using GarbageCollectedTrackedObjectsMsg = msgpack::type::tuple<MetadataMsg, GarbageCollectedTrackedObjectsMsgArgsInstance>;
 
-	using FinalizationQueuedTrackedObjectsMsgArgs = msgpack::type::tuple<std::vector<UINT64>>;
+	using FinalizationQueuedTrackedObjectsMsgArgs = msgpack::type::tuple<std::vector<BYTE>>;
 	using FinalizationQueuedTrackedObjectsMsgArgsInstance = msgpack::type::tuple<INT32, FinalizationQueuedTrackedObjectsMsgArgs>;
 	using FinalizationQueuedTrackedObjectsMsg = msgpack::type::tuple<MetadataMsg, FinalizationQueuedTrackedObjectsMsgArgsInstance>;
 
@@ -233,6 +248,10 @@ namespace LibIPC
 	using StackTraceSnapshotsMsgArgs = msgpack::type::tuple<std::vector<StackTraceSnapshotMsgArgs>>;
 	using StackTraceSnapshotsMsgArgsInstance = msgpack::type::tuple<INT32, StackTraceSnapshotsMsgArgs>;
 	using StackTraceSnapshotsMsg = msgpack::type::tuple<MetadataMsg, StackTraceSnapshotsMsgArgsInstance>;
+
+	using DrainBarrierMsgArgs = msgpack::type::tuple<UINT64, bool, UINT64>;
+	using DrainBarrierMsgArgsInstance = msgpack::type::tuple<INT32, DrainBarrierMsgArgs>;
+	using DrainBarrierMsg = msgpack::type::tuple<MetadataMsg, DrainBarrierMsgArgsInstance>;
 	
 	enum class FieldAccessKind : UINT8
 	{
@@ -259,8 +278,9 @@ namespace LibIPC
 		JitCompilationMsg CreateJitCompilationMsg(MetadataMsg&& metadataMsg, UINT32 mdTypeDef, UINT32 mdMethodDef);
 		
 		GarbageCollectionStartMsg CreateGarbageCollectionStartMsg(MetadataMsg&& metadataMsg);
-		GarbageCollectedTrackedObjectsMsg CreateGarbageCollectedTrackedObjectsMsg(MetadataMsg&& metadataMsg, std::vector<UINT64>&& removedTrackedObjects);
-		FinalizationQueuedTrackedObjectsMsg CreateFinalizationQueuedTrackedObjectsMsg(MetadataMsg&& metadataMsg, std::vector<UINT64>&& finalizationQueuedTrackedObjects);
+		// Tracked object ids must be sorted in ascending order without duplicates
+		GarbageCollectedTrackedObjectsMsg CreateGarbageCollectedTrackedObjectsMsg(MetadataMsg&& metadataMsg, std::span<const UINT64> removedTrackedObjects);
+		FinalizationQueuedTrackedObjectsMsg CreateFinalizationQueuedTrackedObjectsMsg(MetadataMsg&& metadataMsg, std::span<const UINT64> finalizationQueuedTrackedObjects);
 		GarbageCollectionFinishMsg CreateGarbageCollectionFinishMsg(MetadataMsg&& metadataMsg, UINT64 oldTrackedObjectsCount, UINT64 newTrackedObjectsCount);
 		
 		ThreadCreateMsg CreateThreadCreateMsg(MetadataMsg&& metadataMsg, UINT64 threadId);
@@ -285,6 +305,7 @@ namespace LibIPC
 		
 		StackTraceSnapshotMsg CreateStackTraceSnapshotMsg(MetadataMsg&& metadataMsg, UINT64 threadId, std::vector<UINT64>&& moduleIds, std::vector<UINT32>&& methodTokens);
 		StackTraceSnapshotsMsg CreateStackTraceSnapshotsMsg(MetadataMsg&& metadataMsg, std::vector<StackTraceSnapshotMsgArgs>&& snapshots);
+		DrainBarrierMsg CreateDrainBarrierMsg(MetadataMsg&& metadataMsg, UINT64 sequence, bool flushed, UINT64 flushedSequence);
 
 		FieldAccessInstrumentationMsg CreateFieldAccessInstrumentationMsg(MetadataMsg&& metadataMsg, UINT64 moduleId, UINT32 mdMethodDef, UINT32 methodOffset, UINT32 fieldToken, UINT64 instrumentationMark, FieldAccessKind accessKind);
 	}
@@ -0,0 +1,364 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+#include "../lib/loguru/loguru.hpp"
+
+#include "SocketChannel.h"
+
+#ifdef _WIN32
+
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+using NativeSocket = SOCKET;
+using SendSize = int;
+#define NATIVE_INVALID_SOCKET INVALID_SOCKET
+#define NATIVE_CLOSE_SOCKET closesocket
+
+#elif __linux__
+
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using NativeSocket = int;
+using SendSize = std::size_t;
+#define NATIVE_INVALID_SOCKET (-1)
+#define NATIVE_CLOSE_SOCKET close
+
+#else
+#error "Unsupported or unrecognized platform!"
+#endif
+
+namespace
+{
+	constexpr auto TcpScheme = "tcp://";
+	constexpr auto UnixScheme = "unix://";
+
+	NativeSocket ToNative(const std::intptr_t handle)
+	{
+		return static_cast<NativeSocket>(handle);
+	}
+
+	bool EnsureSocketsInitialized()
+	{
+#ifdef _WIN32
+		static const auto initialized = []()
+		{
+			WSADATA data;
+			return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+		}();
+		return initialized;
+#else
+		return true;
+#endif
+	}
+
+	bool StartsWith(const std::string& value, const char* prefix)
+	{
+		return value.rfind(prefix, 0) == 0;
+	}
+
+	bool TrySplitHostPort(const std::string& address, std::string& host, std::string& port)
+	{
+		const auto separator = address.rfind(':');
+		if (separator == std::string::npos || separator == 0 || separator + 1 == address.size())
+			return false;
+
+		host = address.substr(0, separator);
+		port = address.substr(separator + 1);
+		return true;
+	}
+
+	bool SetBlocking(const NativeSocket socket, const bool blocking)
+	{
+#ifdef _WIN32
+		u_long nonBlocking = blocking ? 0 : 1;
+		return ioctlsocket(socket, FIONBIO, &nonBlocking) == 0;
+#else
+		const auto flags = fcntl(socket, F_GETFL, 0);
+		return flags != -1 && fcntl(socket, F_SETFL, blocking ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK)) == 0;
+#endif
+	}
+
+	// A blocking connect to an unreachable host only gives up after the SYN retries (minutes on Linux)
+	bool ConnectWithTimeout(const NativeSocket socket, const sockaddr* address, const socklen_t length, const std::chrono::milliseconds timeout)
+	{
+		if (!SetBlocking(socket, false))
+			return false;
+
+		if (connect(socket, address, length) != 0)
+		{
+#ifdef _WIN32
+			if (WSAGetLastError() != WSAEWOULDBLOCK)
+				return false;
+			WSAPOLLFD descriptor { socket, POLLOUT, 0 };
+			if (WSAPoll(&descriptor, 1, static_cast<INT>(timeout.count())) != 1)
+				return false;
+#else
+			if (errno != EINPROGRESS)
+				return false;
+			pollfd descriptor { socket, POLLOUT, 0 };
+			if (poll(&descriptor, 1, static_cast<int>(timeout.count())) != 1)
+				return false;
+#endif
+			int error = 0;
+			socklen_t errorLength = sizeof(error);
+			if (getsockopt(socket, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &errorLength) != 0 || error != 0)
+				return false;
+		}
+
+		// Sends rely on blocking with the send timeout
+		return SetBlocking(socket, true);
+	}
+
+	NativeSocket CreateTcpSocket(const std::string& address, const bool listen, const std::chrono::milliseconds connectTimeout)
+	{
+		std::string host;
+		std::string port;
+		if (!TrySplitHostPort(address, host, port))
+		{
+			LOG_F(ERROR, "Invalid TCP endpoint %s.", address.c_str());
+			return NATIVE_INVALID_SOCKET;
+		}
+
+		addrinfo hints { };
+		hints.ai_family = AF_UNSPEC;
+		hints.ai_socktype = SOCK_STREAM;
+		hints.ai_protocol = IPPROTO_TCP;
+		hints.ai_flags = listen ? AI_PASSIVE : 0;
+		addrinfo* addresses = nullptr;
+		if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0)
+		{
+			LOG_F(ERROR, "Could not resolve TCP endpoint %s.", address.c_str());
+			return NATIVE_INVALID_SOCKET;
+		}
+
+		auto result = NATIVE_INVALID_SOCKET;
+		const auto connectDeadline = std::chrono::steady_clock::now() + connectTimeout;
+		for (auto current = addresses; current != nullptr; current = current->ai_next)
+		{
+			const auto candidate = socket(current->ai_family, current->ai_socktype, current->ai_protocol);
+			if (candidate == NATIVE_INVALID_SOCKET)
+				continue;
+
+			const int enabled = 1;
+			auto succeeded = false;
+			if (listen)
+			{
+				setsockopt(candidate, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&enabled), sizeof(enabled));
+				succeeded = bind(candidate, current->ai_addr, static_cast<int>(current->ai_addrlen)) == 0 &&
+					::listen(candidate, SOMAXCONN) == 0;
+			}
+			else
+			{
+				// Every resolved address shares the timeout
+				const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(connectDeadline - std::chrono::steady_clock::now());
+				succeeded = remaining.count() > 0 &&
+					ConnectWithTimeout(candidate, current->ai_addr, static_cast<socklen_t>(current->ai_addrlen), remaining);
+				// Batches are flushed explicitly, there is nothing to gain from Nagle's algorithm
+				if (succeeded)
+					setsockopt(candidate, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&enabled), sizeof(enabled));
+			}
+
+			if (succeeded)
+			{
+				result = candidate;
+				break;
+			}
+			NATIVE_CLOSE_SOCKET(candidate);
+		}
+
+		freeaddrinfo(addresses);
+		return result;
+	}
+
+	NativeSocket CreateUnixSocket(const std::string& path, const bool listen, const std::chrono::milliseconds connectTimeout)
+	{
+#ifdef _WIN32
+		LOG_F(ERROR, "Unix-domain socket endpoints are not supported on this platform.");
+		return NATIVE_INVALID_SOCKET;
+#else
+		sockaddr_un address { };
+		if (path.empty() || path.size() >= sizeof(address.sun_path))
+		{
+			LOG_F(ERROR, "Invalid Unix-domain socket path %s.", path.c_str());
+			return NATIVE_INVALID_SOCKET;
+		}
+
+		address.sun_family = AF_UNIX;
+		std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+		const auto candidate = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (candidate == NATIVE_INVALID_SOCKET)
+			return NATIVE_INVALID_SOCKET;
+
+		const auto addressPointer = reinterpret_cast<const sockaddr*>(&address);
+		auto succeeded = false;
+		if (listen)
+		{
+			unlink(path.c_str());
+			succeeded = bind(candidate, addressPointer, sizeof(address)) == 0 && ::listen(candidate, SOMAXCONN) == 0;
+		}
+		else
+		{
+			succeeded = ConnectWithTimeout(candidate, addressPointer, sizeof(address), connectTimeout);
+		}
+
+		if (!succeeded)
+		{
+			NATIVE_CLOSE_SOCKET(candidate);
+			return NATIVE_INVALID_SOCKET;
+		}
+		return candidate;
+#endif
+	}
+
+	NativeSocket CreateSocket(const std::string& endpoint, const bool listen, const std::chrono::milliseconds connectTimeout = { })
+	{
+		if (!EnsureSocketsInitialized())
+		{
+			LOG_F(ERROR, "Could not initialize socket library.");
+			return NATIVE_INVALID_SOCKET;
+		}
+
+		if (StartsWith(endpoint, TcpScheme))
+			return CreateTcpSocket(endpoint.substr(std::strlen(TcpScheme)), listen, connectTimeout);
+		if (StartsWith(endpoint, UnixScheme))
+			return CreateUnixSocket(endpoint.substr(std::strlen(UnixScheme)), listen, connectTimeout);
+
+		LOG_F(ERROR, "Unsupported socket endpoint %s (expected tcp://host:port or unix:///path).", endpoint.c_str());
+		return NATIVE_INVALID_SOCKET;
+	}
+}
+
+LibIPC::SocketChannel::SocketChannel(const std::intptr_t handle) :
+	_handle(handle)
+{
+}
+
+LibIPC::SocketChannel::~SocketChannel()
+{
+	Close();
+}
+
+LibIPC::SocketChannel::SocketChannel(SocketChannel&& other) noexcept :
+	_handle(std::exchange(other._handle, InvalidHandle))
+{
+}
+
+LibIPC::SocketChannel& LibIPC::SocketChannel::operator=(SocketChannel&& other) noexcept
+{
+	if (this != &other)
+	{
+		Close();
+		_handle = std::exchange(other._handle, InvalidHandle);
+	}
+	return *this;
+}
+
+LibIPC::SocketChannel LibIPC::SocketChannel::Connect(const std::string& endpoint, const UINT timeoutMilliseconds)
+{
+	const auto socket = CreateSocket(endpoint, false, std::chrono::milliseconds(timeoutMilliseconds));
+	return socket == NATIVE_INVALID_SOCKET ? SocketChannel() : SocketChannel(static_cast<std::intptr_t>(socket));
+}
+
+LibIPC::SocketChannel LibIPC::SocketChannel::Listen(const std::string& endpoint)
+{
+	const auto socket = CreateSocket(endpoint, true);
+	return socket == NATIVE_INVALID_SOCKET ? SocketChannel() : SocketChannel(static_cast<std::intptr_t>(socket));
+}
+
+LibIPC::SocketChannel LibIPC::SocketChannel::Accept() const
+{
+	if (!IsValid())
+		return { };
+
+	const auto socket = accept(ToNative(_handle), nullptr, nullptr);
+	return socket == NATIVE_INVALID_SOCKET ? SocketChannel() : SocketChannel(static_cast<std::intptr_t>(socket));
+}
+
+bool LibIPC::SocketChannel::IsValid() const
+{
+	return _handle != InvalidHandle;
+}
+
+INT LibIPC::SocketChannel::GetLocalPort() const
+{
+	sockaddr_storage address { };
+	socklen_t length = sizeof(address);
+	if (!IsValid() || getsockname(ToNative(_handle), reinterpret_cast<sockaddr*>(&address), &length) != 0)
+		return -1;
+
+	if (address.ss_family == AF_INET)
+		return ntohs(reinterpret_cast<const sockaddr_in*>(&address)->sin_port);
+	if (address.ss_family == AF_INET6)
+		return ntohs(reinterpret_cast<const sockaddr_in6*>(&address)->sin6_port);
+	return -1;
+}
+
+bool LibIPC::SocketChannel::SetSendTimeout(const UINT milliseconds) const
+{
+#ifdef _WIN32
+	const DWORD timeout = milliseconds;
+#else
+	timeval timeout { };
+	timeout.tv_sec = static_cast<decltype(timeout.tv_sec)>(milliseconds / 1000);
+	timeout.tv_usec = static_cast<decltype(timeout.tv_usec)>((milliseconds % 1000) * 1000);
+#endif
+	return IsValid() &&
+		setsockopt(ToNative(_handle), SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout)) == 0;
+}
+
+bool LibIPC::SocketChannel::SendAll(const char* data, std::size_t size) const
+{
+#ifdef _WIN32
+	constexpr int flags = 0;
+#else
+	// A disconnected peer must surface as an error, not as SIGPIPE in the profiled process
+	constexpr int flags = MSG_NOSIGNAL;
+#endif
+
+	while (size > 0)
+	{
+		const auto sent = send(ToNative(_handle), data, static_cast<SendSize>(size), flags);
+		if (sent <= 0)
+			return false;
+
+		data += sent;
+		size -= static_cast<std::size_t>(sent);
+	}
+	return true;
+}
+
+bool LibIPC::SocketChannel::ReceiveAll(char* data, std::size_t size) const
+{
+	while (size > 0)
+	{
+		const auto received = recv(ToNative(_handle), data, static_cast<SendSize>(size), 0);
+		if (received <= 0)
+			return false;
+
+		data += received;
+		size -= static_cast<std::size_t>(received);
+	}
+	return true;
+}
+
+void LibIPC::SocketChannel::Close()
+{
+	if (!IsValid())
+		return;
+
+	NATIVE_CLOSE_SOCKET(ToNative(_handle));
+	_handle = InvalidHandle;
+}
@@ -0,0 +1,47 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "cor.h"
+
+namespace LibIPC
+{
+	// Minimal blocking stream socket over TCP ("tcp://host:port") or Unix-domain sockets ("unix:///path")
+	class SocketChannel
+	{
+	public:
+		SocketChannel() = default;
+		~SocketChannel();
+		SocketChannel(const SocketChannel&) = delete;
+		SocketChannel& operator=(const SocketChannel&) = delete;
+		SocketChannel(SocketChannel&& other) noexcept;
+		SocketChannel& operator=(SocketChannel&& other) noexcept;
+
+		// Gives up if the peer does not accept the connection within the timeout
+		[[nodiscard]] static SocketChannel Connect(const std::string& endpoint, UINT timeoutMilliseconds);
+		[[nodiscard]] static SocketChannel Listen(const std::string& endpoint);
+		[[nodiscard]] SocketChannel Accept() const;
+
+		[[nodiscard]] bool IsValid() const;
+		// Port of a listening TCP socket (useful when listening on port 0)
+		[[nodiscard]] INT GetLocalPort() const;
+		bool SetSendTimeout(UINT milliseconds) const;
+
+		// Blocks until all bytes are written, the peer disconnects or the send timeout elapses
+		[[nodiscard]] bool SendAll(const char* data, std::size_t size) const;
+		// Blocks until all bytes are read or the peer disconnects
+		[[nodiscard]] bool ReceiveAll(char* data, std::size_t size) const;
+		void Close();
+
+	private:
+		explicit SocketChannel(std::intptr_t handle);
+
+		static constexpr std::intptr_t InvalidHandle = -1;
+		std::intptr_t _handle { InvalidHandle };
+	};
+}
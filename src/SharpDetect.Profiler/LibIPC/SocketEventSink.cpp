@@ -0,0 +1,141 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstring>
+#include <limits>
+
+#include "../lib/loguru/loguru.hpp"
+#include "../LibProfilerCore/PAL.h"
+
+#include "SocketEventSink.h"
+
+LibIPC::SocketEventSink::SocketEventSink(const std::string& endpoint) :
+	_endpoint(endpoint),
+	_nextSequence(0),
+	_batchFirstSequence(0),
+	_batchRecordCount(0),
+	_droppedRecords(0),
+	_discontinuities(0)
+{
+	// Connecting is left to the first flush, profiler startup must not wait for the receiver
+	_batch.reserve(FrameHeaderSize + FlushThresholdBytes + BatchSlackBytes);
+	_batch.resize(FrameHeaderSize);
+}
+
+LibIPC::SocketEventSink::~SocketEventSink()
+{
+	_droppedRecords += _batchRecordCount;
+	if (_droppedRecords > 0)
+		LOG_F(WARNING, "Event stream to %s dropped %llu records.", _endpoint.c_str(), static_cast<unsigned long long>(_droppedRecords));
+}
+
+void LibIPC::SocketEventSink::Send(std::vector<char>& buffer)
+{
+	constexpr auto maxRecordSize = static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max());
+	const auto size = buffer.size();
+	if (size > maxRecordSize)
+	{
+		LOG_F(ERROR, "Dropping streamed record (%zu bytes): record exceeds the maximum size.", size);
+		_discontinuities.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	if (_batchRecordCount == 0)
+		_batchFirstSequence = _nextSequence;
+
+	const auto sizeField = static_cast<std::int32_t>(size);
+	const auto sizeFieldBytes = reinterpret_cast<const char*>(&sizeField);
+	_batch.insert(_batch.end(), sizeFieldBytes, sizeFieldBytes + RecordHeaderSize);
+	_batch.insert(_batch.end(), buffer.begin(), buffer.end());
+	++_batchRecordCount;
+	++_nextSequence;
+
+	if (_batch.size() >= FrameHeaderSize + FlushThresholdBytes)
+		Flush();
+}
+
+void LibIPC::SocketEventSink::Flush()
+{
+	if (_batchRecordCount == 0)
+		return;
+
+	if (!_channel.IsValid() && !TryConnect())
+	{
+		_droppedRecords += _batchRecordCount;
+		_discontinuities.fetch_add(1, std::memory_order_relaxed);
+		ResetBatch();
+		return;
+	}
+
+	SocketStreamFormat::FrameHeader header { };
+	header.size = static_cast<UINT32>(_batch.size() - FrameHeaderSize);
+	header.recordCount = _batchRecordCount;
+	header.firstSequence = _batchFirstSequence;
+	std::memcpy(_batch.data(), &header, FrameHeaderSize);
+
+	if (!_channel.SendAll(_batch.data(), _batch.size()))
+	{
+		// Receiver is gone or did not drain the stream within the send timeout
+		LOG_F(
+			ERROR,
+			"Dropping streamed batch (%zu bytes, %u records): could not send to %s.",
+			_batch.size(),
+			_batchRecordCount,
+			_endpoint.c_str());
+		_droppedRecords += _batchRecordCount;
+		_discontinuities.fetch_add(1, std::memory_order_relaxed);
+		_channel.Close();
+	}
+
+	ResetBatch();
+}
+
+bool LibIPC::SocketEventSink::TryConnect()
+{
+	const auto now = std::chrono::steady_clock::now();
+	if (_lastConnectAttempt != std::chrono::steady_clock::time_point { } && now - _lastConnectAttempt < ReconnectInterval)
+		return false;
+
+	const auto firstAttempt = _lastConnectAttempt == std::chrono::steady_clock::time_point { };
+	_lastConnectAttempt = now;
+	_channel = SocketChannel::Connect(_endpoint, ConnectTimeoutMilliseconds);
+	if (!_channel.IsValid())
+	{
+		if (firstAttempt)
+			LOG_F(WARNING, "Could not connect event stream to %s, retrying on later flushes.", _endpoint.c_str());
+		return false;
+	}
+
+	_channel.SetSendTimeout(SendTimeoutMilliseconds);
+	SocketStreamFormat::StreamHeader header { };
+	header.magic = SocketStreamFormat::StreamMagic;
+	header.version = SocketStreamFormat::Version;
+	header.pid = static_cast<UINT32>(LibProfiler::PAL_GetCurrentPid());
+	if (!_channel.SendAll(reinterpret_cast<const char*>(&header), sizeof(header)))
+	{
+		_channel.Close();
+		return false;
+	}
+
+	LOG_F(INFO, "Event stream connected to %s.", _endpoint.c_str());
+	_discontinuities.fetch_add(1, std::memory_order_relaxed);
+	return true;
+}
+
+UINT64 LibIPC::SocketEventSink::GetDiscontinuitiesCount() const
+{
+	return _discontinuities.load(std::memory_order_relaxed);
+}
+
+void LibIPC::SocketEventSink::ResetBatch()
+{
+	if (_batch.capacity() > FrameHeaderSize + FlushThresholdBytes + BatchSlackBytes)
+	{
+		std::vector<char> replacement;
+		replacement.reserve(FrameHeaderSize + FlushThresholdBytes + BatchSlackBytes);
+		_batch.swap(replacement);
+	}
+
+	_batch.resize(FrameHeaderSize);
+	_batchRecordCount = 0;
+}
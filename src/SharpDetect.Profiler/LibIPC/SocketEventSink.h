@@ -0,0 +1,66 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cor.h"
+#include "EventSink.h"
+#include "SocketChannel.h"
+#include "SocketStreamFormat.h"
+
+namespace LibIPC
+{
+	// Streams batches of events to a remote receiver over a TCP or Unix-domain socket.
+	// A slow receiver applies backpressure through the socket send window for at most the send timeout,
+	// after which the batch is dropped and the sink reconnects on a later flush.
+	// Connecting starts with the first flush and takes at most ConnectTimeoutMilliseconds.
+	// Until the receiver is reachable, flushed batches are dropped, connecting is retried at most once per ReconnectInterval.
+	// Owners flush before destroying the sink, records that were not flushed are counted as dropped.
+	class SocketEventSink : public IEventSink
+	{
+	public:
+		static constexpr std::size_t RecordHeaderSize = sizeof(std::int32_t);
+		static constexpr std::size_t FrameHeaderSize = sizeof(SocketStreamFormat::FrameHeader);
+		static constexpr std::size_t FlushThresholdBytes = 64 * 1024;
+		static constexpr std::size_t BatchSlackBytes = 4 * 1024;
+		static constexpr UINT SendTimeoutMilliseconds = 5000;
+		static constexpr UINT ConnectTimeoutMilliseconds = 5000;
+		static constexpr auto ReconnectInterval = std::chrono::seconds(1);
+
+		explicit SocketEventSink(const std::string& endpoint);
+		~SocketEventSink() override;
+		SocketEventSink(const SocketEventSink&) = delete;
+		SocketEventSink& operator=(const SocketEventSink&) = delete;
+		SocketEventSink(SocketEventSink&&) = delete;
+		SocketEventSink& operator=(SocketEventSink&&) = delete;
+
+		void Send(std::vector<char>& buffer) override;
+		void Flush() override;
+		[[nodiscard]] UINT64 GetDiscontinuitiesCount() const override;
+
+		[[nodiscard]] UINT64 GetDroppedRecordsCount() const { return _droppedRecords; }
+
+	private:
+		bool TryConnect();
+		void ResetBatch();
+
+		const std::string _endpoint;
+		SocketChannel _channel;
+		std::chrono::steady_clock::time_point _lastConnectAttempt;
+		UINT64 _nextSequence;
+		UINT64 _batchFirstSequence;
+		UINT32 _batchRecordCount;
+		UINT64 _droppedRecords;
+		// Every dropped batch and every (re)connect, the receiver may have missed records
+		std::atomic<UINT64> _discontinuities;
+		// Frame header is reserved in front of the records so that every frame is written with a single send
+		std::vector<char> _batch;
+	};
+}
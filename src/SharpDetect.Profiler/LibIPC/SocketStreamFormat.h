@@ -0,0 +1,26 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "cor.h"
+#include "TraceFileFormat.h"
+
+namespace LibIPC::SocketStreamFormat
+{
+	// Stream: [StreamHeader][FrameHeader][batch]...[FrameHeader][batch]
+	// Frames reuse the batch header of recorded traces, so a received stream can be stored as trace segments
+	constexpr UINT64 StreamMagic = 0x314D525453445300; // "\0SDSTRM1"
+	constexpr UINT32 Version = 1;
+
+	struct StreamHeader
+	{
+		UINT64 magic;
+		UINT32 version;
+		UINT32 pid;
+	};
+
+	using FrameHeader = TraceFileFormat::BatchHeader;
+
+	static_assert(sizeof(StreamHeader) == 16);
+}
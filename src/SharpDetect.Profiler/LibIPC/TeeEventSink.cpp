@@ -0,0 +1,39 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <utility>
+
+#include "TeeEventSink.h"
+
+LibIPC::TeeEventSink::TeeEventSink(
+	std::unique_ptr<IEventSink> primary,
+	std::vector<std::unique_ptr<IEventSink>> secondaries,
+	const std::size_t secondaryBufferMaxBytes) :
+	_primary(std::move(primary))
+{
+	_secondaries.reserve(secondaries.size());
+	for (auto& secondary : secondaries)
+		_secondaries.push_back(std::make_unique<BufferedEventSink>(std::move(secondary), secondaryBufferMaxBytes));
+}
+
+void LibIPC::TeeEventSink::Send(std::vector<char>& buffer)
+{
+	_primary->Send(buffer);
+	for (const auto& secondary : _secondaries)
+		secondary->Send(buffer);
+}
+
+UINT64 LibIPC::TeeEventSink::GetDiscontinuitiesCount() const
+{
+	auto count = _primary->GetDiscontinuitiesCount();
+	for (const auto& secondary : _secondaries)
+		count += secondary->GetDiscontinuitiesCount();
+	return count;
+}
+
+void LibIPC::TeeEventSink::Flush()
+{
+	_primary->Flush();
+	for (const auto& secondary : _secondaries)
+		secondary->Flush();
+}
@@ -0,0 +1,38 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "BufferedEventSink.h"
+#include "EventSink.h"
+
+namespace LibIPC
+{
+	// Forwards every event to a primary sink and to any number of secondary sinks.
+	// Secondary sinks are buffered separately so they never add latency to the primary path.
+	class TeeEventSink : public IEventSink
+	{
+	public:
+		TeeEventSink(
+			std::unique_ptr<IEventSink> primary,
+			std::vector<std::unique_ptr<IEventSink>> secondaries,
+			std::size_t secondaryBufferMaxBytes);
+		~TeeEventSink() override = default;
+		TeeEventSink(const TeeEventSink&) = delete;
+		TeeEventSink& operator=(const TeeEventSink&) = delete;
+		TeeEventSink(TeeEventSink&&) = delete;
+		TeeEventSink& operator=(TeeEventSink&&) = delete;
+
+		void Send(std::vector<char>& buffer) override;
+		void Flush() override;
+		[[nodiscard]] UINT64 GetDiscontinuitiesCount() const override;
+
+	private:
+		std::unique_ptr<IEventSink> _primary;
+		std::vector<std::unique_ptr<BufferedEventSink>> _secondaries;
+	};
+}
@@ -0,0 +1,73 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+
+#include "cor.h"
+
+namespace LibIPC::TraceFileFormat
+{
+	// Segment file: [SegmentHeader][BatchHeader][batch]...[BatchHeader][batch]
+	// Each batch uses the [i32 size][record] framing of batches enqueued by IpqProducer
+	// Index file: [IndexHeader][IndexEntry]... describing all retained sealed segments
+	// Sequence numbers are record ordinals assigned by the sink in emission order
+
+	constexpr UINT64 SegmentMagic = 0x3147455352544453; // "SDTRSEG1"
+	constexpr UINT64 IndexMagic = 0x3158444952544453; // "SDTRIDX1"
+	constexpr UINT32 Version = 1;
+
+	struct SegmentHeader
+	{
+		UINT64 magic;
+		UINT32 version;
+		UINT32 segmentIndex;
+		UINT64 firstSequence;
+		UINT64 recordCount;
+		// Number of bytes following this header that contain batches
+		UINT64 dataSize;
+		UINT64 reserved[3];
+	};
+
+	struct BatchHeader
+	{
+		UINT32 size;
+		UINT32 recordCount;
+		UINT64 firstSequence;
+	};
+
+	struct IndexHeader
+	{
+		UINT64 magic;
+		UINT32 version;
+		UINT32 entryCount;
+	};
+
+	struct IndexEntry
+	{
+		UINT32 segmentIndex;
+		UINT32 reserved;
+		UINT64 firstSequence;
+		UINT64 recordCount;
+		UINT64 segmentSize;
+	};
+
+	static_assert(sizeof(SegmentHeader) == 64);
+	static_assert(sizeof(BatchHeader) == 16);
+	static_assert(sizeof(IndexHeader) == 16);
+	static_assert(sizeof(IndexEntry) == 32);
+
+	inline std::string GetSegmentPath(const std::string& basePath, const UINT32 segmentIndex)
+	{
+		char suffix[16];
+		std::snprintf(suffix, sizeof(suffix), ".%06u.seg", static_cast<unsigned>(segmentIndex));
+		return basePath + suffix;
+	}
+
+	inline std::string GetIndexPath(const std::string& basePath)
+	{
+		return basePath + ".index";
+	}
+}
@@ -0,0 +1,171 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include "../lib/loguru/loguru.hpp"
+
+#include "TraceFileReader.h"
+
+LibIPC::TraceFileReader::TraceFileReader(const std::string& path) :
+	_path(path),
+	_nextSegmentPosition(0),
+	_offset(0),
+	_end(0)
+{
+	ReadIndex();
+	ProbeUnindexedSegments();
+	if (_segments.empty())
+	{
+		LOG_F(ERROR, "No trace file segments found for %s.", _path.c_str());
+		throw std::runtime_error("Could not open trace file.");
+	}
+}
+
+bool LibIPC::TraceFileReader::ReadNextBatch(TraceBatch& batch)
+{
+	while (_offset >= _end)
+	{
+		if (_nextSegmentPosition >= _segments.size())
+			return false;
+		if (!LoadSegment(_nextSegmentPosition++))
+			_offset = _end = 0;
+	}
+
+	TraceFileFormat::BatchHeader header { };
+	if (_end - _offset < sizeof(header))
+	{
+		LOG_F(ERROR, "Truncated batch header in trace segment %zu.", _nextSegmentPosition - 1);
+		_offset = _end;
+		return ReadNextBatch(batch);
+	}
+
+	std::memcpy(&header, _segmentData.data() + _offset, sizeof(header));
+	_offset += sizeof(header);
+	if (_end - _offset < header.size)
+	{
+		LOG_F(ERROR, "Truncated batch in trace segment %zu.", _nextSegmentPosition - 1);
+		_offset = _end;
+		return ReadNextBatch(batch);
+	}
+
+	batch.data = _segmentData.data() + _offset;
+	batch.size = header.size;
+	batch.recordCount = header.recordCount;
+	batch.firstSequence = header.firstSequence;
+	_offset += header.size;
+	return true;
+}
+
+void LibIPC::TraceFileReader::Rewind()
+{
+	_nextSegmentPosition = 0;
+	_offset = 0;
+	_end = 0;
+}
+
+bool LibIPC::TraceFileReader::TryReadRecord(
+	const TraceBatch& batch,
+	std::size_t& offset,
+	const char*& record,
+	std::size_t& size)
+{
+	std::int32_t sizeField = 0;
+	if (batch.size - offset < sizeof(sizeField))
+		return false;
+
+	std::memcpy(&sizeField, batch.data + offset, sizeof(sizeField));
+	if (sizeField < 0 || batch.size - offset - sizeof(sizeField) < static_cast<std::size_t>(sizeField))
+		return false;
+
+	record = batch.data + offset + sizeof(sizeField);
+	size = static_cast<std::size_t>(sizeField);
+	offset += sizeof(sizeField) + size;
+	return true;
+}
+
+void LibIPC::TraceFileReader::ReadIndex()
+{
+	std::ifstream stream(TraceFileFormat::GetIndexPath(_path), std::ios::binary);
+	if (!stream)
+		return;
+
+	TraceFileFormat::IndexHeader header { };
+	if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+		header.magic != TraceFileFormat::IndexMagic ||
+		header.version != TraceFileFormat::Version)
+	{
+		LOG_F(WARNING, "Ignoring unrecognized trace file index for %s.", _path.c_str());
+		return;
+	}
+
+	for (UINT32 i = 0; i < header.entryCount; ++i)
+	{
+		TraceFileFormat::IndexEntry entry { };
+		if (!stream.read(reinterpret_cast<char*>(&entry), sizeof(entry)))
+			break;
+		_segments.push_back(entry);
+	}
+}
+
+void LibIPC::TraceFileReader::ProbeUnindexedSegments()
+{
+	// The live segment is indexed only once sealed
+	auto segmentIndex = _segments.empty() ? 0 : _segments.back().segmentIndex + 1;
+	for (;; ++segmentIndex)
+	{
+		std::ifstream stream(TraceFileFormat::GetSegmentPath(_path, segmentIndex), std::ios::binary);
+		if (!stream)
+			return;
+
+		TraceFileFormat::SegmentHeader header { };
+		if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+			header.magic != TraceFileFormat::SegmentMagic ||
+			header.version != TraceFileFormat::Version)
+			return;
+
+		TraceFileFormat::IndexEntry entry { };
+		entry.segmentIndex = segmentIndex;
+		entry.firstSequence = header.firstSequence;
+		entry.recordCount = header.recordCount;
+		entry.segmentSize = sizeof(header) + header.dataSize;
+		_segments.push_back(entry);
+	}
+}
+
+bool LibIPC::TraceFileReader::LoadSegment(const std::size_t position)
+{
+	const auto& entry = _segments[position];
+	const auto segmentPath = TraceFileFormat::GetSegmentPath(_path, entry.segmentIndex);
+	std::ifstream stream(segmentPath, std::ios::binary);
+	if (!stream)
+	{
+		LOG_F(ERROR, "Could not open trace segment %s.", segmentPath.c_str());
+		return false;
+	}
+
+	_segmentData.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+	TraceFileFormat::SegmentHeader header { };
+	if (_segmentData.size() < sizeof(header))
+	{
+		LOG_F(ERROR, "Trace segment %s is truncated.", segmentPath.c_str());
+		return false;
+	}
+
+	std::memcpy(&header, _segmentData.data(), sizeof(header));
+	if (header.magic != TraceFileFormat::SegmentMagic || header.version != TraceFileFormat::Version)
+	{
+		LOG_F(ERROR, "Trace segment %s has an unrecognized format.", segmentPath.c_str());
+		return false;
+	}
+
+	// Segment header is authoritative: the tail of an unsealed segment is zero-filled
+	_offset = sizeof(header);
+	_end = std::min<std::size_t>(_segmentData.size(), sizeof(header) + header.dataSize);
+	return true;
+}
@@ -0,0 +1,60 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "cor.h"
+#include "TraceFileFormat.h"
+
+namespace LibIPC
+{
+	struct TraceBatch
+	{
+		const char* data;
+		std::size_t size;
+		UINT32 recordCount;
+		UINT64 firstSequence;
+	};
+
+	// Reads batches back from a trace recorded by TraceFileSink.
+	// Segments missing from the index (trace of a crashed process) are discovered by probing.
+	class TraceFileReader
+	{
+	public:
+		explicit TraceFileReader(const std::string& path);
+		~TraceFileReader() = default;
+		TraceFileReader(const TraceFileReader&) = delete;
+		TraceFileReader& operator=(const TraceFileReader&) = delete;
+		TraceFileReader(TraceFileReader&&) = delete;
+		TraceFileReader& operator=(TraceFileReader&&) = delete;
+
+		// Returned batch stays valid until the next call
+		[[nodiscard]] bool ReadNextBatch(TraceBatch& batch);
+		void Rewind();
+
+		[[nodiscard]] const std::vector<TraceFileFormat::IndexEntry>& GetSegments() const { return _segments; }
+
+		// Iterates [i32 size][record] entries of a batch
+		[[nodiscard]] static bool TryReadRecord(
+			const TraceBatch& batch,
+			std::size_t& offset,
+			const char*& record,
+			std::size_t& size);
+
+	private:
+		void ReadIndex();
+		void ProbeUnindexedSegments();
+		[[nodiscard]] bool LoadSegment(std::size_t position);
+
+		const std::string _path;
+		std::vector<TraceFileFormat::IndexEntry> _segments;
+		std::size_t _nextSegmentPosition;
+		std::vector<char> _segmentData;
+		std::size_t _offset;
+		std::size_t _end;
+	};
+}
@@ -0,0 +1,236 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+
+#include "../lib/loguru/loguru.hpp"
+
+#include "TraceFileSink.h"
+
+LibIPC::TraceFileSink::TraceFileSink(
+	const std::string& path,
+	const UINT64 segmentSize,
+	const UINT64 maxSize) :
+	_path(path),
+	_segmentSize(std::max<UINT64>(segmentSize, sizeof(TraceFileFormat::SegmentHeader) + FlushThresholdBytes + BatchSlackBytes)),
+	_maxSize(maxSize),
+	_segmentHeader(nullptr),
+	_segmentOffset(0),
+	_nextSegmentIndex(0),
+	_nextSequence(0),
+	_batchFirstSequence(0),
+	_batchRecordCount(0),
+	_sealedSize(0),
+	_discontinuities(0)
+{
+	if (!OpenSegment(0))
+	{
+		LOG_F(FATAL, "Could not create trace file segment %s.", TraceFileFormat::GetSegmentPath(_path, 0).c_str());
+		throw std::runtime_error("Could not create trace file.");
+	}
+
+	_batch.reserve(FlushThresholdBytes + BatchSlackBytes);
+}
+
+LibIPC::TraceFileSink::~TraceFileSink()
+{
+	Flush();
+	SealSegment();
+	EnforceMaxSize(0);
+	WriteIndex();
+}
+
+void LibIPC::TraceFileSink::Send(std::vector<char>& buffer)
+{
+	constexpr auto maxRecordSize = static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max());
+	const auto size = buffer.size();
+	if (size > maxRecordSize)
+	{
+		LOG_F(ERROR, "Dropping trace record (%zu bytes): record exceeds the maximum size.", size);
+		_discontinuities.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	if (_batch.empty())
+		_batchFirstSequence = _nextSequence;
+
+	const auto sizeField = static_cast<std::int32_t>(size);
+	const auto sizeFieldBytes = reinterpret_cast<const char*>(&sizeField);
+	_batch.insert(_batch.end(), sizeFieldBytes, sizeFieldBytes + RecordHeaderSize);
+	_batch.insert(_batch.end(), buffer.begin(), buffer.end());
+	++_batchRecordCount;
+	++_nextSequence;
+
+	if (_batch.size() >= FlushThresholdBytes)
+		Flush();
+}
+
+void LibIPC::TraceFileSink::Flush()
+{
+	if (_batch.empty())
+		return;
+
+	const auto frameSize = sizeof(TraceFileFormat::BatchHeader) + _batch.size();
+	if (_segment.data == nullptr || _segmentOffset + frameSize > _segment.size)
+	{
+		// Rotate to a fresh segment; an oversized batch gets a segment sized to fit
+		SealSegment();
+		EnforceMaxSize(std::max<UINT64>(_segmentSize, sizeof(TraceFileFormat::SegmentHeader) + frameSize));
+		WriteIndex();
+		if (!OpenSegment(frameSize))
+		{
+			LOG_F(
+				ERROR,
+				"Dropping trace batch (%zu bytes, %u records): could not create segment %s.",
+				_batch.size(),
+				_batchRecordCount,
+				TraceFileFormat::GetSegmentPath(_path, _nextSegmentIndex).c_str());
+			_batch.clear();
+			_batchRecordCount = 0;
+			_discontinuities.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+	}
+
+	TraceFileFormat::BatchHeader batchHeader { };
+	batchHeader.size = static_cast<UINT32>(_batch.size());
+	batchHeader.recordCount = _batchRecordCount;
+	batchHeader.firstSequence = _batchFirstSequence;
+	std::memcpy(_segment.data + _segmentOffset, &batchHeader, sizeof(batchHeader));
+	std::memcpy(_segment.data + _segmentOffset + sizeof(batchHeader), _batch.data(), _batch.size());
+	_segmentOffset += frameSize;
+
+	// Header is updated after the payload so that a crashed process leaves a consistent segment behind
+	if (_segmentHeader->recordCount == 0)
+		_segmentHeader->firstSequence = _batchFirstSequence;
+	_segmentHeader->recordCount += _batchRecordCount;
+	_segmentHeader->dataSize += frameSize;
+	_batchRecordCount = 0;
+
+	if (_batch.capacity() > FlushThresholdBytes + BatchSlackBytes)
+	{
+		std::vector<char> replacement;
+		replacement.reserve(FlushThresholdBytes + BatchSlackBytes);
+		_batch.swap(replacement);
+	}
+	else
+	{
+		_batch.clear();
+	}
+}
+
+UINT64 LibIPC::TraceFileSink::GetDiscontinuitiesCount() const
+{
+	return _discontinuities.load(std::memory_order_relaxed);
+}
+
+bool LibIPC::TraceFileSink::OpenSegment(const std::size_t minimumCapacity)
+{
+	const auto capacity = std::max<std::size_t>(
+		static_cast<std::size_t>(_segmentSize),
+		sizeof(TraceFileFormat::SegmentHeader) + minimumCapacity);
+	const auto segmentPath = TraceFileFormat::GetSegmentPath(_path, _nextSegmentIndex);
+	if (!LibProfiler::PAL_CreateMappedFile(segmentPath, capacity, _segment))
+		return false;
+
+	_segmentHeader = reinterpret_cast<TraceFileFormat::SegmentHeader*>(_segment.data);
+	*_segmentHeader = TraceFileFormat::SegmentHeader { };
+	_segmentHeader->magic = TraceFileFormat::SegmentMagic;
+	_segmentHeader->version = TraceFileFormat::Version;
+	_segmentHeader->segmentIndex = _nextSegmentIndex;
+	_segmentHeader->firstSequence = _nextSequence;
+	_segmentOffset = sizeof(TraceFileFormat::SegmentHeader);
+	++_nextSegmentIndex;
+	_discontinuities.fetch_add(1, std::memory_order_relaxed);
+	return true;
+}
+
+void LibIPC::TraceFileSink::SealSegment()
+{
+	if (_segment.data == nullptr)
+		return;
+
+	const auto segmentIndex = _segmentHeader->segmentIndex;
+	const auto segmentPath = TraceFileFormat::GetSegmentPath(_path, segmentIndex);
+	if (_segmentHeader->recordCount == 0)
+	{
+		// Nothing was written into this segment, its index can be reused
+		LibProfiler::PAL_CloseMappedFile(_segment, 0);
+		std::error_code error;
+		std::filesystem::remove(segmentPath, error);
+		_segmentHeader = nullptr;
+		_nextSegmentIndex = segmentIndex;
+		return;
+	}
+
+	TraceFileFormat::IndexEntry entry { };
+	entry.segmentIndex = segmentIndex;
+	entry.firstSequence = _segmentHeader->firstSequence;
+	entry.recordCount = _segmentHeader->recordCount;
+	entry.segmentSize = _segmentOffset;
+	_segmentHeader = nullptr;
+
+	if (!LibProfiler::PAL_CloseMappedFile(_segment, _segmentOffset))
+		LOG_F(WARNING, "Could not trim trace file segment %s.", segmentPath.c_str());
+
+	_sealedSegments.push_back(entry);
+	_sealedSize += entry.segmentSize;
+}
+
+void LibIPC::TraceFileSink::EnforceMaxSize(const UINT64 reservedSize)
+{
+	if (_maxSize == 0)
+		return;
+
+	while (!_sealedSegments.empty() && _sealedSize + reservedSize > _maxSize)
+	{
+		const auto& oldest = _sealedSegments.front();
+		const auto segmentPath = TraceFileFormat::GetSegmentPath(_path, oldest.segmentIndex);
+		std::error_code error;
+		if (!std::filesystem::remove(segmentPath, error))
+			LOG_F(WARNING, "Could not remove trace file segment %s.", segmentPath.c_str());
+
+		LOG_F(
+			INFO,
+			"Trace file reached its size limit; dropped segment %u with records [%llu, %llu).",
+			oldest.segmentIndex,
+			static_cast<unsigned long long>(oldest.firstSequence),
+			static_cast<unsigned long long>(oldest.firstSequence + oldest.recordCount));
+		_sealedSize -= oldest.segmentSize;
+		_sealedSegments.pop_front();
+	}
+}
+
+void LibIPC::TraceFileSink::WriteIndex() const
+{
+	const auto indexPath = TraceFileFormat::GetIndexPath(_path);
+	const auto temporaryPath = indexPath + ".tmp";
+	{
+		std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+		if (!stream)
+		{
+			LOG_F(ERROR, "Could not write trace file index %s.", temporaryPath.c_str());
+			return;
+		}
+
+		TraceFileFormat::IndexHeader header { };
+		header.magic = TraceFileFormat::IndexMagic;
+		header.version = TraceFileFormat::Version;
+		header.entryCount = static_cast<UINT32>(_sealedSegments.size());
+		stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		for (const auto& entry : _sealedSegments)
+			stream.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+	}
+
+	// Readers either see the previous or the new index, never a partially written one
+	std::error_code error;
+	std::filesystem::rename(temporaryPath, indexPath, error);
+	if (error)
+		LOG_F(ERROR, "Could not replace trace file index %s: %s.", indexPath.c_str(), error.message().c_str());
+}
@@ -0,0 +1,67 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "cor.h"
+#include "../LibProfilerCore/PAL.h"
+#include "EventSink.h"
+#include "TraceFileFormat.h"
+
+namespace LibIPC
+{
+	// Records events into a series of memory-mapped segment files for offline analysis.
+	// Oldest sealed segments are deleted once the trace would exceed the maximum size.
+	class TraceFileSink : public IEventSink
+	{
+	public:
+		static constexpr std::size_t RecordHeaderSize = sizeof(std::int32_t);
+		static constexpr std::size_t FlushThresholdBytes = 64 * 1024;
+		static constexpr std::size_t BatchSlackBytes = 4 * 1024;
+
+		TraceFileSink(
+			const std::string& path,
+			UINT64 segmentSize,
+			UINT64 maxSize);
+		~TraceFileSink() override;
+		TraceFileSink(const TraceFileSink&) = delete;
+		TraceFileSink& operator=(const TraceFileSink&) = delete;
+		TraceFileSink(TraceFileSink&&) = delete;
+		TraceFileSink& operator=(TraceFileSink&&) = delete;
+
+		void Send(std::vector<char>& buffer) override;
+		void Flush() override;
+		// Every new segment counts, older segments may be evicted before the trace is read
+		[[nodiscard]] UINT64 GetDiscontinuitiesCount() const override;
+
+		[[nodiscard]] UINT64 GetRecordCount() const { return _nextSequence; }
+
+	private:
+		bool OpenSegment(std::size_t minimumCapacity);
+		void SealSegment();
+		void EnforceMaxSize(UINT64 reservedSize);
+		void WriteIndex() const;
+
+		const std::string _path;
+		const UINT64 _segmentSize;
+		const UINT64 _maxSize;
+		LibProfiler::PAL_MappedFile _segment;
+		TraceFileFormat::SegmentHeader* _segmentHeader;
+		std::size_t _segmentOffset;
+		UINT32 _nextSegmentIndex;
+		UINT64 _nextSequence;
+		UINT64 _batchFirstSequence;
+		UINT32 _batchRecordCount;
+		UINT64 _sealedSize;
+		std::deque<TraceFileFormat::IndexEntry> _sealedSegments;
+		std::vector<char> _batch;
+		std::atomic<UINT64> _discontinuities;
+	};
+}
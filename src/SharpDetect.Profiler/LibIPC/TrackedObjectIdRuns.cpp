@@ -0,0 +1,88 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <limits>
+
+#include "TrackedObjectIdRuns.h"
+
+namespace
+{
+	constexpr std::size_t MaxVarintSize = 10;
+
+	void AppendVarint(std::vector<BYTE>& buffer, UINT64 value)
+	{
+		while (value >= 0x80)
+		{
+			buffer.push_back(static_cast<BYTE>(value | 0x80));
+			value >>= 7;
+		}
+		buffer.push_back(static_cast<BYTE>(value));
+	}
+
+	bool ReadVarint(std::span<const BYTE>& payload, UINT64& value)
+	{
+		value = 0;
+		for (std::size_t index = 0; index < payload.size() && index < MaxVarintSize; index++)
+		{
+			const auto current = payload[index];
+			value |= static_cast<UINT64>(current & 0x7F) << (7 * index);
+			if ((current & 0x80) == 0)
+			{
+				payload = payload.subspan(index + 1);
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+void LibIPC::TrackedObjectIdRuns::Encode(const std::span<const UINT64> sortedIds, std::vector<BYTE>& buffer)
+{
+	buffer.clear();
+	AppendVarint(buffer, sortedIds.size());
+
+	UINT64 previousEnd = 0;
+	for (std::size_t begin = 0; begin < sortedIds.size();)
+	{
+		auto end = begin + 1;
+		while (end < sortedIds.size() && sortedIds[end] == sortedIds[end - 1] + 1)
+			end++;
+
+		AppendVarint(buffer, sortedIds[begin] - previousEnd);
+		AppendVarint(buffer, end - begin - 1);
+		previousEnd = sortedIds[end - 1] + 1;
+		begin = end;
+	}
+}
+
+bool LibIPC::TrackedObjectIdRuns::Decode(std::span<const BYTE> payload, std::vector<UINT64>& ids)
+{
+	ids.clear();
+	UINT64 count;
+	if (!ReadVarint(payload, count))
+		return false;
+
+	// Every run takes at least two bytes, do not trust the count for the allocation
+	ids.reserve(static_cast<std::size_t>(std::min<UINT64>(count, payload.size() / 2 * 128)));
+	UINT64 previousEnd = 0;
+	while (!payload.empty())
+	{
+		UINT64 gap;
+		UINT64 runLength;
+		if (!ReadVarint(payload, gap) || !ReadVarint(payload, runLength) || runLength >= count - ids.size())
+			return false;
+
+		// Runs must not wrap around the id space
+		constexpr auto maxId = std::numeric_limits<UINT64>::max();
+		if (gap > maxId - previousEnd || runLength > maxId - previousEnd - gap)
+			return false;
+
+		const auto begin = previousEnd + gap;
+		for (UINT64 offset = 0; offset <= runLength; offset++)
+			ids.push_back(begin + offset);
+		previousEnd = begin + runLength + 1;
+	}
+
+	return ids.size() == count;
+}
@@ -0,0 +1,24 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "cor.h"
+
+namespace LibIPC
+{
+	// Compact encoding of sets of tracked object ids, which are dense integers assigned in ascending order
+	// [varint idsCount] followed by [varint gap][varint runLength - 1] for every run of consecutive ids
+	// The gap of a run is its distance from the end of the previous run (from 0 for the first run)
+	// Varints are unsigned LEB128
+	namespace TrackedObjectIdRuns
+	{
+		// The ids must be sorted in ascending order without duplicates
+		void Encode(std::span<const UINT64> sortedIds, std::vector<BYTE>& buffer);
+		// Returns false (and leaves the ids in unspecified state) if the payload is malformed
+		[[nodiscard]] bool Decode(std::span<const BYTE> payload, std::vector<UINT64>& ids);
+	}
+}
@@ -0,0 +1,226 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+
+#include "FunctionInfoCache.h"
+#include "MockCorProfilerInfo.h"
+
+using Benchmark::MockCorProfilerInfo;
+using LibProfiler::FunctionInfoCache;
+
+namespace
+{
+	// Enough functions to replace the initial table a few times
+	constexpr std::size_t FunctionsCount = 5000;
+
+	struct FunctionInfo
+	{
+		ModuleID moduleId;
+		mdMethodDef methodToken;
+
+		bool operator==(const FunctionInfo&) const = default;
+	};
+
+	std::vector<FunctionInfo> GetExpectedInfos(MockCorProfilerInfo& corProfilerInfo, const std::size_t count)
+	{
+		std::vector<FunctionInfo> infos(count);
+		for (std::size_t index = 0; index < count; ++index)
+		{
+			auto& [moduleId, methodToken] = infos[index];
+			REQUIRE(SUCCEEDED(corProfilerInfo.GetFunctionInfo(MockCorProfilerInfo::GetFunctionId(index), nullptr, &moduleId, &methodToken)));
+		}
+		return infos;
+	}
+
+	FunctionInfo Resolve(FunctionInfoCache& cache, MockCorProfilerInfo& corProfilerInfo, const std::size_t index)
+	{
+		FunctionInfo info { };
+		CHECK(SUCCEEDED(cache.GetFunctionInfo(&corProfilerInfo, MockCorProfilerInfo::GetFunctionId(index), info.moduleId, info.methodToken)));
+		return info;
+	}
+}
+
+TEST_CASE("FunctionInfoCache: Resolved functions are served from the cache")
+{
+	MockCorProfilerInfo corProfilerInfo(FunctionsCount);
+	const auto expected = GetExpectedInfos(corProfilerInfo, 64);
+	const auto callsBefore = corProfilerInfo.GetFunctionInfoCalls();
+	FunctionInfoCache cache;
+
+	const FunctionInfoCache::ReadScope scope(&cache);
+	for (std::size_t index = 0; index < expected.size(); ++index)
+		CHECK(Resolve(cache, corProfilerInfo, index) == expected[index]);
+	CHECK(corProfilerInfo.GetFunctionInfoCalls() - callsBefore == expected.size());
+
+	for (std::size_t index = 0; index < expected.size(); ++index)
+		CHECK(Resolve(cache, corProfilerInfo, index) == expected[index]);
+	CHECK(corProfilerInfo.GetFunctionInfoCalls() - callsBefore == expected.size());
+	CHECK(cache.GetCount() == expected.size());
+}
+
+TEST_CASE("FunctionInfoCache: Failed lookups are not cached")
+{
+	MockCorProfilerInfo corProfilerInfo(0);
+	FunctionInfoCache cache;
+	ModuleID moduleId;
+	mdMethodDef methodToken;
+
+	const FunctionInfoCache::ReadScope scope(&cache);
+	CHECK(FAILED(cache.GetFunctionInfo(&corProfilerInfo, MockCorProfilerInfo::GetFunctionId(0), moduleId, methodToken)));
+	CHECK(FAILED(cache.GetFunctionInfo(&corProfilerInfo, MockCorProfilerInfo::GetFunctionId(0), moduleId, methodToken)));
+	CHECK(corProfilerInfo.GetFunctionInfoCalls() == 2);
+	CHECK(cache.GetCount() == 0);
+}
+
+TEST_CASE("FunctionInfoCache: Growing keeps every entry and frees replaced tables after the scope")
+{
+	MockCorProfilerInfo corProfilerInfo(FunctionsCount);
+	const auto expected = GetExpectedInfos(corProfilerInfo, FunctionsCount);
+	FunctionInfoCache cache;
+
+	{
+		const FunctionInfoCache::ReadScope scope(&cache);
+		for (std::size_t index = 0; index < FunctionsCount; ++index)
+			static_cast<void>(Resolve(cache, corProfilerInfo, index));
+
+		// The scope may still be probing any of them
+		CHECK(cache.GetRetiredTablesCount() > 0);
+	}
+	CHECK(cache.GetRetiredTablesCount() == 0);
+	CHECK(cache.GetCount() == FunctionsCount);
+
+	const auto callsBefore = corProfilerInfo.GetFunctionInfoCalls();
+	const FunctionInfoCache::ReadScope scope(&cache);
+	for (std::size_t index = 0; index < FunctionsCount; ++index)
+		CHECK(Resolve(cache, corProfilerInfo, index) == expected[index]);
+	CHECK(corProfilerInfo.GetFunctionInfoCalls() == callsBefore);
+}
+
+TEST_CASE("FunctionInfoCache: Invalidated functions are resolved by the runtime again")
+{
+	constexpr std::size_t count = 1024;
+	MockCorProfilerInfo corProfilerInfo(FunctionsCount);
+	const auto expected = GetExpectedInfos(corProfilerInfo, count);
+	FunctionInfoCache cache;
+	{
+		const FunctionInfoCache::ReadScope scope(&cache);
+		for (std::size_t index = 0; index < count; ++index)
+			static_cast<void>(Resolve(cache, corProfilerInfo, index));
+	}
+
+	// The first module holds the functions before the first one of the second module
+	const auto unloadedModuleId = expected.front().moduleId;
+	std::size_t unloadedCount = 0;
+	while (expected[unloadedCount].moduleId == unloadedModuleId)
+		unloadedCount++;
+	REQUIRE(unloadedCount < count - 1);
+	cache.InvalidateModule(unloadedModuleId);
+	cache.InvalidateFunction(MockCorProfilerInfo::GetFunctionId(count - 1));
+	CHECK(cache.GetCount() == count - unloadedCount - 1);
+
+	const auto callsBefore = corProfilerInfo.GetFunctionInfoCalls();
+	const FunctionInfoCache::ReadScope scope(&cache);
+	for (std::size_t index = 0; index < count; ++index)
+		CHECK(Resolve(cache, corProfilerInfo, index) == expected[index]);
+	CHECK(corProfilerInfo.GetFunctionInfoCalls() - callsBefore == unloadedCount + 1);
+	CHECK(cache.GetCount() == count);
+}
+
+TEST_CASE("FunctionInfoCache: Replaced tables outlive read scopes of other threads")
+{
+	MockCorProfilerInfo corProfilerInfo(FunctionsCount);
+	FunctionInfoCache cache;
+	std::mutex mutex;
+	std::condition_variable changed;
+	bool entered = false;
+	bool release = false;
+
+	std::thread reader([&]()
+	{
+		const FunctionInfoCache::ReadScope scope(&cache);
+		std::unique_lock lock(mutex);
+		entered = true;
+		changed.notify_all();
+		changed.wait(lock, [&]() { return release; });
+	});
+
+	{
+		std::unique_lock lock(mutex);
+		changed.wait(lock, [&]() { return entered; });
+	}
+
+	{
+		const FunctionInfoCache::ReadScope scope(&cache);
+		for (std::size_t index = 0; index < FunctionsCount; ++index)
+			static_cast<void>(Resolve(cache, corProfilerInfo, index));
+	}
+	CHECK(cache.GetRetiredTablesCount() > 0);
+
+	{
+		std::lock_guard lock(mutex);
+		release = true;
+	}
+	changed.notify_all();
+	reader.join();
+	// The last scope to leave frees them
+	CHECK(cache.GetRetiredTablesCount() == 0);
+}
+
+TEST_CASE("FunctionInfoCache: Lookups stay correct while the table is replaced")
+{
+	constexpr std::size_t readersCount = 3;
+	MockCorProfilerInfo corProfilerInfo(FunctionsCount);
+	const auto expected = GetExpectedInfos(corProfilerInfo, FunctionsCount);
+	FunctionInfoCache cache;
+	std::atomic<bool> stop = false;
+	std::atomic<std::size_t> mismatches = 0;
+
+	std::vector<std::thread> readers;
+	for (std::size_t reader = 0; reader < readersCount; reader++)
+	{
+		readers.emplace_back([&, reader]()
+		{
+			for (std::size_t walk = reader; !stop.load(std::memory_order_relaxed); walk++)
+			{
+				// Every walk is a scope of its own, as for stack walks
+				const FunctionInfoCache::ReadScope scope(&cache);
+				for (std::size_t frame = 0; frame < 32; frame++)
+				{
+					const auto index = (walk * 31 + frame * 97) % FunctionsCount;
+					FunctionInfo info { };
+					const auto hr = cache.GetFunctionInfo(&corProfilerInfo, MockCorProfilerInfo::GetFunctionId(index), info.moduleId, info.methodToken);
+					if (FAILED(hr) || !(info == expected[index]))
+						mismatches.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+		});
+	}
+
+	for (std::size_t index = 0; index < FunctionsCount; index++)
+	{
+		{
+			const FunctionInfoCache::ReadScope scope(&cache);
+			static_cast<void>(Resolve(cache, corProfilerInfo, index));
+		}
+		if (index % 3 == 0)
+			cache.InvalidateFunction(MockCorProfilerInfo::GetFunctionId(index));
+	}
+
+	stop = true;
+	for (auto& reader : readers)
+		reader.join();
+
+	CHECK(mismatches.load() == 0);
+	{
+		// The first scope without concurrent readers frees what they kept alive
+		const FunctionInfoCache::ReadScope scope(&cache);
+	}
+	CHECK(cache.GetRetiredTablesCount() == 0);
+}
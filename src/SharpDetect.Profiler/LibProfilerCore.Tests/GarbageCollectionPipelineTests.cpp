@@ -0,0 +1,140 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+#include "doctest.h"
+
+#include "GarbageCollectionPipeline.h"
+#include "ObjectsTracker.h"
+
+using LibProfiler::GarbageCollectionPipeline;
+using LibProfiler::ObjectsTracker;
+using LibProfiler::TrackedObjectId;
+
+namespace
+{
+	constexpr ObjectID HeapStart = 0x100000;
+	constexpr ObjectID RelocatedStart = 0x400000;
+	constexpr SIZE_T ObjectSize = 0x20;
+	constexpr std::size_t ObjectsCount = 16;
+	constexpr std::size_t ChunkSize = 3;
+
+	// Moves the first half of the heap, the rest is collected
+	void ReportCompactingCollection(
+		GarbageCollectionPipeline& pipeline,
+		const ObjectID heapStart = HeapStart,
+		const ObjectID relocatedStart = RelocatedStart,
+		std::vector<ObjectID> finalizationQueuedObjects = { })
+	{
+		constexpr auto size = ObjectsCount * ObjectSize;
+		pipeline.ProcessGarbageCollectionStarted(
+			{ TRUE, FALSE, FALSE, FALSE, FALSE },
+			{ { COR_PRF_GC_GEN_0, heapStart, size, size } });
+
+		std::vector<ObjectID> oldStarts { heapStart };
+		std::vector<ObjectID> newStarts { relocatedStart };
+		std::vector<SIZE_T> lengths { ObjectsCount / 2 * ObjectSize };
+		pipeline.ProcessMovingReferences(oldStarts, newStarts, lengths);
+		pipeline.ProcessGarbageCollectionFinished(std::move(finalizationQueuedObjects));
+	}
+}
+
+TEST_CASE("GarbageCollectionPipeline: Immediate and deferred GCs produce the same ids")
+{
+	for (const auto deferred : { false, true })
+	{
+		ObjectsTracker tracker(0);
+		std::size_t collectedCount = 0;
+		UINT newTrackedObjectsCount = 0;
+		// Callbacks of the GC, in the order they were called
+		std::vector<char> calls;
+		GarbageCollectionPipeline pipeline(tracker, deferred, ChunkSize, {
+			[&](std::vector<TrackedObjectId>&) { calls.push_back('s'); },
+			[&](const std::span<const TrackedObjectId> chunk)
+			{
+				calls.push_back('c');
+				collectedCount += chunk.size();
+			},
+			[&](UINT, const UINT newCount)
+			{
+				calls.push_back('f');
+				newTrackedObjectsCount = newCount;
+			} });
+
+		std::vector<TrackedObjectId> ids;
+		for (std::size_t index = 0; index < ObjectsCount; index++)
+			ids.push_back(tracker.GetTrackedObject(HeapStart + index * ObjectSize));
+
+		ReportCompactingCollection(pipeline);
+
+		// Lookups wait for a deferred GC to be applied
+		for (std::size_t index = 0; index < ObjectsCount / 2; index++)
+			CHECK(tracker.GetTrackedObject(RelocatedStart + index * ObjectSize) == ids[index]);
+
+		pipeline.Flush();
+		const std::vector expectedCalls { 's', 'c', 'c', 'c', 'f' };
+		CHECK(calls == expectedCalls);
+		CHECK(collectedCount == ObjectsCount / 2);
+		CHECK(newTrackedObjectsCount == ObjectsCount / 2);
+		CHECK(tracker.GetTrackedObjectsCount() == ObjectsCount / 2);
+		pipeline.Stop();
+	}
+}
+
+TEST_CASE("GarbageCollectionPipeline: GCs finished after stopping are applied right away")
+{
+	ObjectsTracker tracker(0);
+	std::size_t finishedCount = 0;
+	GarbageCollectionPipeline pipeline(tracker, true, ChunkSize, {
+		[](std::vector<TrackedObjectId>&) { },
+		[](std::span<const TrackedObjectId>) { },
+		[&](UINT, UINT) { finishedCount++; } });
+	const auto id = tracker.GetTrackedObject(HeapStart);
+
+	pipeline.Stop();
+	ReportCompactingCollection(pipeline);
+
+	CHECK(finishedCount == 1);
+	CHECK(tracker.TryGetTrackedObject(RelocatedStart) == id);
+}
+
+TEST_CASE("GarbageCollectionPipeline: Finalization queued objects are translated as they were before their GC")
+{
+	constexpr ObjectID SecondRelocatedStart = 0x700000;
+	constexpr ObjectID UntrackedObject = 0x900000;
+	for (const auto deferred : { false, true })
+	{
+		ObjectsTracker tracker(0);
+		std::vector<std::vector<TrackedObjectId>> finalizationQueued;
+		GarbageCollectionPipeline pipeline(tracker, deferred, ChunkSize, {
+			[&](std::vector<TrackedObjectId>& objects)
+			{
+				std::ranges::sort(objects);
+				finalizationQueued.push_back(objects);
+			},
+			[](std::span<const TrackedObjectId>) { },
+			[](UINT, UINT) { } });
+
+		std::vector<TrackedObjectId> ids;
+		for (std::size_t index = 0; index < ObjectsCount; index++)
+			ids.push_back(tracker.GetTrackedObject(HeapStart + index * ObjectSize));
+
+		// The second GC is reported before the first one is applied, its addresses come from the first one
+		ReportCompactingCollection(pipeline, HeapStart, RelocatedStart,
+			{ HeapStart, HeapStart + (ObjectsCount - 1) * ObjectSize, UntrackedObject });
+		ReportCompactingCollection(pipeline, RelocatedStart, SecondRelocatedStart, { RelocatedStart + ObjectSize });
+		pipeline.Flush();
+
+		// The collected object was still tracked before the first GC, the untracked one is left out
+		const std::vector<TrackedObjectId> firstExpected { ids[0], ids[ObjectsCount - 1] };
+		const std::vector<TrackedObjectId> secondExpected { ids[1] };
+		REQUIRE(finalizationQueued.size() == 2);
+		CHECK(finalizationQueued[0] == firstExpected);
+		CHECK(finalizationQueued[1] == secondExpected);
+		CHECK(tracker.TryGetTrackedObject(SecondRelocatedStart + ObjectSize) == ids[1]);
+		pipeline.Stop();
+	}
+}
@@ -0,0 +1,93 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+
+#include "ObjectIdBuffer.h"
+
+using LibProfiler::ObjectIdBuffer;
+
+namespace
+{
+	// Several segments per thread, segments are 4096 addresses long
+	constexpr std::size_t ThreadsCount = 4;
+	constexpr std::size_t AppendsPerThread = 3 * 4096 + 17;
+
+	ObjectID GetObjectId(const std::size_t round, const std::size_t thread, const std::size_t index)
+	{
+		return static_cast<ObjectID>(((round * ThreadsCount + thread + 1) << 32) | index);
+	}
+
+	// Appends from all threads at once, so that they race for new segments, returns the appended addresses
+	std::vector<ObjectID> AppendConcurrently(ObjectIdBuffer& buffer, const std::size_t round)
+	{
+		std::atomic<std::size_t> ready = 0;
+		std::vector<std::thread> threads;
+		for (std::size_t thread = 0; thread < ThreadsCount; thread++)
+		{
+			threads.emplace_back([&, thread]()
+			{
+				ready.fetch_add(1);
+				while (ready.load() < ThreadsCount)
+					std::this_thread::yield();
+
+				for (std::size_t index = 0; index < AppendsPerThread; index++)
+					buffer.Append(GetObjectId(round, thread, index));
+			});
+		}
+		for (auto& thread : threads)
+			thread.join();
+
+		std::vector<ObjectID> expected;
+		for (std::size_t thread = 0; thread < ThreadsCount; thread++)
+		{
+			for (std::size_t index = 0; index < AppendsPerThread; index++)
+				expected.push_back(GetObjectId(round, thread, index));
+		}
+		return expected;
+	}
+
+	std::vector<ObjectID> DrainSorted(ObjectIdBuffer& buffer)
+	{
+		std::vector<ObjectID> objectIds;
+		buffer.Drain(objectIds);
+		std::ranges::sort(objectIds);
+		return objectIds;
+	}
+}
+
+TEST_CASE("ObjectIdBuffer: Concurrent appends across segments are drained exactly once")
+{
+	ObjectIdBuffer buffer;
+	for (std::size_t round = 0; round < 3; round++)
+	{
+		// Every round stands for a GC, the buffer is reused by the next one
+		auto expected = AppendConcurrently(buffer, round);
+		std::ranges::sort(expected);
+		CHECK(DrainSorted(buffer) == expected);
+		CHECK(DrainSorted(buffer).empty());
+	}
+}
+
+TEST_CASE("ObjectIdBuffer: Drained buffer only holds later appends")
+{
+	ObjectIdBuffer buffer;
+	static_cast<void>(AppendConcurrently(buffer, 0));
+	std::vector<ObjectID> drained;
+	buffer.Drain(drained);
+	CHECK(drained.size() == ThreadsCount * AppendsPerThread);
+
+	// Appends after draining go into the kept segment, nothing from the previous round reappears
+	std::vector<ObjectID> expected;
+	for (std::size_t index = 0; index < 10; index++)
+	{
+		expected.push_back(GetObjectId(1, 0, index));
+		buffer.Append(expected.back());
+	}
+	CHECK(DrainSorted(buffer) == expected);
+}
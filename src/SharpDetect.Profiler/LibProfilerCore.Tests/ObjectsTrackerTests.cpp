@@ -0,0 +1,300 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+
+#include "ObjectsTracker.h"
+
+using LibProfiler::ObjectsTracker;
+using LibProfiler::TrackedObjectId;
+
+namespace
+{
+	constexpr ObjectID Gen0Start = 0x100000;
+	constexpr ObjectID Gen2Start = 0x800000;
+	constexpr ObjectID RelocatedStart = 0x400000;
+	constexpr SIZE_T ObjectSize = 0x20;
+	constexpr std::size_t ObjectsPerGeneration = 64;
+
+	ObjectID Gen0Object(const std::size_t index)
+	{
+		return Gen0Start + index * ObjectSize;
+	}
+
+	ObjectID Gen2Object(const std::size_t index)
+	{
+		return Gen2Start + index * ObjectSize;
+	}
+
+	// Collects generation 0, generations 0 and 2 hold ObjectsPerGeneration objects each
+	void StartGen0Collection(ObjectsTracker& tracker)
+	{
+		constexpr auto size = ObjectsPerGeneration * ObjectSize;
+		std::vector<BOOL> collectedGenerations { TRUE, FALSE, FALSE, FALSE, FALSE };
+		std::vector<COR_PRF_GC_GENERATION_RANGE> bounds {
+			{ COR_PRF_GC_GEN_2, Gen2Start, size, size },
+			{ COR_PRF_GC_GEN_0, Gen0Start, size, size } };
+		tracker.ProcessGarbageCollectionStarted(std::move(collectedGenerations), std::move(bounds));
+	}
+
+	void ReportSurviving(ObjectsTracker& tracker, const ObjectID start, const std::size_t count)
+	{
+		std::vector<ObjectID> starts { start };
+		std::vector<SIZE_T> lengths { count * ObjectSize };
+		tracker.ProcessSurvivingReferences(starts, lengths);
+	}
+
+	void ReportMoving(ObjectsTracker& tracker, const ObjectID oldStart, const ObjectID newStart, const std::size_t count)
+	{
+		std::vector<ObjectID> oldStarts { oldStart };
+		std::vector<ObjectID> newStarts { newStart };
+		std::vector<SIZE_T> lengths { count * ObjectSize };
+		tracker.ProcessMovingReferences(oldStarts, newStarts, lengths);
+	}
+
+	// Finishes the GC, returns identifiers of the collected objects as they were visited
+	std::vector<TrackedObjectId> FinishCollection(ObjectsTracker& tracker)
+	{
+		std::vector<TrackedObjectId> ids;
+		static_cast<void>(tracker.ProcessGarbageCollectionFinished(3, [&](const std::span<const TrackedObjectId> chunk)
+		{
+			ids.insert(ids.end(), chunk.begin(), chunk.end());
+		}));
+		return ids;
+	}
+}
+
+TEST_CASE("ObjectsTracker: Surviving and moved objects keep their ids")
+{
+	ObjectsTracker tracker(0);
+	std::vector<TrackedObjectId> ids;
+	for (std::size_t index = 0; index < 8; index++)
+		ids.push_back(tracker.GetTrackedObject(Gen0Object(index)));
+
+	StartGen0Collection(tracker);
+	ReportSurviving(tracker, Gen0Object(0), 2);
+	ReportMoving(tracker, Gen0Object(4), RelocatedStart, 2);
+	const auto collected = FinishCollection(tracker);
+
+	CHECK(tracker.GetTrackedObjectsCount() == 4);
+	CHECK(tracker.TryGetTrackedObject(Gen0Object(0)) == ids[0]);
+	CHECK(tracker.TryGetTrackedObject(Gen0Object(1)) == ids[1]);
+	CHECK(tracker.TryGetTrackedObject(RelocatedStart) == ids[4]);
+	CHECK(tracker.TryGetTrackedObject(RelocatedStart + ObjectSize) == ids[5]);
+	CHECK(tracker.GetTrackedObject(RelocatedStart + ObjectSize) == ids[5]);
+	// The old addresses of moved objects are no longer tracked
+	CHECK_FALSE(tracker.TryGetTrackedObject(Gen0Object(4)).has_value());
+	CHECK_FALSE(tracker.TryGetTrackedObject(Gen0Object(5)).has_value());
+
+	const std::vector<TrackedObjectId> expectedCollected { ids[2], ids[3], ids[6], ids[7] };
+	CHECK(collected == expectedCollected);
+}
+
+TEST_CASE("ObjectsTracker: Collected addresses get new ids once reused")
+{
+	ObjectsTracker tracker(0);
+	const auto collectedId = tracker.GetTrackedObject(Gen0Object(0));
+
+	StartGen0Collection(tracker);
+	CHECK(FinishCollection(tracker) == std::vector { collectedId });
+	CHECK_FALSE(tracker.TryGetTrackedObject(Gen0Object(0)).has_value());
+	const auto reusedId = tracker.GetTrackedObject(Gen0Object(0));
+	CHECK(reusedId != collectedId);
+	CHECK(tracker.GetTrackedObject(Gen0Object(0)) == reusedId);
+}
+
+TEST_CASE("ObjectsTracker: Objects of uncollected generations are carried over")
+{
+	ObjectsTracker tracker(0);
+	std::vector<TrackedObjectId> gen0Ids;
+	std::vector<TrackedObjectId> gen2Ids;
+	for (std::size_t index = 0; index < 4; index++)
+	{
+		gen0Ids.push_back(tracker.GetTrackedObject(Gen0Object(index)));
+		gen2Ids.push_back(tracker.GetTrackedObject(Gen2Object(index)));
+	}
+
+	// Generation 2 is neither collected nor reported, its objects are kept as they are
+	StartGen0Collection(tracker);
+	ReportSurviving(tracker, Gen0Object(0), 4);
+	CHECK(FinishCollection(tracker).empty());
+	CHECK(tracker.GetTrackedObjectsCount() == 8);
+
+	StartGen0Collection(tracker);
+	CHECK(FinishCollection(tracker) == gen0Ids);
+	CHECK(tracker.GetTrackedObjectsCount() == 4);
+
+	for (std::size_t index = 0; index < 4; index++)
+	{
+		// Cached translations of retained objects survive the GC as well
+		CHECK(tracker.GetTrackedObject(Gen2Object(index)) == gen2Ids[index]);
+		CHECK(tracker.TryGetTrackedObject(Gen2Object(index)) == gen2Ids[index]);
+		CHECK_FALSE(tracker.TryGetTrackedObject(Gen0Object(index)).has_value());
+	}
+}
+
+TEST_CASE("ObjectsTracker: Collected ids are streamed in bounded ascending chunks")
+{
+	constexpr std::size_t chunkSize = 5;
+	ObjectsTracker tracker(0);
+	// Identifiers descend with addresses, every chunk has to be reordered
+	std::vector<TrackedObjectId> ids(ObjectsPerGeneration);
+	for (auto index = ObjectsPerGeneration; index-- > 0;)
+		ids[index] = tracker.GetTrackedObject(Gen0Object(index));
+
+	// Every fourth object survives, the dead ones span many gaps between ranges
+	StartGen0Collection(tracker);
+	std::vector<TrackedObjectId> expectedCollected;
+	for (std::size_t index = 0; index < ObjectsPerGeneration; index++)
+	{
+		if (index % 4 == 0)
+			ReportSurviving(tracker, Gen0Object(index), 1);
+		else
+			expectedCollected.push_back(ids[index]);
+	}
+
+	std::vector<std::vector<TrackedObjectId>> chunks;
+	const auto gcContext = tracker.ProcessGarbageCollectionFinished(chunkSize, [&](const std::span<const TrackedObjectId> chunk)
+	{
+		chunks.emplace_back(chunk.begin(), chunk.end());
+	});
+
+	std::vector<TrackedObjectId> collected;
+	for (const auto& chunk : chunks)
+	{
+		CHECK(!chunk.empty());
+		CHECK(chunk.size() <= chunkSize);
+		CHECK(std::ranges::is_sorted(chunk));
+		collected.insert(collected.end(), chunk.begin(), chunk.end());
+	}
+	CHECK(chunks.size() == (expectedCollected.size() + chunkSize - 1) / chunkSize);
+	CHECK(gcContext.GetCollectedObjectsCount() == expectedCollected.size());
+	std::ranges::sort(collected);
+	std::ranges::sort(expectedCollected);
+	CHECK(collected == expectedCollected);
+	CHECK(tracker.GetTrackedObjectsCount() == ObjectsPerGeneration / 4);
+}
+
+TEST_CASE("ObjectsTracker: Batch translations match single lookups")
+{
+	ObjectsTracker tracker(0);
+	for (std::size_t index = 0; index < ObjectsPerGeneration; index++)
+		static_cast<void>(tracker.GetTrackedObject(Gen0Object(index)));
+
+	// Survivors end up in the snapshot, objects allocated afterwards in the allocation shards
+	StartGen0Collection(tracker);
+	ReportSurviving(tracker, Gen0Object(0), ObjectsPerGeneration / 2);
+	static_cast<void>(tracker.ProcessGarbageCollectionFinished());
+	for (std::size_t index = 0; index < ObjectsPerGeneration; index++)
+		static_cast<void>(tracker.GetTrackedObject(Gen2Object(index)));
+
+	std::vector<ObjectID> objectIds { 0 };
+	for (std::size_t index = 0; index < ObjectsPerGeneration; index++)
+	{
+		objectIds.push_back(Gen2Object(ObjectsPerGeneration - index - 1));
+		objectIds.push_back(Gen0Object(index));
+	}
+
+	std::vector<TrackedObjectId> expectedTracked;
+	for (const auto objectId : objectIds)
+	{
+		if (const auto trackedObjectId = tracker.TryGetTrackedObject(objectId))
+			expectedTracked.push_back(trackedObjectId.value());
+	}
+	std::vector<TrackedObjectId> tracked;
+	tracker.TryTranslateMany(objectIds, tracked);
+	std::ranges::sort(tracked);
+	std::ranges::sort(expectedTracked);
+	CHECK(tracked.size() == ObjectsPerGeneration + ObjectsPerGeneration / 2);
+	CHECK(tracked == expectedTracked);
+
+	// Untracked objects get their ids assigned by the batch, single lookups see the same ones
+	std::vector<TrackedObjectId> translated(objectIds.size());
+	tracker.TranslateMany(objectIds, translated);
+	CHECK(translated[0] == 0);
+	for (std::size_t index = 1; index < objectIds.size(); index++)
+		CHECK(tracker.GetTrackedObject(objectIds[index]) == translated[index]);
+
+	std::thread([&]()
+	{
+		// Lookups of another thread do not go through the cache filled above
+		for (std::size_t index = 1; index < objectIds.size(); index++)
+			CHECK(tracker.GetTrackedObject(objectIds[index]) == translated[index]);
+	}).join();
+}
+
+TEST_CASE("ObjectsTracker: Lookups stay correct while snapshots are published")
+{
+	constexpr std::size_t collectionsCount = 200;
+	constexpr std::size_t readersCount = 3;
+
+	ObjectsTracker tracker(0);
+	std::vector<ObjectID> objectIds;
+	std::vector<TrackedObjectId> expected;
+	for (std::size_t index = 0; index < ObjectsPerGeneration; index++)
+	{
+		objectIds.push_back(Gen0Object(index));
+		objectIds.push_back(Gen2Object(index));
+	}
+	for (const auto objectId : objectIds)
+		expected.push_back(tracker.GetTrackedObject(objectId));
+
+	std::atomic<bool> stop = false;
+	std::atomic<std::size_t> mismatches = 0;
+	std::atomic<std::size_t> lookups = 0;
+	std::vector<std::thread> readers;
+	for (std::size_t reader = 0; reader < readersCount; reader++)
+	{
+		readers.emplace_back([&, reader]()
+		{
+			std::vector<TrackedObjectId> translated(objectIds.size());
+			std::vector<TrackedObjectId> tracked;
+			for (std::size_t iteration = reader; !stop.load(std::memory_order_relaxed); iteration++)
+			{
+				const auto index = iteration % objectIds.size();
+				if (tracker.GetTrackedObject(objectIds[index]) != expected[index])
+					mismatches.fetch_add(1, std::memory_order_relaxed);
+				if (tracker.TryGetTrackedObject(objectIds[index]) != expected[index])
+					mismatches.fetch_add(1, std::memory_order_relaxed);
+
+				if (index == 0)
+				{
+					tracker.TranslateMany(objectIds, translated);
+					if (translated != expected)
+						mismatches.fetch_add(1, std::memory_order_relaxed);
+
+					tracked.clear();
+					tracker.TryTranslateMany(objectIds, tracked);
+					if (tracked.size() != objectIds.size())
+						mismatches.fetch_add(1, std::memory_order_relaxed);
+				}
+				lookups.fetch_add(1, std::memory_order_relaxed);
+			}
+		});
+	}
+
+	// Every object survives in place, so their ids must never change
+	for (std::size_t collection = 0; collection < collectionsCount; collection++)
+	{
+		StartGen0Collection(tracker);
+		ReportSurviving(tracker, Gen0Start, ObjectsPerGeneration);
+		if (!FinishCollection(tracker).empty())
+			mismatches.fetch_add(1, std::memory_order_relaxed);
+		std::this_thread::yield();
+	}
+
+	stop = true;
+	for (auto& reader : readers)
+		reader.join();
+
+	CHECK(lookups.load() > 0);
+	CHECK(mismatches.load() == 0);
+	CHECK(tracker.GetTrackedObjectsCount() == objectIds.size());
+}
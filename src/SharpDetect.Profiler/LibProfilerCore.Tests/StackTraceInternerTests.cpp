@@ -0,0 +1,125 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+
+#include "StackTraceInterner.h"
+
+using LibProfiler::StackTraceInterner;
+
+namespace
+{
+	// Enough stacks to land in every shard
+	constexpr std::size_t StacksCount = 1024;
+	constexpr std::size_t ThreadsCount = 4;
+
+	// Frames blob of a stack, stacks differ in their depth and in their frames
+	std::vector<BYTE> GetFrames(const std::size_t stack)
+	{
+		std::vector<UINT64> frames(stack % 7 + 1);
+		for (std::size_t frame = 0; frame < frames.size(); frame++)
+			frames[frame] = stack * 0x10000 + frame;
+
+		std::vector<BYTE> blob(frames.size() * sizeof(UINT64));
+		std::memcpy(blob.data(), frames.data(), blob.size());
+		return blob;
+	}
+}
+
+TEST_CASE("StackTraceInterner: Equal stacks share an id, different stacks get their own")
+{
+	StackTraceInterner interner;
+	std::vector<UINT32> ids;
+	for (std::size_t stack = 0; stack < StacksCount; stack++)
+		ids.push_back(interner.Intern(GetFrames(stack), 0, [](UINT32, std::span<const BYTE>) { }));
+
+	// Interned again from copies of the blobs, the shard is found from the contents alone
+	for (std::size_t stack = 0; stack < StacksCount; stack++)
+		CHECK(interner.Intern(GetFrames(stack), 0, [](UINT32, std::span<const BYTE>) { }) == ids[stack]);
+
+	auto sortedIds = ids;
+	std::ranges::sort(sortedIds);
+	CHECK(std::ranges::adjacent_find(sortedIds) == sortedIds.end());
+	CHECK(sortedIds.back() == StacksCount - 1);
+	CHECK(interner.GetCount() == StacksCount);
+}
+
+TEST_CASE("StackTraceInterner: Each id is defined exactly once when threads race for it")
+{
+	StackTraceInterner interner;
+	std::vector<std::vector<BYTE>> stacks;
+	for (std::size_t stack = 0; stack < StacksCount; stack++)
+		stacks.push_back(GetFrames(stack));
+
+	std::vector<std::atomic<std::size_t>> definitions(StacksCount);
+	std::vector<std::vector<UINT32>> ids(ThreadsCount, std::vector<UINT32>(StacksCount));
+	std::atomic<std::size_t> mismatches = 0;
+	std::atomic<std::size_t> ready = 0;
+	std::vector<std::thread> threads;
+	for (std::size_t thread = 0; thread < ThreadsCount; thread++)
+	{
+		threads.emplace_back([&, thread]()
+		{
+			ready.fetch_add(1);
+			while (ready.load() < ThreadsCount)
+				std::this_thread::yield();
+
+			// Threads walk the stacks in different orders, so that they meet on the same ones
+			for (std::size_t step = 0; step < StacksCount; step++)
+			{
+				const auto stack = (step * (thread * 2 + 1)) % StacksCount;
+				ids[thread][stack] = interner.Intern(stacks[stack], 0, [&](const UINT32 id, const std::span<const BYTE> frames)
+				{
+					// Definitions get the frames of the first caller
+					if (id >= StacksCount || !std::ranges::equal(frames, stacks[stack]))
+						mismatches.fetch_add(1, std::memory_order_relaxed);
+					else
+						definitions[id].fetch_add(1, std::memory_order_relaxed);
+				});
+			}
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+
+	CHECK(mismatches.load() == 0);
+	CHECK(interner.GetCount() == StacksCount);
+	for (std::size_t id = 0; id < StacksCount; id++)
+		CHECK(definitions[id].load() == 1);
+	for (std::size_t thread = 1; thread < ThreadsCount; thread++)
+		CHECK(ids[thread] == ids.front());
+}
+
+TEST_CASE("StackTraceInterner: Stacks are defined again once the discontinuities count changes")
+{
+	StackTraceInterner interner;
+	const auto frames = GetFrames(3);
+	std::vector<UINT32> defined;
+	const auto define = [&](const UINT32 id, std::span<const BYTE>) { defined.push_back(id); };
+
+	const auto id = interner.Intern(frames, 0, define);
+	CHECK(interner.Intern(frames, 0, define) == id);
+	std::vector expected { id };
+	CHECK(defined == expected);
+
+	// Records may have been lost, the definition is published again under the same id
+	CHECK(interner.Intern(frames, 1, define) == id);
+	CHECK(interner.Intern(frames, 1, define) == id);
+	expected.push_back(id);
+	CHECK(defined == expected);
+
+	// Other stacks are defined once, with the current count
+	const auto otherId = interner.Intern(GetFrames(4), 1, define);
+	CHECK(interner.Intern(GetFrames(4), 1, define) == otherId);
+	CHECK(otherId != id);
+	expected.push_back(otherId);
+	CHECK(defined == expected);
+	CHECK(interner.GetCount() == 2);
+}
@@ -0,0 +1,110 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <optional>
+#include <vector>
+
+#include "doctest.h"
+
+#include "TrackedObjectCache.h"
+
+using LibProfiler::TrackedObjectCache;
+using LibProfiler::TrackedObjectId;
+
+namespace
+{
+	constexpr ObjectID HeapStart = 0x100000;
+	constexpr SIZE_T ObjectSize = 0x20;
+
+	ObjectID HeapObject(const std::size_t index)
+	{
+		return HeapStart + index * ObjectSize;
+	}
+
+	TrackedObjectId GetTrackedObjectId(const std::size_t index)
+	{
+		return index + 1;
+	}
+}
+
+TEST_CASE("TrackedObjectCache: Capacity is rounded down to a power of two multiple of the ways")
+{
+	CHECK(TrackedObjectCache(0).GetCapacity() == 0);
+	CHECK(TrackedObjectCache(TrackedObjectCache::Ways - 1).GetCapacity() == 0);
+	CHECK(TrackedObjectCache(TrackedObjectCache::Ways).GetCapacity() == TrackedObjectCache::Ways);
+	CHECK(TrackedObjectCache(2 * TrackedObjectCache::Ways - 1).GetCapacity() == TrackedObjectCache::Ways);
+	CHECK(TrackedObjectCache(3 * TrackedObjectCache::Ways).GetCapacity() == 2 * TrackedObjectCache::Ways);
+	CHECK(TrackedObjectCache(1024).GetCapacity() == 1024);
+	CHECK(TrackedObjectCache(1000).GetCapacity() == 512);
+}
+
+TEST_CASE("TrackedObjectCache: Disabled cache misses every lookup")
+{
+	TrackedObjectCache cache(0);
+	cache.Insert(HeapObject(0), GetTrackedObjectId(0));
+	CHECK_FALSE(cache.Find(HeapObject(0)).has_value());
+	cache.Retain([](ObjectID) { return true; });
+
+	const auto& counters = *cache.GetCounters();
+	CHECK(counters.hits.load() == 0);
+	CHECK(counters.misses.load() == 1);
+	CHECK(counters.retained.load() == 0);
+}
+
+TEST_CASE("TrackedObjectCache: Full sets evict their least recently used entry")
+{
+	// A single set, every object competes for the same ways
+	TrackedObjectCache cache(TrackedObjectCache::Ways);
+	for (std::size_t index = 0; index < TrackedObjectCache::Ways; index++)
+		cache.Insert(HeapObject(index), GetTrackedObjectId(index));
+
+	// The oldest entry becomes the most recently used one, the second oldest is evicted instead
+	CHECK(cache.Find(HeapObject(0)) == GetTrackedObjectId(0));
+	cache.Insert(HeapObject(TrackedObjectCache::Ways), GetTrackedObjectId(TrackedObjectCache::Ways));
+	CHECK_FALSE(cache.Find(HeapObject(1)).has_value());
+	for (std::size_t index = 2; index <= TrackedObjectCache::Ways; index++)
+		CHECK(cache.Find(HeapObject(index)) == GetTrackedObjectId(index));
+	CHECK(cache.Find(HeapObject(0)) == GetTrackedObjectId(0));
+
+	// Inserting a cached object replaces its entry, nothing else is evicted
+	cache.Insert(HeapObject(2), GetTrackedObjectId(100));
+	CHECK(cache.Find(HeapObject(2)) == GetTrackedObjectId(100));
+	for (const auto index : { std::size_t { 0 }, std::size_t { 3 }, TrackedObjectCache::Ways })
+		CHECK(cache.Find(HeapObject(index)) == GetTrackedObjectId(index));
+
+	const auto& counters = *cache.GetCounters();
+	CHECK(counters.hits.load() == TrackedObjectCache::Ways + 5);
+	CHECK(counters.misses.load() == 1);
+}
+
+TEST_CASE("TrackedObjectCache: Retain keeps valid entries and counts both kinds")
+{
+	TrackedObjectCache cache(TrackedObjectCache::Ways);
+	for (std::size_t index = 0; index < TrackedObjectCache::Ways; index++)
+		cache.Insert(HeapObject(index), GetTrackedObjectId(index));
+
+	// Keeps the objects with even indices
+	cache.Retain([](const ObjectID objectId) { return (objectId - HeapStart) / ObjectSize % 2 == 0; });
+	const auto& counters = *cache.GetCounters();
+	CHECK(counters.retained.load() == TrackedObjectCache::Ways / 2);
+	CHECK(counters.dropped.load() == TrackedObjectCache::Ways / 2);
+
+	// Dropped entries free their ways, new objects do not evict the retained ones
+	for (std::size_t index = 0; index < TrackedObjectCache::Ways / 2; index++)
+		cache.Insert(HeapObject(TrackedObjectCache::Ways + index), GetTrackedObjectId(TrackedObjectCache::Ways + index));
+	for (std::size_t index = 0; index < TrackedObjectCache::Ways + TrackedObjectCache::Ways / 2; index++)
+	{
+		const auto expected = index < TrackedObjectCache::Ways && index % 2 == 1
+			? std::nullopt
+			: std::optional { GetTrackedObjectId(index) };
+		CHECK(cache.Find(HeapObject(index)) == expected);
+	}
+
+	// Counters add up over revalidations, empty ways are not counted
+	cache.Retain([](ObjectID) { return false; });
+	CHECK(counters.retained.load() == TrackedObjectCache::Ways / 2);
+	CHECK(counters.dropped.load() == TrackedObjectCache::Ways / 2 + TrackedObjectCache::Ways);
+	cache.Retain([](ObjectID) { return true; });
+	CHECK(counters.retained.load() == TrackedObjectCache::Ways / 2);
+	CHECK_FALSE(cache.Find(HeapObject(0)).has_value());
+}
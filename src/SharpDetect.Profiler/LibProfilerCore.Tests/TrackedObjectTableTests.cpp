@@ -0,0 +1,85 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <vector>
+
+#include "doctest.h"
+
+#include "TrackedObjectTable.h"
+
+using LibProfiler::TrackedObjectEntry;
+using LibProfiler::TrackedObjectTable;
+
+namespace
+{
+	constexpr ObjectID HeapStart = 0x100000;
+	constexpr SIZE_T ObjectSize = 0x20;
+	// Grows the table from its initial 16 slots a few times
+	constexpr std::size_t ObjectsCount = 3000;
+
+	ObjectID HeapObject(const std::size_t index)
+	{
+		return HeapStart + index * ObjectSize;
+	}
+}
+
+TEST_CASE("TrackedObjectTable: Entries are found after every growth")
+{
+	TrackedObjectTable table;
+	CHECK_FALSE(table.Find(HeapObject(0)).has_value());
+
+	std::size_t mismatches = 0;
+	for (std::size_t index = 0; index < ObjectsCount; index++)
+	{
+		table.Insert(HeapObject(index), index + 1);
+
+		// Every insert may have rehashed the table, all earlier entries must still be found
+		for (std::size_t inserted = 0; inserted <= index; inserted++)
+		{
+			if (table.Find(HeapObject(inserted)) != inserted + 1)
+				mismatches++;
+		}
+		if (table.Find(HeapObject(index + 1)).has_value())
+			mismatches++;
+	}
+
+	CHECK(mismatches == 0);
+	CHECK(table.GetSize() == ObjectsCount);
+}
+
+TEST_CASE("TrackedObjectTable: Rehashed entries are visited exactly once")
+{
+	TrackedObjectTable table;
+	// Addresses from distant regions, their hashes spread differently than those of neighbours
+	for (std::size_t index = 0; index < ObjectsCount; index++)
+		table.Insert(HeapObject(index) + (index % 3) * 0x10000000, index + 1);
+
+	std::vector<TrackedObjectEntry> entries;
+	table.ForEach([&](const TrackedObjectEntry& entry) { entries.push_back(entry); });
+	std::ranges::sort(entries, std::less { }, &TrackedObjectEntry::trackedObjectId);
+	REQUIRE(entries.size() == ObjectsCount);
+	for (std::size_t index = 0; index < ObjectsCount; index++)
+	{
+		CHECK(entries[index].objectId == HeapObject(index) + (index % 3) * 0x10000000);
+		CHECK(entries[index].trackedObjectId == index + 1);
+	}
+}
+
+TEST_CASE("TrackedObjectTable: Cleared table starts over")
+{
+	TrackedObjectTable table;
+	for (std::size_t index = 0; index < ObjectsCount; index++)
+		table.Insert(HeapObject(index), index + 1);
+
+	table.Clear();
+	CHECK(table.GetSize() == 0);
+	CHECK_FALSE(table.Find(HeapObject(0)).has_value());
+
+	// The same addresses may be tracked again, under different ids
+	for (std::size_t index = 0; index < ObjectsCount; index += 2)
+		table.Insert(HeapObject(index), ObjectsCount + index);
+	CHECK(table.GetSize() == ObjectsCount / 2);
+	CHECK(table.Find(HeapObject(2)) == ObjectsCount + 2);
+	CHECK_FALSE(table.Find(HeapObject(1)).has_value());
+}
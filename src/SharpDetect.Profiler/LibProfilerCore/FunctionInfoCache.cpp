@@ -0,0 +1,192 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+#include "FunctionInfoCache.h"
+
+namespace
+{
+	std::size_t GetSlotIndex(const FunctionID functionId, const UINT shift)
+	{
+		// Fibonacci hashing, function ids are aligned pointers (with regular spacing) so their low bits are dropped
+		return static_cast<std::size_t>(((static_cast<UINT64>(functionId) >> 3) * 0x9E3779B97F4A7C15) >> shift);
+	}
+
+	// Spreads threads across the reader slots
+	std::atomic<std::size_t> nextReaderSlot { 0 };
+	thread_local const std::size_t readerSlot = nextReaderSlot.fetch_add(1, std::memory_order_relaxed);
+}
+
+LibProfiler::FunctionInfoCache::ReadScope::ReadScope(FunctionInfoCache* cache) :
+	_cache(cache), _active(cache != nullptr ? &cache->_readers[readerSlot % ReaderSlotsCount].active : nullptr)
+{
+	// Announcing the scope and loading tables are sequentially consistent with publishing a replacement
+	// and checking the slots, so either the writer sees this scope or the scope sees the replacement
+	if (_active != nullptr)
+		_active->fetch_add(1, std::memory_order_seq_cst);
+}
+
+LibProfiler::FunctionInfoCache::ReadScope::~ReadScope()
+{
+	if (_active == nullptr)
+		return;
+
+	_active->fetch_sub(1, std::memory_order_release);
+	if (_cache->_retiredCount.load(std::memory_order_relaxed) == 0)
+		return;
+
+	// The writer holding the mutex (or a later scope) frees them otherwise
+	std::unique_lock lock(_cache->_mutex, std::try_to_lock);
+	if (lock.owns_lock())
+		_cache->ReleaseRetiredTables();
+}
+
+LibProfiler::FunctionInfoCache::Table::Table(const std::size_t capacity) :
+	slots(std::make_unique<Slot[]>(capacity)), mask(capacity - 1), shift(64 - std::countr_zero(capacity))
+{
+}
+
+LibProfiler::FunctionInfoCache::FunctionInfoCache() :
+	_current(std::make_unique<Table>(MinCapacity))
+{
+	_table.store(_current.get(), std::memory_order_release);
+}
+
+HRESULT LibProfiler::FunctionInfoCache::GetFunctionInfo(
+	ICorProfilerInfo10* corProfilerInfo,
+	const FunctionID functionId,
+	ModuleID& moduleId,
+	mdMethodDef& methodToken)
+{
+	if (const auto slot = Find(*_table.load(std::memory_order_seq_cst), functionId))
+	{
+		moduleId = slot->moduleId;
+		methodToken = slot->methodToken;
+		return S_OK;
+	}
+
+	const auto hr = corProfilerInfo->GetFunctionInfo(functionId, nullptr, &moduleId, &methodToken);
+	// Dynamic methods have no token and are collected without any unload callback
+	if (FAILED(hr) || functionId <= InvalidatedSlot || RidFromToken(methodToken) == 0)
+		return hr;
+
+	std::lock_guard lock(_mutex);
+	if (Find(*_table.load(std::memory_order_relaxed), functionId) == nullptr)
+		Insert(functionId, moduleId, methodToken);
+	return hr;
+}
+
+void LibProfiler::FunctionInfoCache::InvalidateFunction(const FunctionID functionId)
+{
+	std::lock_guard lock(_mutex);
+	if (const auto slot = Find(*_table.load(std::memory_order_relaxed), functionId))
+		Invalidate(*const_cast<Slot*>(slot));
+	ReleaseRetiredTables();
+}
+
+void LibProfiler::FunctionInfoCache::InvalidateModule(const ModuleID moduleId)
+{
+	std::lock_guard lock(_mutex);
+	const auto& table = *_table.load(std::memory_order_relaxed);
+	for (std::size_t index = 0; index <= table.mask; ++index)
+	{
+		auto& slot = table.slots[index];
+		const auto functionId = slot.functionId.load(std::memory_order_relaxed);
+		if (functionId != EmptySlot && functionId != InvalidatedSlot && slot.moduleId == moduleId)
+			Invalidate(slot);
+	}
+	ReleaseRetiredTables();
+}
+
+std::size_t LibProfiler::FunctionInfoCache::GetCount() const
+{
+	std::lock_guard lock(_mutex);
+	return _count;
+}
+
+std::size_t LibProfiler::FunctionInfoCache::GetRetiredTablesCount() const
+{
+	std::lock_guard lock(_mutex);
+	return _retired.size();
+}
+
+const LibProfiler::FunctionInfoCache::Slot* LibProfiler::FunctionInfoCache::Find(const Table& table, const FunctionID functionId)
+{
+	for (auto index = GetSlotIndex(functionId, table.shift);; index = (index + 1) & table.mask)
+	{
+		const auto& slot = table.slots[index];
+		const auto current = slot.functionId.load(std::memory_order_acquire);
+		if (current == functionId)
+			return &slot;
+		if (current == EmptySlot)
+			return nullptr;
+	}
+}
+
+void LibProfiler::FunctionInfoCache::Insert(const FunctionID functionId, const ModuleID moduleId, const mdMethodDef methodToken)
+{
+	auto table = _table.load(std::memory_order_relaxed);
+	if ((table->used + 1) * 2 > table->mask + 1)
+	{
+		// Invalidated slots are dropped, the table only grows if live entries need it
+		const auto capacity = std::max(MinCapacity, std::bit_ceil((_count + 1) * 3));
+		auto replacement = std::make_unique<Table>(capacity);
+		for (std::size_t index = 0; index <= table->mask; ++index)
+		{
+			const auto& slot = table->slots[index];
+			const auto current = slot.functionId.load(std::memory_order_relaxed);
+			if (current == EmptySlot || current == InvalidatedSlot)
+				continue;
+
+			auto target = GetSlotIndex(current, replacement->shift);
+			while (replacement->slots[target].functionId.load(std::memory_order_relaxed) != EmptySlot)
+				target = (target + 1) & replacement->mask;
+			auto& copy = replacement->slots[target];
+			copy.moduleId = slot.moduleId;
+			copy.methodToken = slot.methodToken;
+			copy.functionId.store(current, std::memory_order_relaxed);
+			replacement->used++;
+		}
+
+		table = replacement.get();
+		_retired.push_back(std::exchange(_current, std::move(replacement)));
+		_retiredCount.store(_retired.size(), std::memory_order_relaxed);
+		_table.store(table, std::memory_order_seq_cst);
+	}
+
+	auto index = GetSlotIndex(functionId, table->shift);
+	while (table->slots[index].functionId.load(std::memory_order_relaxed) != EmptySlot)
+		index = (index + 1) & table->mask;
+
+	auto& slot = table->slots[index];
+	slot.moduleId = moduleId;
+	slot.methodToken = methodToken;
+	slot.functionId.store(functionId, std::memory_order_release);
+	table->used++;
+	_count++;
+}
+
+void LibProfiler::FunctionInfoCache::Invalidate(Slot& slot)
+{
+	slot.functionId.store(InvalidatedSlot, std::memory_order_release);
+	_count--;
+}
+
+void LibProfiler::FunctionInfoCache::ReleaseRetiredTables()
+{
+	if (_retired.empty())
+		return;
+
+	// Scopes that start from now on can only load the current table
+	for (const auto& reader : _readers)
+	{
+		if (reader.active.load(std::memory_order_seq_cst) != 0)
+			return;
+	}
+
+	_retired.clear();
+	_retiredCount.store(0, std::memory_order_relaxed);
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "cor.h"
+#include "corprof.h"
+
+namespace LibProfiler
+{
+	// FunctionID -> (ModuleID, method token) map, so that stack walks do not call into the runtime per frame
+	// Lookups are lock-free probes of an open-addressing table, only inserting and invalidating take a lock
+	// Lookups are made within read scopes, replaced tables are freed once no scope is active
+	// Function ids may be reused once their functions unload, entries must be invalidated by the unload callbacks
+	class FunctionInfoCache
+	{
+	public:
+		// Announces lookups of the calling thread, held for a whole stack walk so that frames do not pay for it
+		class ReadScope
+		{
+		public:
+			// Does nothing without a cache
+			explicit ReadScope(FunctionInfoCache* cache);
+			~ReadScope();
+			ReadScope(const ReadScope&) = delete;
+			ReadScope& operator=(const ReadScope&) = delete;
+
+		private:
+			FunctionInfoCache* _cache;
+			std::atomic<UINT64>* _active;
+		};
+
+		FunctionInfoCache();
+
+		// Must be called within a read scope of this cache
+		HRESULT GetFunctionInfo(
+			ICorProfilerInfo10* corProfilerInfo,
+			FunctionID functionId,
+			ModuleID& moduleId,
+			mdMethodDef& methodToken);
+
+		void InvalidateFunction(FunctionID functionId);
+		void InvalidateModule(ModuleID moduleId);
+		[[nodiscard]] std::size_t GetCount() const;
+		[[nodiscard]] std::size_t GetRetiredTablesCount() const;
+
+	private:
+		// Values are written before the function id is published and never change afterwards
+		struct Slot
+		{
+			std::atomic<FunctionID> functionId;
+			ModuleID moduleId;
+			mdMethodDef methodToken;
+		};
+
+		// Capacity is a power of two, at most half of the slots are used (including invalidated ones)
+		struct Table
+		{
+			explicit Table(std::size_t capacity);
+
+			std::unique_ptr<Slot[]> slots;
+			std::size_t mask;
+			UINT shift;
+			std::size_t used { 0 };
+		};
+
+		// Read scopes of the threads sharing the slot
+		struct alignas(64) ReaderSlot
+		{
+			std::atomic<UINT64> active { 0 };
+		};
+
+		static constexpr FunctionID EmptySlot = 0;
+		// Invalidated slots are never reused, readers may still be looking at them
+		static constexpr FunctionID InvalidatedSlot = 1;
+		static constexpr std::size_t MinCapacity = 1024;
+		static constexpr std::size_t ReaderSlotsCount = 64;
+
+		[[nodiscard]] static const Slot* Find(const Table& table, FunctionID functionId);
+		// Must be called with the mutex held
+		void Insert(FunctionID functionId, ModuleID moduleId, mdMethodDef methodToken);
+		void Invalidate(Slot& slot);
+		void ReleaseRetiredTables();
+
+		std::atomic<Table*> _table;
+		std::array<ReaderSlot, ReaderSlotsCount> _readers;
+		// Lets read scopes skip the mutex while there is nothing to free
+		std::atomic<std::size_t> _retiredCount { 0 };
+		// Guards writers, readers never take it
+		mutable std::mutex _mutex;
+		std::unique_ptr<Table> _current;
+		// Replaced tables are kept alive until no read scope can be probing them
+		std::vector<std::unique_ptr<Table>> _retired;
+		std::size_t _count { 0 };
+	};
+}
\ No newline at end of file
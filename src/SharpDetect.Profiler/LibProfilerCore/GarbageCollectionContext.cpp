@@ -5,74 +5,29 @@
 
 #include "GarbageCollectionContext.h"
 
-#include <ranges>
-
-LibProfiler::GarbageCollectionContext::GarbageCollectionContext(
-	const std::unordered_map<ObjectID,
-	TrackedObjectId>& oldHeap,
-	std::vector<BOOL>&& generationsCollected,
-	std::vector<COR_PRF_GC_GENERATION_RANGE>&& bounds) :
-	_newHeapBuilder({ }), 
-	_previousTrackedObjects({ }),
-	_nextTrackedObjects({ }),
-	_previousSortedHeap(std::vector<std::tuple<ObjectID, TrackedObjectId>>(oldHeap.cbegin(), oldHeap.cend())), 
-	_bounds(std::move(bounds)),
-	_generationsCollected(std::move(generationsCollected))
+LibProfiler::GarbageCollectionContext::GarbageCollectionContext(std::vector<TrackedObjectEntry>&& sortedHeap, GcWorkerPool* workers) :
+	_heap(std::move(sortedHeap)),
+	_examinedObjectsCount(_heap.size()),
+	_collectedObjectsCount(0),
+	_workers(workers),
+	_builders(workers != nullptr ? workers->GetWorkersCount() : 1)
 {
-	for (const auto &val: oldHeap | std::views::values)
-	{
-		auto trackedObjectId = val;
-		_previousTrackedObjects.insert(trackedObjectId);
-	}
-
-	std::ranges::sort(_previousSortedHeap,
-		[](std::tuple<ObjectID, TrackedObjectId> const& t1, std::tuple<ObjectID, TrackedObjectId> const& t2)
-		{
-			return std::get<0>(t1) < std::get<0>(t2);
-		});
-
-	/* All generations that are not being collected automatically survived */
-	for (auto&& bound : _bounds)
-	{
-		if (_generationsCollected[bound.generation])
-		{
-			// We need to resolve Surviving / Moving references notifications for this GC
-			continue;
-		}
-
-		ProcessSurvivingReferences(std::span<ObjectID>(&bound.rangeStart, 1), std::span<SIZE_T>(&bound.rangeLength, 1));
-	}
 }
 
 void LibProfiler::GarbageCollectionContext::ProcessSurvivingReferences(
 	const std::span<ObjectID> starts,
 	const std::span<SIZE_T> lengths)
 {
-	for (size_t index = 0; index < starts.size(); index++) 
+	ProcessRanges(starts.size(), [&](RangesBuilder& builder, const std::size_t begin, const std::size_t end)
 	{
-		const auto start = starts[index];
-		const auto length = lengths[index];
-		
-		// Find element in segment that is closest to the segment start
-		auto startIndex = BinarySearch(start);
-		if (startIndex < 0)
-			startIndex = ~startIndex;
-
-		// Find element in segment that is closest to the segment end
-		auto endIndex = BinarySearch(start + length - 1);
-		if (endIndex < 0)
-			endIndex = ~endIndex;
-
-		for (size_t survivingIndex = startIndex; survivingIndex < endIndex; survivingIndex++)
+		for (auto index = begin; index < end; index++)
 		{
-			// All objects that matched are surviving
-			ObjectID currentObjectId;
-			TrackedObjectId currentTrackedObjectId;
-			std::tie(currentObjectId, currentTrackedObjectId) = _previousSortedHeap[survivingIndex];
-			_newHeapBuilder.insert(std::make_pair(currentObjectId, currentTrackedObjectId));
-			_nextTrackedObjects.insert(currentTrackedObjectId);
+			// Objects stay in place, they are resolved when the GC finishes
+			const auto range = FindRange(starts[index], lengths[index], false);
+			if (range.begin != range.end)
+				builder.ranges.push_back(range);
 		}
-	}
+	});
 }
 
 void LibProfiler::GarbageCollectionContext::ProcessMovingReferences(
@@ -80,55 +35,115 @@ void LibProfiler::GarbageCollectionContext::ProcessMovingReferences(
 	const std::span<ObjectID> newStarts,
 	const std::span<SIZE_T> lengths)
 {
-	for (size_t index = 0; index < oldStarts.size(); index++)
+	ProcessRanges(oldStarts.size(), [&](RangesBuilder& builder, const std::size_t begin, const std::size_t end)
 	{
-		auto const newStart = newStarts[index];
-		auto const oldStart = oldStarts[index];
-		auto const length = lengths[index];
-
-		// Find element in segment that is closest to the segment start
-		auto startIndex = BinarySearch(oldStart);
-		if (startIndex < 0)
-			startIndex = ~startIndex;
-
-		// Find element in segment that is closest to the segment end
-		auto endIndex = BinarySearch(oldStart + length - 1);
-		if (endIndex < 0)
-			endIndex = ~endIndex;
-
-		for (size_t survivingIndex = startIndex; survivingIndex < endIndex; survivingIndex++)
+		for (auto index = begin; index < end; index++)
 		{
-			// All objects that matched are surviving
-			ObjectID currentObjectId;
-			TrackedObjectId currentTrackedObjectId;
-			std::tie(currentObjectId, currentTrackedObjectId) = _previousSortedHeap[survivingIndex];
-			auto const newStartingIndex = newStart + (currentObjectId - oldStart);
-			_newHeapBuilder.insert(std::make_pair(newStartingIndex, currentTrackedObjectId));
-			_nextTrackedObjects.insert(currentTrackedObjectId);
+			auto const newStart = newStarts[index];
+			auto const oldStart = oldStarts[index];
+			const auto range = FindRange(oldStart, lengths[index], true);
+			if (range.begin == range.end)
+				continue;
+
+			builder.ranges.push_back(range);
+			for (auto movedIndex = range.begin; movedIndex < range.end; movedIndex++)
+			{
+				const auto& [currentObjectId, currentTrackedObjectId] = _heap[movedIndex];
+				builder.movedObjects.push_back({ newStart + (currentObjectId - oldStart), currentTrackedObjectId });
+			}
 		}
-	}
+	});
 }
 
-INT LibProfiler::GarbageCollectionContext::BinarySearch(const ObjectID objId) const
+void LibProfiler::GarbageCollectionContext::ProcessRanges(const std::size_t count, const RangesProcessor& processor)
 {
-	if (_previousSortedHeap.empty())
-		return ~0;
+	// Looking up a range is cheap, small batches are not worth waking up the workers
+	constexpr std::size_t rangesPerTask = 256;
 
-	INT leftIndex = 0;
-	INT rightIndex = _previousSortedHeap.size() - 1;
-	while (leftIndex <= rightIndex)
+	const auto tasksCount = (count + rangesPerTask - 1) / rangesPerTask;
+	if (_workers == nullptr || tasksCount < 2)
 	{
-		const auto middleIndex = (leftIndex + rightIndex) / 2;
-		ObjectID middleValue;
-		std::tie(middleValue, std::ignore) = _previousSortedHeap[middleIndex];
+		processor(_builders.front(), 0, count);
+		return;
+	}
 
-		if (middleValue == objId)
-			return middleIndex;
-		else if (middleValue < objId)
-			leftIndex = middleIndex + 1;
-		else if (middleValue > objId)
-			rightIndex = middleIndex - 1;
+	_workers->Run(tasksCount, [&](const std::size_t workerIndex, const std::size_t taskIndex)
+	{
+		const auto begin = taskIndex * rangesPerTask;
+		processor(_builders[workerIndex], begin, std::min(count, begin + rangesPerTask));
+	});
+}
+
+void LibProfiler::GarbageCollectionContext::Finish(const std::size_t chunkSize, const TrackedObjectIdsVisitor& collectedVisitor)
+{
+	std::vector<IndexRange> ranges;
+	for (auto& builder : _builders)
+	{
+		ranges.insert(ranges.end(), builder.ranges.cbegin(), builder.ranges.cend());
+		_movedObjects.insert(_movedObjects.end(), builder.movedObjects.cbegin(), builder.movedObjects.cend());
+		builder = { };
 	}
+	std::ranges::sort(ranges, std::less { }, &IndexRange::begin);
+
+	// Dead entries are visited before compaction overwrites them, only a single chunk is ever materialized
+	std::vector<TrackedObjectId> chunk;
+	const auto flush = [&]()
+	{
+		// Identifiers were assigned in allocation order, not in address order
+		std::ranges::sort(chunk);
+		collectedVisitor(chunk);
+		chunk.clear();
+	};
+	const auto collect = [&](const std::size_t begin, const std::size_t end)
+	{
+		_collectedObjectsCount += end - begin;
+		if (!collectedVisitor)
+			return;
 
-	return ~leftIndex;
+		for (auto deadIndex = begin; deadIndex < end; deadIndex++)
+		{
+			if (chunk.empty())
+				chunk.reserve(std::min(chunkSize, _heap.size() - deadIndex));
+			chunk.push_back(_heap[deadIndex].trackedObjectId);
+			if (chunk.size() == chunkSize)
+				flush();
+		}
+	};
+
+	// Compact the heap in place: entries outside of all ranges died, moved entries are merged back below
+	std::size_t writeIndex = 0;
+	std::size_t covered = 0;
+	for (const auto& range : ranges)
+	{
+		const auto begin = std::max(covered, range.begin);
+		collect(covered, begin);
+		if (!range.moved && begin < range.end)
+		{
+			if (writeIndex != begin)
+				std::copy(_heap.cbegin() + begin, _heap.cbegin() + range.end, _heap.begin() + writeIndex);
+			writeIndex += range.end - begin;
+		}
+		covered = std::max(covered, range.end);
+	}
+	collect(covered, _heap.size());
+	if (!chunk.empty())
+		flush();
+	_heap.resize(writeIndex);
+
+	// Each moved range preserves the order of its objects, only the ranges themselves can arrive unordered
+	std::ranges::sort(_movedObjects, std::less { }, &TrackedObjectEntry::objectId);
+	MergeTrackedObjects(_heap, _movedObjects);
 }
+
+LibProfiler::GarbageCollectionContext::IndexRange LibProfiler::GarbageCollectionContext::FindRange(
+	const ObjectID start,
+	const SIZE_T length,
+	const bool moved) const
+{
+	const auto begin = std::ranges::lower_bound(_heap.cbegin(), _heap.cend(), start, std::less { }, &TrackedObjectEntry::objectId);
+	const auto end = std::ranges::lower_bound(begin, _heap.cend(), start + length, std::less { }, &TrackedObjectEntry::objectId);
+	return {
+		static_cast<std::size_t>(begin - _heap.cbegin()),
+		static_cast<std::size_t>(end - _heap.cbegin()),
+		moved };
+}
\ No newline at end of file
@@ -3,15 +3,15 @@
 
 #pragma once
 
-#include <unordered_map>
-#include <unordered_set>
+#include <cstddef>
+#include <functional>
 #include <span>
-#include <tuple>
 #include <vector>
 
 #include "cor.h"
 #include "corprof.h"
 
+#include "GcWorkerPool.h"
 #include "TrackedObjectId.h"
 
 namespace LibProfiler
@@ -19,23 +19,50 @@ namespace LibProfiler
 	class GarbageCollectionContext
 	{
 	public:
-		GarbageCollectionContext(const std::unordered_map<ObjectID, TrackedObjectId>& oldHeap, std::vector<BOOL>&& generationsCollected, std::vector<COR_PRF_GC_GENERATION_RANGE>&& bounds);
+		using TrackedObjectIdsVisitor = std::function<void(std::span<const TrackedObjectId> trackedObjectIds)>;
+		static constexpr std::size_t DefaultChunkSize = 64 * 1024;
+
+		// Holds only objects from the collected generations (sorted by address), the rest of the heap survives implicitly
+		// Large batches of ranges are split across the workers, if there are any
+		explicit GarbageCollectionContext(std::vector<TrackedObjectEntry>&& sortedHeap, GcWorkerPool* workers = nullptr);
 
 		void ProcessSurvivingReferences(std::span<ObjectID> starts, std::span<SIZE_T> lengths);
 		void ProcessMovingReferences(std::span<ObjectID> oldStarts, std::span<ObjectID> newStarts, std::span<SIZE_T> lengths);
+		// Must be called after all surviving / moving references of the GC were processed
+		// Visits identifiers of objects that did not survive the GC while compacting the heap, at most chunkSize of them at a time
+		// Each chunk is in ascending order, chunks follow the addresses of the objects
+		void Finish(std::size_t chunkSize = DefaultChunkSize, const TrackedObjectIdsVisitor& collectedVisitor = { });
 
-		[[nodiscard]] const std::unordered_map<ObjectID, TrackedObjectId>& GetHeap() const { return _newHeapBuilder; }
-		[[nodiscard]] const std::unordered_set<TrackedObjectId>& GetPreviousTrackedObjects() const { return _previousTrackedObjects; }
-		[[nodiscard]] const std::unordered_set<TrackedObjectId>& GetNextTrackedObjects() const { return _nextTrackedObjects; }
+		[[nodiscard]] std::size_t GetExaminedObjectsCount() const { return _examinedObjectsCount; }
+		[[nodiscard]] std::size_t GetCollectedObjectsCount() const { return _collectedObjectsCount; }
+		// Surviving objects with their new addresses (sorted by address)
+		[[nodiscard]] std::vector<TrackedObjectEntry> TakeHeap() { return std::move(_heap); }
 
 	private:
+		struct IndexRange
+		{
+			std::size_t begin;
+			std::size_t end;
+			bool moved;
+		};
+
+		// Ranges found by a single worker, merged once the GC finishes
+		struct RangesBuilder
+		{
+			std::vector<IndexRange> ranges;
+			std::vector<TrackedObjectEntry> movedObjects;
+		};
+
+		using RangesProcessor = std::function<void(RangesBuilder& builder, std::size_t begin, std::size_t end)>;
+
+		void ProcessRanges(std::size_t count, const RangesProcessor& processor);
+		[[nodiscard]] IndexRange FindRange(ObjectID start, SIZE_T length, bool moved) const;
 
-		INT BinarySearch(ObjectID objId) const;
-		std::unordered_map<ObjectID, TrackedObjectId> _newHeapBuilder;
-		std::unordered_set<TrackedObjectId> _previousTrackedObjects;
-		std::unordered_set<TrackedObjectId> _nextTrackedObjects;
-		std::vector<std::tuple<ObjectID, TrackedObjectId>> _previousSortedHeap;
-		std::vector<COR_PRF_GC_GENERATION_RANGE> _bounds;
-		std::vector<BOOL> _generationsCollected;
+		std::vector<TrackedObjectEntry> _heap;
+		std::size_t _examinedObjectsCount;
+		std::size_t _collectedObjectsCount;
+		GcWorkerPool* _workers;
+		std::vector<RangesBuilder> _builders;
+		std::vector<TrackedObjectEntry> _movedObjects;
 	};
 }
\ No newline at end of file
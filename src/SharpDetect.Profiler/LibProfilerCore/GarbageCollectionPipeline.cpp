@@ -0,0 +1,189 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <utility>
+
+#include "GarbageCollectionPipeline.h"
+
+LibProfiler::GarbageCollectionPipeline::GarbageCollectionPipeline(
+	ObjectsTracker& tracker,
+	const bool deferred,
+	const std::size_t collectedChunkSize,
+	Callbacks callbacks) :
+	_tracker(tracker),
+	_collectedChunkSize(collectedChunkSize),
+	_callbacks(std::move(callbacks)),
+	_applying(false),
+	_deferred(deferred),
+	_terminating(false)
+{
+	if (_deferred)
+		_thread = std::thread(&LibProfiler::GarbageCollectionPipeline::WorkerLoop, this);
+}
+
+LibProfiler::GarbageCollectionPipeline::~GarbageCollectionPipeline()
+{
+	Stop();
+}
+
+void LibProfiler::GarbageCollectionPipeline::ProcessGarbageCollectionStarted(
+	std::vector<BOOL>&& collectedGenerations,
+	std::vector<COR_PRF_GC_GENERATION_RANGE>&& bounds)
+{
+	if (!_deferred)
+	{
+		_tracker.ProcessGarbageCollectionStarted(std::move(collectedGenerations), std::move(bounds));
+		return;
+	}
+
+	std::lock_guard guard(_recordingMutex);
+	_recording = RecordedCollection { std::move(collectedGenerations), std::move(bounds), { }, { } };
+}
+
+void LibProfiler::GarbageCollectionPipeline::ProcessSurvivingReferences(const std::span<ObjectID> starts, const std::span<SIZE_T> lengths)
+{
+	if (!_deferred)
+	{
+		_tracker.ProcessSurvivingReferences(starts, lengths);
+		return;
+	}
+
+	ReferencesBatch batch {
+		std::vector(starts.begin(), starts.end()),
+		{ },
+		std::vector(lengths.begin(), lengths.end()) };
+	std::lock_guard guard(_recordingMutex);
+	_recording->batches.push_back(std::move(batch));
+}
+
+void LibProfiler::GarbageCollectionPipeline::ProcessMovingReferences(
+	const std::span<ObjectID> oldStarts,
+	const std::span<ObjectID> newStarts,
+	const std::span<SIZE_T> lengths)
+{
+	if (!_deferred)
+	{
+		_tracker.ProcessMovingReferences(oldStarts, newStarts, lengths);
+		return;
+	}
+
+	ReferencesBatch batch {
+		std::vector(oldStarts.begin(), oldStarts.end()),
+		std::vector(newStarts.begin(), newStarts.end()),
+		std::vector(lengths.begin(), lengths.end()) };
+	std::lock_guard guard(_recordingMutex);
+	_recording->batches.push_back(std::move(batch));
+}
+
+void LibProfiler::GarbageCollectionPipeline::ProcessGarbageCollectionFinished(std::vector<ObjectID>&& finalizationQueuedObjects)
+{
+	if (!_deferred)
+	{
+		// The tracker has not finished the GC yet, lookups still see the addresses from before it
+		std::vector<TrackedObjectId> finalizationQueuedTrackedObjects;
+		finalizationQueuedTrackedObjects.reserve(finalizationQueuedObjects.size());
+		_tracker.TryTranslateMany(finalizationQueuedObjects, finalizationQueuedTrackedObjects);
+		Finish(finalizationQueuedTrackedObjects);
+		return;
+	}
+
+	// Lookups would see addresses from before the GC until it is applied
+	_tracker.BeginDeferredGarbageCollection();
+	std::optional<RecordedCollection> collection;
+	{
+		std::lock_guard guard(_recordingMutex);
+		collection = std::exchange(_recording, std::nullopt);
+	}
+	collection->finalizationQueuedObjects = std::move(finalizationQueuedObjects);
+
+	std::unique_lock lock(_mutex);
+	if (!_terminating)
+	{
+		_queue.push_back(std::move(collection.value()));
+		lock.unlock();
+		_collectionQueued.notify_one();
+		return;
+	}
+
+	// The background thread is stopping, the GC is applied right away once the earlier ones are
+	_collectionApplied.wait(lock, [this]() { return _queue.empty() && !_applying; });
+	lock.unlock();
+	Apply(collection.value());
+}
+
+void LibProfiler::GarbageCollectionPipeline::Flush()
+{
+	std::unique_lock lock(_mutex);
+	_collectionApplied.wait(lock, [this]() { return _queue.empty() && !_applying; });
+}
+
+void LibProfiler::GarbageCollectionPipeline::Stop()
+{
+	{
+		std::lock_guard guard(_mutex);
+		_terminating = true;
+	}
+	_collectionQueued.notify_one();
+
+	if (_thread.joinable())
+		_thread.join();
+}
+
+void LibProfiler::GarbageCollectionPipeline::Apply(RecordedCollection& collection)
+{
+	// Earlier GCs are applied and this one is not started yet, the tracker is exactly at the state before it
+	std::vector<TrackedObjectId> finalizationQueuedTrackedObjects;
+	finalizationQueuedTrackedObjects.reserve(collection.finalizationQueuedObjects.size());
+	_tracker.TryTranslateManyBeforeDeferredGarbageCollection(collection.finalizationQueuedObjects, finalizationQueuedTrackedObjects);
+	collection.finalizationQueuedObjects = { };
+
+	_tracker.ProcessGarbageCollectionStarted(std::move(collection.collectedGenerations), std::move(collection.bounds));
+	for (auto& batch : collection.batches)
+	{
+		if (batch.newStarts.empty())
+			_tracker.ProcessSurvivingReferences(batch.oldStarts, batch.lengths);
+		else
+			_tracker.ProcessMovingReferences(batch.oldStarts, batch.newStarts, batch.lengths);
+
+		// Ranges are released as soon as they are applied
+		batch = { };
+	}
+
+	Finish(finalizationQueuedTrackedObjects);
+	_tracker.EndDeferredGarbageCollection();
+}
+
+void LibProfiler::GarbageCollectionPipeline::Finish(std::vector<TrackedObjectId>& finalizationQueuedObjects)
+{
+	_callbacks.applying(finalizationQueuedObjects);
+	const auto oldTrackedObjectsCount = _tracker.GetTrackedObjectsCount();
+	static_cast<void>(_tracker.ProcessGarbageCollectionFinished(_collectedChunkSize, _callbacks.collected));
+	_callbacks.applied(oldTrackedObjectsCount, _tracker.GetTrackedObjectsCount());
+}
+
+void LibProfiler::GarbageCollectionPipeline::WorkerLoop()
+{
+	while (true)
+	{
+		RecordedCollection collection;
+		{
+			std::unique_lock lock(_mutex);
+			_collectionQueued.wait(lock, [this]() { return _terminating || !_queue.empty(); });
+			// Collections queued before stopping are still applied, lookups would wait for them forever otherwise
+			if (_queue.empty())
+				return;
+
+			collection = std::move(_queue.front());
+			_queue.pop_front();
+			_applying = true;
+		}
+
+		Apply(collection);
+
+		{
+			std::lock_guard guard(_mutex);
+			_applying = false;
+		}
+		_collectionApplied.notify_all();
+	}
+}
\ No newline at end of file
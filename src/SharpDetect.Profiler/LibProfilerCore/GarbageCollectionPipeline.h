@@ -0,0 +1,93 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "cor.h"
+#include "corprof.h"
+
+#include "GarbageCollectionContext.h"
+#include "ObjectsTracker.h"
+
+namespace LibProfiler
+{
+	// Feeds GC callbacks into the objects tracker, either right away or deferred past the GC pause
+	// Deferred callbacks only copy the reported ranges, a background thread replays them once the GC finishes
+	class GarbageCollectionPipeline
+	{
+	public:
+		// Run on the thread applying the GC in the order of their declaration, lookups of the tracker resume once the last one returns
+		struct Callbacks
+		{
+			// Finalization queued objects translated as they were before the GC, untracked ones are left out
+			std::function<void(std::vector<TrackedObjectId>& finalizationQueuedObjects)> applying;
+			// Objects that did not survive the GC, streamed in chunks while the tracker finishes it
+			GarbageCollectionContext::TrackedObjectIdsVisitor collected;
+			std::function<void(UINT oldTrackedObjectsCount, UINT newTrackedObjectsCount)> applied;
+		};
+
+		GarbageCollectionPipeline(ObjectsTracker& tracker, bool deferred, std::size_t collectedChunkSize, Callbacks callbacks);
+		~GarbageCollectionPipeline();
+		GarbageCollectionPipeline(const GarbageCollectionPipeline&) = delete;
+		GarbageCollectionPipeline& operator=(const GarbageCollectionPipeline&) = delete;
+
+		// Must be called from the GC callbacks of the runtime, in the order it issues them
+		void ProcessGarbageCollectionStarted(std::vector<BOOL>&& collectedGenerations, std::vector<COR_PRF_GC_GENERATION_RANGE>&& bounds);
+		void ProcessSurvivingReferences(std::span<ObjectID> starts, std::span<SIZE_T> lengths);
+		void ProcessMovingReferences(std::span<ObjectID> oldStarts, std::span<ObjectID> newStarts, std::span<SIZE_T> lengths);
+		void ProcessGarbageCollectionFinished(std::vector<ObjectID>&& finalizationQueuedObjects);
+		// Blocks until every finished GC was applied to the tracker
+		void Flush();
+		// Applies the remaining GCs and stops the background thread, later GCs are applied on the GC thread
+		void Stop();
+
+	private:
+		// Surviving references have no new starts
+		struct ReferencesBatch
+		{
+			std::vector<ObjectID> oldStarts;
+			std::vector<ObjectID> newStarts;
+			std::vector<SIZE_T> lengths;
+		};
+
+		struct RecordedCollection
+		{
+			std::vector<BOOL> collectedGenerations;
+			std::vector<COR_PRF_GC_GENERATION_RANGE> bounds;
+			std::vector<ReferencesBatch> batches;
+			// Not translated inside the GC pause, the tracker reaches the state before the GC only once the earlier ones are applied
+			std::vector<ObjectID> finalizationQueuedObjects;
+		};
+
+		void Apply(RecordedCollection& collection);
+		void Finish(std::vector<TrackedObjectId>& finalizationQueuedObjects);
+		void WorkerLoop();
+
+		ObjectsTracker& _tracker;
+		const std::size_t _collectedChunkSize;
+		Callbacks _callbacks;
+		// GC being reported by the runtime, touched only by GC callbacks
+		// Server GC may report references from several GC threads at once
+		std::mutex _recordingMutex;
+		std::optional<RecordedCollection> _recording;
+		std::mutex _mutex;
+		std::condition_variable _collectionQueued;
+		std::condition_variable _collectionApplied;
+		std::deque<RecordedCollection> _queue;
+		// Taken off the queue, but not applied yet
+		bool _applying;
+		const bool _deferred;
+		bool _terminating;
+		std::thread _thread;
+	};
+}
\ No newline at end of file
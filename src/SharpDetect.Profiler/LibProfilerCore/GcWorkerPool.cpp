@@ -0,0 +1,103 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+
+#include "GcWorkerPool.h"
+
+LibProfiler::GcWorkerPool::GcWorkerPool(const std::size_t additionalWorkersCount) :
+	_task(nullptr),
+	_tasksCount(0),
+	_nextTask(0),
+	_activeWorkers(0),
+	_round(0),
+	_terminating(false)
+{
+	_threads.reserve(additionalWorkersCount);
+	for (std::size_t i = 0; i < additionalWorkersCount; ++i)
+		_threads.emplace_back(&LibProfiler::GcWorkerPool::WorkerLoop, this, i + 1);
+}
+
+LibProfiler::GcWorkerPool::~GcWorkerPool()
+{
+	{
+		std::lock_guard guard(_mutex);
+		_terminating = true;
+	}
+	_workAvailable.notify_all();
+
+	for (auto& thread : _threads)
+	{
+		if (thread.joinable())
+			thread.join();
+	}
+}
+
+std::size_t LibProfiler::GcWorkerPool::GetDefaultAdditionalWorkersCount()
+{
+	// Beyond a handful of workers the merge at the end of the GC dominates
+	constexpr std::size_t maxWorkersCount = 8;
+	const auto hardwareConcurrency = static_cast<std::size_t>(std::thread::hardware_concurrency());
+	return std::clamp<std::size_t>(hardwareConcurrency, 1, maxWorkersCount) - 1;
+}
+
+void LibProfiler::GcWorkerPool::Run(const std::size_t tasksCount, const Task& task)
+{
+	if (tasksCount == 0)
+		return;
+
+	if (_threads.empty() || tasksCount == 1)
+	{
+		for (std::size_t taskIndex = 0; taskIndex < tasksCount; ++taskIndex)
+			task(0, taskIndex);
+		return;
+	}
+
+	{
+		std::lock_guard guard(_mutex);
+		_task = &task;
+		_tasksCount = tasksCount;
+		_nextTask.store(0, std::memory_order_relaxed);
+		_activeWorkers = _threads.size();
+		++_round;
+	}
+	_workAvailable.notify_all();
+
+	ExecuteTasks(0);
+
+	std::unique_lock lock(_mutex);
+	_workCompleted.wait(lock, [this]() { return _activeWorkers == 0; });
+	_task = nullptr;
+}
+
+void LibProfiler::GcWorkerPool::ExecuteTasks(const std::size_t workerIndex)
+{
+	for (auto taskIndex = _nextTask.fetch_add(1, std::memory_order_relaxed);
+		taskIndex < _tasksCount;
+		taskIndex = _nextTask.fetch_add(1, std::memory_order_relaxed))
+	{
+		(*_task)(workerIndex, taskIndex);
+	}
+}
+
+void LibProfiler::GcWorkerPool::WorkerLoop(const std::size_t workerIndex)
+{
+	UINT64 lastRound = 0;
+	while (true)
+	{
+		{
+			std::unique_lock lock(_mutex);
+			_workAvailable.wait(lock, [this, lastRound]() { return _terminating || _round != lastRound; });
+			if (_terminating)
+				return;
+
+			lastRound = _round;
+		}
+
+		ExecuteTasks(workerIndex);
+
+		std::lock_guard guard(_mutex);
+		if (--_activeWorkers == 0)
+			_workCompleted.notify_one();
+	}
+}
\ No newline at end of file
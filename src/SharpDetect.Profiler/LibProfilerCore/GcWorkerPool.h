@@ -0,0 +1,52 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cor.h"
+
+namespace LibProfiler
+{
+	// Fork-join helper for splitting work done while the runtime is suspended for a GC
+	class GcWorkerPool
+	{
+	public:
+		using Task = std::function<void(std::size_t workerIndex, std::size_t taskIndex)>;
+
+		// The calling thread participates as well, so zero additional workers means serial execution
+		explicit GcWorkerPool(std::size_t additionalWorkersCount);
+		~GcWorkerPool();
+		GcWorkerPool(const GcWorkerPool&) = delete;
+		GcWorkerPool& operator=(const GcWorkerPool&) = delete;
+		GcWorkerPool(GcWorkerPool&&) = delete;
+		GcWorkerPool& operator=(GcWorkerPool&&) = delete;
+
+		[[nodiscard]] static std::size_t GetDefaultAdditionalWorkersCount();
+		[[nodiscard]] std::size_t GetWorkersCount() const { return _threads.size() + 1; }
+		// Blocks until the task was executed for every task index, must not be called concurrently
+		void Run(std::size_t tasksCount, const Task& task);
+
+	private:
+		void ExecuteTasks(std::size_t workerIndex);
+		void WorkerLoop(std::size_t workerIndex);
+
+		std::vector<std::thread> _threads;
+		std::mutex _mutex;
+		std::condition_variable _workAvailable;
+		std::condition_variable _workCompleted;
+		const Task* _task;
+		std::size_t _tasksCount;
+		std::atomic<std::size_t> _nextTask;
+		std::size_t _activeWorkers;
+		UINT64 _round;
+		bool _terminating;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <utility>
+
+#include "ObjectIdBuffer.h"
+
+LibProfiler::ObjectIdBuffer::ObjectIdBuffer() :
+	_head(new Segment())
+{
+}
+
+LibProfiler::ObjectIdBuffer::~ObjectIdBuffer()
+{
+	auto segment = _head.load(std::memory_order_acquire);
+	while (segment != nullptr)
+		delete std::exchange(segment, segment->next);
+}
+
+void LibProfiler::ObjectIdBuffer::Drain(std::vector<ObjectID>& objectIds)
+{
+	auto segment = _head.load(std::memory_order_acquire);
+	for (auto current = segment; current != nullptr; current = current->next)
+	{
+		const auto count = std::min(current->count.load(std::memory_order_acquire), SegmentCapacity);
+		for (std::size_t index = 0; index < count; index++)
+			objectIds.push_back(current->objectIds[index].load(std::memory_order_acquire));
+	}
+
+	// Keep the newest segment for the next round, older ones are only needed for bursts
+	auto older = std::exchange(segment->next, nullptr);
+	while (older != nullptr)
+		delete std::exchange(older, older->next);
+	segment->count.store(0, std::memory_order_release);
+}
+
+LibProfiler::ObjectIdBuffer::Segment* LibProfiler::ObjectIdBuffer::Grow(Segment* full)
+{
+	auto segment = std::make_unique<Segment>();
+	segment->next = full;
+	auto expected = full;
+	if (_head.compare_exchange_strong(expected, segment.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+		return segment.release();
+
+	// Another producer installed a segment first
+	return expected;
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "cor.h"
+#include "corprof.h"
+
+namespace LibProfiler
+{
+	// Lock-free multi-producer buffer of object addresses, drained once all producers are done
+	// Meant for GC callbacks, which may run on several GC threads at once
+	class ObjectIdBuffer
+	{
+	public:
+		ObjectIdBuffer();
+		~ObjectIdBuffer();
+		ObjectIdBuffer(const ObjectIdBuffer&) = delete;
+		ObjectIdBuffer& operator=(const ObjectIdBuffer&) = delete;
+
+		void Append(const ObjectID objectId)
+		{
+			auto segment = _head.load(std::memory_order_acquire);
+			while (true)
+			{
+				const auto index = segment->count.fetch_add(1, std::memory_order_relaxed);
+				if (index < SegmentCapacity)
+				{
+					segment->objectIds[index].store(objectId, std::memory_order_release);
+					return;
+				}
+
+				segment = Grow(segment);
+			}
+		}
+		// Moves the appended addresses (in no particular order) to the given vector
+		// Must not run concurrently with Append
+		void Drain(std::vector<ObjectID>& objectIds);
+
+	private:
+		static constexpr std::size_t SegmentCapacity = 4096;
+
+		struct Segment
+		{
+			// Claimed slots, may exceed the capacity when appends race for a new segment
+			std::atomic<std::size_t> count { 0 };
+			Segment* next { nullptr };
+			std::array<std::atomic<ObjectID>, SegmentCapacity> objectIds;
+		};
+
+		// Installs a new segment in front of the full one, returns the segment to retry with
+		[[nodiscard]] Segment* Grow(Segment* full);
+
+		// Newest segment first, the buffer owns the whole list
+		std::atomic<Segment*> _head;
+	};
+}
\ No newline at end of file
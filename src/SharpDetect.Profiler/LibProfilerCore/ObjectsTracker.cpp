@@ -1,7 +1,14 @@
 // Copyright 2026 Andrej Čižmárik and Contributors
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
+#include <array>
+#include <functional>
 #include <exception>
+#include <iterator>
+#include <numeric>
+#include <thread>
+#include <utility>
 
 #include "../lib/loguru/loguru.hpp"
 
@@ -11,23 +18,28 @@
 
 namespace
 {
-    constexpr std::size_t TrackedObjectCacheSize = 256;
-
-    struct TrackedObjectCacheEntry
+    // Lookup cache of the thread, its entries are valid for a single tracker within a single GC epoch
+    // Trivially destructible, so that the lookup hot path does not go through a thread-local initialization guard
+    struct ThreadCacheBinding
     {
-        ObjectID objectId;
-        LibProfiler::TrackedObjectId trackedObjectId;
+        UINT64 trackerId;
+        UINT64 epoch;
+        LibProfiler::TrackedObjectCache* cache;
     };
 
-    // Per-thread direct-mapped lookup cache. Valid only within a single GC epoch.
-    struct TrackedObjectCache
+    thread_local ThreadCacheBinding threadCacheBinding { };
+    // Releases the cache (and its counters) once the thread exits
+    thread_local std::unique_ptr<LibProfiler::TrackedObjectCache> threadCache;
+
+    bool IsInBounds(const std::vector<COR_PRF_GC_GENERATION_RANGE>& sortedBounds, const ObjectID objectId)
     {
-        UINT64 epoch;
-        const void* owner;
-        TrackedObjectCacheEntry entries[TrackedObjectCacheSize];
-    };
+        const auto bound = std::ranges::upper_bound(sortedBounds, objectId, std::less { }, &COR_PRF_GC_GENERATION_RANGE::rangeStart);
+        return bound != sortedBounds.cbegin() && objectId < std::prev(bound)->rangeStart + std::prev(bound)->rangeLength;
+    }
 
-    thread_local TrackedObjectCache trackedObjectCache { };
+    // Spreads threads across the snapshot reader counters
+    std::atomic<std::size_t> nextReaderSlot { 0 };
+    thread_local const std::size_t readerSlot = nextReaderSlot.fetch_add(1, std::memory_order_relaxed);
 }
 
 namespace LibProfiler
@@ -35,21 +47,154 @@ namespace LibProfiler
     void ObjectsTracker::ProcessGarbageCollectionStarted(std::vector<BOOL>&& collectedGenerations, std::vector<COR_PRF_GC_GENERATION_RANGE>&& bounds)
     {
         std::lock_guard guard(_allocationMutex);
-        _gcContext = GarbageCollectionContext(_allocations, std::move(collectedGenerations), std::move(bounds));
+        const auto& snapshot = *_snapshots[_gcEpoch.load(std::memory_order_relaxed) & 1];
+
+        // Hand objects tracked since the last GC over to this GC, lookups keep finding them until it finishes
+        std::size_t recentAllocationsCount = 0;
+        for (auto& shard : _shards)
+        {
+            std::lock_guard shardGuard(shard.mutex);
+            // The previous GC left the merging table empty
+            std::swap(shard.objects, shard.merging);
+            recentAllocationsCount += shard.merging.GetSize();
+        }
+
+        // Copies below are as large as the tracked heap, each of them is released as soon as it is merged
+        // Merging tables are modified only by GC callbacks, so they can be read without locking the shards
+        std::vector<TrackedObjectEntry> recentAllocations;
+        recentAllocations.reserve(recentAllocationsCount);
+        for (const auto& shard : _shards)
+            shard.merging.ForEach([&](const TrackedObjectEntry& entry) { recentAllocations.push_back(entry); });
+        std::ranges::sort(recentAllocations, std::less { }, &TrackedObjectEntry::objectId);
+
+        std::vector<TrackedObjectEntry> unclassifiedAllocations;
+        if (snapshot.survivors != nullptr)
+        {
+            unclassifiedAllocations.reserve(snapshot.survivors->size() + recentAllocations.size());
+            std::ranges::merge(*snapshot.survivors, recentAllocations, std::back_inserter(unclassifiedAllocations),
+                std::less { }, &TrackedObjectEntry::objectId, &TrackedObjectEntry::objectId);
+            recentAllocations = { };
+        }
+        else
+        {
+            unclassifiedAllocations = std::move(recentAllocations);
+        }
+
+        // Assign objects that arrived since the last GC to the generation they currently reside in
+        std::ranges::sort(bounds, std::less { }, &COR_PRF_GC_GENERATION_RANGE::rangeStart);
+        // Objects outside of all generations fall into the last bucket, no surviving / moving reference will ever cover them
+        const auto classify = [&](const auto& visitor)
+        {
+            auto bound = bounds.cbegin();
+            for (const auto& entry : unclassifiedAllocations)
+            {
+                while (bound != bounds.cend() && bound->rangeStart + bound->rangeLength <= entry.objectId)
+                    ++bound;
+
+                const auto inBounds = bound != bounds.cend() && bound->rangeStart <= entry.objectId && bound->generation < GenerationsCount;
+                visitor(inBounds ? static_cast<std::size_t>(bound->generation) : GenerationsCount, entry);
+            }
+        };
+
+        const auto isCollected = [&](const std::size_t generation)
+        {
+            return generation < collectedGenerations.size() && collectedGenerations[generation];
+        };
+
+        // Buckets are sized upfront, growing them would temporarily need twice as much memory
+        std::array<std::size_t, GenerationsCount + 1> classifiedCounts { };
+        classify([&](const std::size_t bucket, const TrackedObjectEntry&) { classifiedCounts[bucket]++; });
+        std::size_t collectedHeapCount = classifiedCounts[GenerationsCount];
+        std::array<std::vector<TrackedObjectEntry>, GenerationsCount> classified;
+        for (std::size_t generation = 0; generation < GenerationsCount; generation++)
+        {
+            const auto& current = snapshot.generations[generation];
+            if (isCollected(generation))
+                collectedHeapCount += classifiedCounts[generation] + (current != nullptr ? current->size() : 0);
+            else
+                classified[generation].reserve(classifiedCounts[generation]);
+        }
+
+        // Objects of collected generations go straight into the (address-ordered) collected heap
+        std::vector<TrackedObjectEntry> collectedHeap;
+        collectedHeap.reserve(collectedHeapCount);
+        classify([&](const std::size_t bucket, const TrackedObjectEntry& entry)
+        {
+            if (bucket < GenerationsCount && !isCollected(bucket))
+                classified[bucket].push_back(entry);
+            else
+                collectedHeap.push_back(entry);
+        });
+        unclassifiedAllocations = { };
+
+        // Objects in uncollected generations are carried over without being visited
+        for (std::size_t generation = 0; generation < GenerationsCount; generation++)
+        {
+            const auto& current = snapshot.generations[generation];
+            if (isCollected(generation))
+            {
+                if (current != nullptr)
+                    MergeTrackedObjects(collectedHeap, *current);
+                _nextGenerations[generation] = nullptr;
+            }
+            else if (!classified[generation].empty())
+            {
+                // The published snapshot keeps sharing the current partition, so it is copied before being extended
+                std::vector<TrackedObjectEntry> objects;
+                objects.reserve((current != nullptr ? current->size() : 0) + classified[generation].size());
+                if (current != nullptr)
+                    objects.assign(current->cbegin(), current->cend());
+                MergeTrackedObjects(objects, classified[generation]);
+                classified[generation] = { };
+                _nextGenerations[generation] = std::make_shared<const std::vector<TrackedObjectEntry>>(std::move(objects));
+            }
+            else
+            {
+                _nextGenerations[generation] = current;
+            }
+        }
+
+        // Objects in uncollected generations neither move nor die, cached translations of them stay valid
+        _nextRetainedBounds.clear();
+        std::ranges::copy_if(bounds, std::back_inserter(_nextRetainedBounds), [&](const COR_PRF_GC_GENERATION_RANGE& bound)
+        {
+            return bound.generation < GenerationsCount && !isCollected(bound.generation);
+        });
+
+        _gcContext = GarbageCollectionContext(std::move(collectedHeap), &_gcWorkers);
     }
 
-    GarbageCollectionContext ObjectsTracker::ProcessGarbageCollectionFinished()
+    GarbageCollectionContext ObjectsTracker::ProcessGarbageCollectionFinished(
+        const std::size_t chunkSize,
+        const GarbageCollectionContext::TrackedObjectIdsVisitor& collectedVisitor)
     {
         std::lock_guard guard(_allocationMutex);
-        const auto gcPreviousTrackedObjectsCount = _gcContext.value().GetPreviousTrackedObjects().size();
-        const auto gcNextTrackedObjectsCount = _gcContext.value().GetNextTrackedObjects().size();
-        LOG_F(INFO, "GC removed %" SIZE_FORMAT " tracked objects.", gcPreviousTrackedObjectsCount - gcNextTrackedObjectsCount);
+        auto& gcContext = _gcContext.value();
+        gcContext.Finish(chunkSize, collectedVisitor);
+        LOG_F(INFO, "GC removed %" SIZE_FORMAT " tracked objects (examined %" SIZE_FORMAT " in collected generations).",
+            gcContext.GetCollectedObjectsCount(), gcContext.GetExaminedObjectsCount());
+
+        // Survivors may have been promoted, their generation is resolved when the next GC starts
+        auto snapshot = std::make_unique<HeapSnapshot>();
+        snapshot->generations = std::exchange(_nextGenerations, { });
+        snapshot->retainedBounds = std::move(_nextRetainedBounds);
+        snapshot->survivors = std::make_shared<const std::vector<TrackedObjectEntry>>(gcContext.TakeHeap());
+        snapshot->count = snapshot->survivors->size();
+        for (const auto& objects : snapshot->generations)
+            snapshot->count += objects != nullptr ? objects->size() : 0;
+        const auto trackedObjectsCount = snapshot->count;
+        PublishSnapshot(std::move(snapshot));
+
+        // Objects handed over to this GC are found in the published snapshot from now on
+        for (auto& shard : _shards)
+        {
+            std::lock_guard shardGuard(shard.mutex);
+            shard.merging.Clear();
+        }
 
-        _allocations = _gcContext.value().GetHeap();
-        _gcEpoch.fetch_add(1, std::memory_order_release);
         auto gcContextCopy = std::move(_gcContext.value());
         _gcContext.reset();
-        LOG_F(INFO, "GC finished. Currently tracked objects count=%" SIZE_FORMAT ".", _allocations.size());
+        LOG_F(INFO, "GC finished. Currently tracked objects count=%" SIZE_FORMAT ".", trackedObjectsCount);
         return gcContextCopy;
     }
 
@@ -69,48 +214,388 @@ namespace LibProfiler
     }
 
     TrackedObjectId ObjectsTracker::GetTrackedObject(ObjectID objectId) {
-        auto& cache = trackedObjectCache;
+        if (_deferredCollections.load(std::memory_order_acquire) != 0)
+            WaitForDeferredGarbageCollections();
+
         const auto epoch = _gcEpoch.load(std::memory_order_acquire);
-        if (cache.epoch != epoch || cache.owner != this)
+        auto& cache = GetThreadCache(epoch);
+        if (const auto cached = cache.Find(objectId))
+            return cached.value();
+
+        auto trackedObjectId = FindInSnapshot(objectId);
+        if (!trackedObjectId.has_value())
         {
-            cache = { };
-            cache.epoch = epoch;
-            cache.owner = this;
+            auto& shard = _shards[GetShardIndex(objectId)];
+            std::lock_guard guard(shard.mutex);
+            trackedObjectId = ResolveInShard(shard, objectId, epoch);
         }
 
-        // ObjectID 0 must not match the zero-initialized empty slots
-        auto& entry = cache.entries[(objectId >> 3) & (TrackedObjectCacheSize - 1)];
-        if (objectId != 0 && entry.objectId == objectId)
-            return entry.trackedObjectId;
+        cache.Insert(objectId, trackedObjectId.value());
+        return trackedObjectId.value();
+    }
+
+    void ObjectsTracker::TranslateMany(const std::span<const ObjectID> objectIds, const std::span<TrackedObjectId> trackedObjectIds) {
+        if (_deferredCollections.load(std::memory_order_acquire) != 0)
+            WaitForDeferredGarbageCollections();
 
-        std::lock_guard<std::mutex> guard(_allocationMutex);
-        auto const it = _allocations.find(objectId);
-        if (it != _allocations.cend())
+        const auto epoch = _gcEpoch.load(std::memory_order_acquire);
+
+        auto& cache = GetThreadCache(epoch);
+
+        // Elements that are neither cached nor in the snapshot, as (shard index, element index)
+        std::vector<std::pair<std::size_t, std::size_t>> misses;
+        std::optional<UINT64> snapshotEpoch;
+        for (std::size_t index = 0; index < objectIds.size(); index++)
         {
-            if (objectId != 0)
-                entry = { objectId, it->second };
-            return it->second;
+            const auto objectId = objectIds[index];
+            if (objectId == 0)
+            {
+                trackedObjectIds[index] = 0;
+                continue;
+            }
+
+            if (const auto cached = cache.Find(objectId))
+            {
+                trackedObjectIds[index] = cached.value();
+                continue;
+            }
+
+            // The whole batch is looked up within a single snapshot visit
+            if (!snapshotEpoch.has_value())
+                snapshotEpoch = EnterSnapshot();
+            if (const auto trackedObjectId = FindInSnapshot(*_snapshots[snapshotEpoch.value() & 1], objectId))
+            {
+                trackedObjectIds[index] = trackedObjectId.value();
+                cache.Insert(objectId, trackedObjectId.value());
+                continue;
+            }
+
+            misses.emplace_back(GetShardIndex(objectId), index);
         }
+        if (snapshotEpoch.has_value())
+            LeaveSnapshot(snapshotEpoch.value());
 
-        static TrackedObjectId lastAssignedTrackedObjectId = 1;
-        auto const newTrackedObjectId = lastAssignedTrackedObjectId++;
-        _allocations.emplace(objectId, newTrackedObjectId);
-        if (objectId != 0)
-            entry = { objectId, newTrackedObjectId };
-        return newTrackedObjectId;
+        // Resolve the rest grouped by shard, every shard is locked at most once
+        std::ranges::sort(misses);
+        for (auto miss = misses.cbegin(); miss != misses.cend();)
+        {
+            const auto shardIndex = miss->first;
+            auto& shard = _shards[shardIndex];
+            std::lock_guard guard(shard.mutex);
+            for (; miss != misses.cend() && miss->first == shardIndex; ++miss)
+            {
+                const auto objectId = objectIds[miss->second];
+                const auto trackedObjectId = ResolveInShard(shard, objectId, epoch);
+                trackedObjectIds[miss->second] = trackedObjectId;
+                cache.Insert(objectId, trackedObjectId);
+            }
+        }
     }
 
     std::optional<TrackedObjectId> ObjectsTracker::TryGetTrackedObject(ObjectID objectId) {
-        std::lock_guard<std::mutex> guard(_allocationMutex);
-        auto const it = _allocations.find(objectId);
-        if (it == _allocations.cend())
-            return std::nullopt;
+        if (_deferredCollections.load(std::memory_order_acquire) != 0)
+            WaitForDeferredGarbageCollections();
+
+        const auto epoch = _gcEpoch.load(std::memory_order_acquire);
+        if (auto trackedObjectId = FindInSnapshot(objectId))
+            return trackedObjectId;
+
+        auto& shard = _shards[GetShardIndex(objectId)];
+        std::lock_guard guard(shard.mutex);
+        if (auto trackedObjectId = FindInShard(shard, objectId))
+            return trackedObjectId;
+        if (_gcEpoch.load(std::memory_order_acquire) != epoch)
+            return FindInSnapshot(objectId);
+        return std::nullopt;
+    }
+
+    void ObjectsTracker::TryTranslateMany(const std::span<const ObjectID> objectIds, std::vector<TrackedObjectId>& trackedObjectIds)
+    {
+        if (objectIds.empty())
+            return;
+
+        if (_deferredCollections.load(std::memory_order_acquire) != 0)
+            WaitForDeferredGarbageCollections();
+
+        TryTranslateManyWithoutWaiting(objectIds, trackedObjectIds);
+    }
+
+    void ObjectsTracker::TryTranslateManyBeforeDeferredGarbageCollection(
+        const std::span<const ObjectID> objectIds,
+        std::vector<TrackedObjectId>& trackedObjectIds)
+    {
+        if (objectIds.empty())
+            return;
 
-        return it->second;
+        TryTranslateManyWithoutWaiting(objectIds, trackedObjectIds);
+    }
+
+    void ObjectsTracker::TryTranslateManyWithoutWaiting(const std::span<const ObjectID> objectIds, std::vector<TrackedObjectId>& trackedObjectIds)
+    {
+        // Objects not found in the snapshot, with the number of them per shard
+        std::vector<ObjectID> misses;
+        std::array<std::size_t, AllocationShardsCount + 1> shardOffsets { };
+        const auto epoch = EnterSnapshot();
+        const auto& snapshot = *_snapshots[epoch & 1];
+        for (const auto objectId : objectIds)
+        {
+            if (const auto trackedObjectId = FindInSnapshot(snapshot, objectId))
+            {
+                trackedObjectIds.push_back(trackedObjectId.value());
+                continue;
+            }
+
+            misses.push_back(objectId);
+            shardOffsets[GetShardIndex(objectId) + 1]++;
+        }
+        LeaveSnapshot(epoch);
+        if (misses.empty())
+            return;
+
+        // Partition the rest by shard (counting sort), every shard is locked at most once
+        std::partial_sum(shardOffsets.cbegin(), shardOffsets.cend(), shardOffsets.begin());
+        std::vector<ObjectID> shardMisses(misses.size());
+        auto shardCursors = shardOffsets;
+        for (const auto objectId : misses)
+            shardMisses[shardCursors[GetShardIndex(objectId)]++] = objectId;
+
+        for (std::size_t shardIndex = 0; shardIndex < AllocationShardsCount; shardIndex++)
+        {
+            if (shardOffsets[shardIndex] == shardOffsets[shardIndex + 1])
+                continue;
+
+            auto& shard = _shards[shardIndex];
+            std::lock_guard guard(shard.mutex);
+            const auto gcFinished = _gcEpoch.load(std::memory_order_acquire) != epoch;
+            for (auto index = shardOffsets[shardIndex]; index < shardOffsets[shardIndex + 1]; index++)
+            {
+                const auto objectId = shardMisses[index];
+                auto trackedObjectId = FindInShard(shard, objectId);
+                if (!trackedObjectId.has_value() && gcFinished)
+                    trackedObjectId = FindInSnapshot(objectId);
+                if (trackedObjectId.has_value())
+                    trackedObjectIds.push_back(trackedObjectId.value());
+            }
+        }
     }
 
     UINT ObjectsTracker::GetTrackedObjectsCount() {
-        std::lock_guard<std::mutex> guard(_allocationMutex);
-        return _allocations.size();
+        std::lock_guard guard(_allocationMutex);
+        auto count = _snapshots[_gcEpoch.load(std::memory_order_relaxed) & 1]->count;
+        for (auto& shard : _shards)
+        {
+            std::lock_guard shardGuard(shard.mutex);
+            count += shard.objects.GetSize() + shard.merging.GetSize();
+        }
+        return count;
+    }
+
+    std::vector<TrackedObjectCacheStatistics> ObjectsTracker::GetCacheStatistics()
+    {
+        std::lock_guard guard(_cacheCountersMutex);
+        FoldReleasedCacheCounters();
+
+        std::vector<TrackedObjectCacheStatistics> statistics;
+        for (const auto& counters : _cacheCounters)
+        {
+            statistics.push_back({
+                counters->osThreadId,
+                counters->hits.load(std::memory_order_relaxed),
+                counters->misses.load(std::memory_order_relaxed),
+                counters->retained.load(std::memory_order_relaxed),
+                counters->dropped.load(std::memory_order_relaxed) });
+        }
+        statistics.push_back(_releasedCacheStatistics);
+        return statistics;
+    }
+
+    TrackedObjectCache& ObjectsTracker::GetThreadCache(const UINT64 epoch)
+    {
+        const auto& binding = threadCacheBinding;
+        if (binding.trackerId == _trackerId && binding.epoch == epoch)
+            return *binding.cache;
+        return BindThreadCache(epoch);
+    }
+
+    TrackedObjectCache& ObjectsTracker::BindThreadCache(const UINT64 epoch)
+    {
+        auto& binding = threadCacheBinding;
+        if (binding.trackerId != _trackerId)
+        {
+            threadCache = std::make_unique<TrackedObjectCache>(_cacheCapacity);
+            binding = { _trackerId, epoch, threadCache.get() };
+
+            std::lock_guard guard(_cacheCountersMutex);
+            // Counters of threads that moved on are folded once the list doubles, it does not grow with thread churn
+            if (_cacheCounters.size() >= std::max<std::size_t>(2 * _cacheCountersFolded, 64))
+            {
+                FoldReleasedCacheCounters();
+                _cacheCountersFolded = _cacheCounters.size();
+            }
+            _cacheCounters.push_back(binding.cache->GetCounters());
+        }
+        else if (binding.epoch != epoch)
+        {
+            RevalidateCache(*binding.cache, binding.epoch, epoch);
+            binding.epoch = epoch;
+        }
+        return *binding.cache;
+    }
+
+    void ObjectsTracker::RevalidateCache(TrackedObjectCache& cache, const UINT64 cacheEpoch, const UINT64 epoch)
+    {
+        // Only the bounds of the last GC are known, caches that missed more GCs start over
+        const auto snapshotEpoch = EnterSnapshot();
+        if (epoch == cacheEpoch + 1 && snapshotEpoch == epoch)
+        {
+            const auto& retainedBounds = _snapshots[snapshotEpoch & 1]->retainedBounds;
+            cache.Retain([&](const ObjectID objectId) { return IsInBounds(retainedBounds, objectId); });
+        }
+        else
+        {
+            cache.Clear();
+        }
+        LeaveSnapshot(snapshotEpoch);
+    }
+
+    void ObjectsTracker::FoldReleasedCacheCounters()
+    {
+        // The list holds the last reference once the thread exited or switched to another tracker
+        std::erase_if(_cacheCounters, [&](const std::shared_ptr<TrackedObjectCacheCounters>& counters)
+        {
+            if (counters.use_count() != 1)
+                return false;
+
+            _releasedCacheStatistics.hits += counters->hits.load(std::memory_order_relaxed);
+            _releasedCacheStatistics.misses += counters->misses.load(std::memory_order_relaxed);
+            _releasedCacheStatistics.retained += counters->retained.load(std::memory_order_relaxed);
+            _releasedCacheStatistics.dropped += counters->dropped.load(std::memory_order_relaxed);
+            return true;
+        });
+    }
+
+    void ObjectsTracker::BeginDeferredGarbageCollection()
+    {
+        std::lock_guard guard(_deferredCollectionsMutex);
+        _deferredCollections.fetch_add(1, std::memory_order_release);
+    }
+
+    void ObjectsTracker::EndDeferredGarbageCollection()
+    {
+        {
+            std::lock_guard guard(_deferredCollectionsMutex);
+            _deferredCollections.fetch_sub(1, std::memory_order_release);
+        }
+        _deferredCollectionsApplied.notify_all();
+    }
+
+    void ObjectsTracker::WaitForDeferredGarbageCollections()
+    {
+        // Neither the snapshot nor the caches know where the GC moved objects to yet
+        std::unique_lock lock(_deferredCollectionsMutex);
+        _deferredCollectionsApplied.wait(lock, [this]() { return _deferredCollections.load(std::memory_order_acquire) == 0; });
+    }
+
+    UINT64 ObjectsTracker::EnterSnapshot()
+    {
+        // Announce the lookup before touching the snapshot, the epoch must not change in between
+        auto& active = _readers[readerSlot % ReaderSlotsCount].active;
+        auto epoch = _gcEpoch.load();
+        while (true)
+        {
+            active[epoch & 1].fetch_add(1);
+            const auto currentEpoch = _gcEpoch.load();
+            if (currentEpoch == epoch)
+                return epoch;
+
+            active[epoch & 1].fetch_sub(1, std::memory_order_release);
+            epoch = currentEpoch;
+        }
+    }
+
+    void ObjectsTracker::LeaveSnapshot(const UINT64 epoch)
+    {
+        _readers[readerSlot % ReaderSlotsCount].active[epoch & 1].fetch_sub(1, std::memory_order_release);
+    }
+
+    std::optional<TrackedObjectId> ObjectsTracker::FindInSnapshot(const ObjectID objectId)
+    {
+        const auto epoch = EnterSnapshot();
+        const auto result = FindInSnapshot(*_snapshots[epoch & 1], objectId);
+        LeaveSnapshot(epoch);
+        return result;
+    }
+
+    std::optional<TrackedObjectId> ObjectsTracker::FindInSnapshot(const HeapSnapshot& snapshot, const ObjectID objectId)
+    {
+        std::optional<TrackedObjectId> result;
+        const auto find = [&](const SortedObjects& objects)
+        {
+            if (objects == nullptr)
+                return false;
+
+            const auto it = std::ranges::lower_bound(*objects, objectId, std::less { }, &TrackedObjectEntry::objectId);
+            if (it == objects->cend() || it->objectId != objectId)
+                return false;
+
+            result = it->trackedObjectId;
+            return true;
+        };
+
+        if (!find(snapshot.survivors))
+        {
+            for (const auto& objects : snapshot.generations)
+            {
+                if (find(objects))
+                    break;
+            }
+        }
+        return result;
+    }
+
+    std::optional<TrackedObjectId> ObjectsTracker::FindInShard(const AllocationShard& shard, const ObjectID objectId)
+    {
+        if (const auto trackedObjectId = shard.objects.Find(objectId))
+            return trackedObjectId;
+        return shard.merging.Find(objectId);
+    }
+
+    TrackedObjectId ObjectsTracker::ResolveInShard(AllocationShard& shard, const ObjectID objectId, const UINT64 epoch)
+    {
+        if (const auto trackedObjectId = FindInShard(shard, objectId))
+            return trackedObjectId.value();
+
+        // A GC may have moved the objects of the shard to a newer snapshot in the meantime
+        if (_gcEpoch.load(std::memory_order_acquire) != epoch)
+        {
+            if (const auto trackedObjectId = FindInSnapshot(objectId))
+                return trackedObjectId.value();
+        }
+
+        const auto trackedObjectId = _currentObjectId.fetch_add(1, std::memory_order_relaxed);
+        shard.objects.Insert(objectId, trackedObjectId);
+        return trackedObjectId;
+    }
+
+    std::size_t ObjectsTracker::GetShardIndex(const ObjectID objectId)
+    {
+        return (objectId >> 3) % AllocationShardsCount;
+    }
+
+    void ObjectsTracker::PublishSnapshot(std::unique_ptr<HeapSnapshot> snapshot)
+    {
+        const auto epoch = _gcEpoch.load(std::memory_order_relaxed);
+        const auto slot = (epoch + 1) & 1;
+
+        // The slot still holds the snapshot replaced by the last GC, lookups that started before it must leave first
+        // They run in preemptive mode and never block, so the runtime suspension does not hold them up
+        for (auto& reader : _readers)
+        {
+            while (reader.active[slot].load(std::memory_order_acquire) != 0)
+                std::this_thread::yield();
+        }
+
+        _snapshots[slot] = std::move(snapshot);
+        _gcEpoch.store(epoch + 1);
     }
 }
\ No newline at end of file
@@ -3,39 +3,144 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <optional>
-#include <unordered_map>
+#include <span>
 #include <vector>
 
 #include "GarbageCollectionContext.h"
+#include "GcWorkerPool.h"
+#include "TrackedObjectCache.h"
 #include "TrackedObjectId.h"
+#include "TrackedObjectTable.h"
 
 namespace LibProfiler
 {
 	class ObjectsTracker
 	{
 	public:
+		static constexpr std::size_t DefaultCacheCapacity = 1024;
+
 		ObjectsTracker()
-			: _currentObjectId({ }), _gcEpoch(0), _allocations({ })
+			: ObjectsTracker(GcWorkerPool::GetDefaultAdditionalWorkersCount())
+		{
+
+		}
+
+		explicit ObjectsTracker(const std::size_t additionalGcWorkersCount, const std::size_t cacheCapacity = DefaultCacheCapacity)
+			: _currentObjectId(1), _gcEpoch(0), _deferredCollections(0), _snapshots { std::make_unique<HeapSnapshot>(), nullptr }, _nextGenerations({ }),
+			_gcWorkers(additionalGcWorkersCount), _trackerId(nextTrackerId.fetch_add(1, std::memory_order_relaxed)), _cacheCapacity(cacheCapacity),
+			_cacheCountersFolded(0), _releasedCacheStatistics({ })
 		{
 
 		}
 
 		void ProcessGarbageCollectionStarted(std::vector<BOOL>&& collectedGenerations, std::vector<COR_PRF_GC_GENERATION_RANGE>&& bounds);
-		[[nodiscard]] GarbageCollectionContext ProcessGarbageCollectionFinished();
+		// Collected objects are visited while the GC is finished, see GarbageCollectionContext::Finish
+		[[nodiscard]] GarbageCollectionContext ProcessGarbageCollectionFinished(
+			std::size_t chunkSize = GarbageCollectionContext::DefaultChunkSize,
+			const GarbageCollectionContext::TrackedObjectIdsVisitor& collectedVisitor = { });
 		void ProcessSurvivingReferences(std::span<ObjectID> starts, std::span<SIZE_T> lengths);
 		void ProcessMovingReferences(std::span<ObjectID> oldStarts, std::span<ObjectID> newStarts, std::span<SIZE_T> lengths);
 		[[nodiscard]] TrackedObjectId GetTrackedObject(ObjectID objectId);
+		// Same as GetTrackedObject for every element, null references translate to 0
+		void TranslateMany(std::span<const ObjectID> objectIds, std::span<TrackedObjectId> trackedObjectIds);
 		[[nodiscard]] std::optional<TrackedObjectId> TryGetTrackedObject(ObjectID objectId);
+		// Same as TryGetTrackedObject for every element, appends identifiers of the tracked ones
+		void TryTranslateMany(std::span<const ObjectID> objectIds, std::vector<TrackedObjectId>& trackedObjectIds);
+		// Same as TryTranslateMany, but does not wait for deferred GCs
+		// Only for the thread applying them, translates against the state before the GC it applies next
+		void TryTranslateManyBeforeDeferredGarbageCollection(std::span<const ObjectID> objectIds, std::vector<TrackedObjectId>& trackedObjectIds);
 		[[nodiscard]] UINT GetTrackedObjectsCount();
+		// Lookup cache counters of every thread using the tracker, the last element sums up threads that stopped using it
+		[[nodiscard]] std::vector<TrackedObjectCacheStatistics> GetCacheStatistics();
+		// Lookups wait while a finished GC is not applied yet (see GarbageCollectionPipeline)
+		void BeginDeferredGarbageCollection();
+		void EndDeferredGarbageCollection();
 
 	private:
+		static constexpr std::size_t GenerationsCount = COR_PRF_GC_PINNED_OBJECT_HEAP + 1;
+		static constexpr std::size_t AllocationShardsCount = 64;
+		static constexpr std::size_t ReaderSlotsCount = 64;
+		// Thread caches tell trackers apart by it, a new tracker may be allocated at the address of a destroyed one
+		static inline std::atomic<UINT64> nextTrackerId { 1 };
+
+		using SortedObjects = std::shared_ptr<const std::vector<TrackedObjectEntry>>;
+
+		// Objects tracked before the last GC finished, never modified once published
+		struct HeapSnapshot
+		{
+			// Partitioned by the generation bounds observed when the last GC started, shared with later snapshots until they change
+			std::array<SortedObjects, GenerationsCount> generations;
+			// Survivors of the last GC, their generation is resolved when the next GC starts
+			SortedObjects survivors;
+			// Bounds of generations the last GC did not collect (sorted by address)
+			std::vector<COR_PRF_GC_GENERATION_RANGE> retainedBounds;
+			std::size_t count { 0 };
+		};
+
+		// Objects tracked since the last GC
+		struct alignas(64) AllocationShard
+		{
+			std::mutex mutex;
+			TrackedObjectTable objects;
+			// Objects handed over to the ongoing GC, visible until it publishes the next snapshot
+			TrackedObjectTable merging;
+		};
+
+		// Lookups in flight per snapshot slot, the slot of a snapshot is the parity of its epoch
+		struct alignas(64) ReaderSlot
+		{
+			std::array<std::atomic<UINT64>, 2> active;
+		};
+
+		void WaitForDeferredGarbageCollections();
+		void TryTranslateManyWithoutWaiting(std::span<const ObjectID> objectIds, std::vector<TrackedObjectId>& trackedObjectIds);
+		// Lookups in between see the same snapshot, even if a GC publishes a newer one
+		[[nodiscard]] UINT64 EnterSnapshot();
+		void LeaveSnapshot(UINT64 epoch);
+		[[nodiscard]] std::optional<TrackedObjectId> FindInSnapshot(ObjectID objectId);
+		[[nodiscard]] static std::optional<TrackedObjectId> FindInSnapshot(const HeapSnapshot& snapshot, ObjectID objectId);
+		[[nodiscard]] static std::optional<TrackedObjectId> FindInShard(const AllocationShard& shard, ObjectID objectId);
+		// Assigns a new identifier if the object is not tracked yet, the shard must be locked
+		[[nodiscard]] TrackedObjectId ResolveInShard(AllocationShard& shard, ObjectID objectId, UINT64 epoch);
+		[[nodiscard]] static std::size_t GetShardIndex(ObjectID objectId);
+		void PublishSnapshot(std::unique_ptr<HeapSnapshot> snapshot);
+		// Cache of the calling thread, bound to this tracker and the given epoch
+		[[nodiscard]] TrackedObjectCache& GetThreadCache(UINT64 epoch);
+		[[nodiscard]] TrackedObjectCache& BindThreadCache(UINT64 epoch);
+		// Drops entries of objects the GCs since the cache epoch may have moved or collected
+		void RevalidateCache(TrackedObjectCache& cache, UINT64 cacheEpoch, UINT64 epoch);
+		// Must be called with the cache counters mutex held
+		void FoldReleasedCacheCounters();
+
 		std::optional<GarbageCollectionContext> _gcContext;
 		std::atomic<TrackedObjectId> _currentObjectId;
 		std::atomic<UINT64> _gcEpoch;
-		std::unordered_map<ObjectID, TrackedObjectId> _allocations;
+		// GCs that finished, but were not applied yet
+		std::atomic<UINT> _deferredCollections;
+		std::mutex _deferredCollectionsMutex;
+		std::condition_variable _deferredCollectionsApplied;
+		// The current snapshot and the one it replaced, which lookups started before the last GC may still be reading
+		std::array<std::unique_ptr<HeapSnapshot>, 2> _snapshots;
+		std::array<ReaderSlot, ReaderSlotsCount> _readers;
+		std::array<AllocationShard, AllocationShardsCount> _shards;
+		// Partitions of the next snapshot built while a GC is in progress
+		std::array<SortedObjects, GenerationsCount> _nextGenerations;
+		std::vector<COR_PRF_GC_GENERATION_RANGE> _nextRetainedBounds;
+		// Splits large batches of surviving / moving references while the runtime is suspended
+		GcWorkerPool _gcWorkers;
+		// Serializes GC callbacks, lookups never take it
 		std::mutex _allocationMutex;
+		const UINT64 _trackerId;
+		const std::size_t _cacheCapacity;
+		std::mutex _cacheCountersMutex;
+		std::vector<std::shared_ptr<TrackedObjectCacheCounters>> _cacheCounters;
+		std::size_t _cacheCountersFolded;
+		TrackedObjectCacheStatistics _releasedCacheStatistics;
 	};
 }
\ No newline at end of file
@@ -13,6 +13,9 @@
 
 #include <unistd.h>
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
 
 #else
 #error "Unsupported or unrecognized platform!"
@@ -27,6 +30,15 @@ INT LibProfiler::PAL_GetCurrentPid()
 #endif
 }
 
+INT LibProfiler::PAL_GetCurrentTid()
+{
+#ifdef _WIN32
+    return static_cast<INT>(GetCurrentThreadId());
+#else
+    return static_cast<INT>(syscall(SYS_gettid));
+#endif
+}
+
 MODULE_HANDLE LibProfiler::PAL_LoadLibrary(const std::string& libraryPath)
 {
 #ifdef _WIN32
@@ -43,4 +55,92 @@ void* LibProfiler::PAL_LoadSymbolAddress(MODULE_HANDLE libraryHandle, const std:
 #else
     return dlsym(libraryHandle, symbolName.c_str());
 #endif
-}
\ No newline at end of file
+}
+
+bool LibProfiler::PAL_CreateMappedFile(const std::string& path, std::size_t size, PAL_MappedFile& mappedFile)
+{
+#ifdef _WIN32
+    const auto file = CreateFileA(
+        path.c_str(),
+        GENERIC_READ | GENERIC_WRITE,
+        FILE_SHARE_READ,
+        nullptr,
+        CREATE_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    fileSize.QuadPart = static_cast<LONGLONG>(size);
+    const auto mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, fileSize.HighPart, fileSize.LowPart, nullptr);
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    const auto data = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+    if (data == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    mappedFile.data = static_cast<BYTE*>(data);
+    mappedFile.size = size;
+    mappedFile.fileHandle = file;
+    mappedFile.mappingHandle = mapping;
+    return true;
+#else
+    const auto fileDescriptor = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fileDescriptor == -1)
+        return false;
+
+    if (ftruncate(fileDescriptor, static_cast<off_t>(size)) != 0)
+    {
+        close(fileDescriptor);
+        return false;
+    }
+
+    const auto data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+    if (data == MAP_FAILED)
+    {
+        close(fileDescriptor);
+        return false;
+    }
+
+    mappedFile.data = static_cast<BYTE*>(data);
+    mappedFile.size = size;
+    mappedFile.fileDescriptor = fileDescriptor;
+    return true;
+#endif
+}
+
+bool LibProfiler::PAL_CloseMappedFile(PAL_MappedFile& mappedFile, const std::size_t usedSize)
+{
+    if (mappedFile.data == nullptr)
+        return false;
+
+#ifdef _WIN32
+    UnmapViewOfFile(mappedFile.data);
+    CloseHandle(mappedFile.mappingHandle);
+    LARGE_INTEGER fileSize;
+    fileSize.QuadPart = static_cast<LONGLONG>(usedSize);
+    const auto trimmed = SetFilePointerEx(mappedFile.fileHandle, fileSize, nullptr, FILE_BEGIN)
+        && SetEndOfFile(mappedFile.fileHandle);
+    CloseHandle(mappedFile.fileHandle);
+    mappedFile.fileHandle = nullptr;
+    mappedFile.mappingHandle = nullptr;
+#else
+    munmap(mappedFile.data, mappedFile.size);
+    const auto trimmed = ftruncate(mappedFile.fileDescriptor, static_cast<off_t>(usedSize)) == 0;
+    close(mappedFile.fileDescriptor);
+    mappedFile.fileDescriptor = -1;
+#endif
+
+    mappedFile.data = nullptr;
+    mappedFile.size = 0;
+    return trimmed;
+}
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdlib>
 #include <string>
 
@@ -26,9 +27,29 @@
 
 namespace LibProfiler
 {
+	struct PAL_MappedFile
+	{
+		BYTE* data { nullptr };
+		std::size_t size { 0 };
+#ifdef _WIN32
+		PVOID fileHandle { nullptr };
+		PVOID mappingHandle { nullptr };
+#else
+		INT fileDescriptor { -1 };
+#endif
+	};
+
 	INT PAL_GetCurrentPid();
 
+	INT PAL_GetCurrentTid();
+
 	MODULE_HANDLE PAL_LoadLibrary(const std::string& libraryPath);
 
 	void* PAL_LoadSymbolAddress(MODULE_HANDLE libraryHandle, const std::string& symbolName);
+
+	// Creates (or truncates) a file of the given size and maps it for writing
+	bool PAL_CreateMappedFile(const std::string& path, std::size_t size, PAL_MappedFile& mappedFile);
+
+	// Unmaps the file and trims it to the number of bytes actually written
+	bool PAL_CloseMappedFile(PAL_MappedFile& mappedFile, std::size_t usedSize);
 }
\ No newline at end of file
@@ -0,0 +1,114 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <utility>
+
+#include "../lib/loguru/loguru.hpp"
+#include "StackSampler.h"
+#include "StackWalker.h"
+
+LibProfiler::StackSampler::StackSampler(
+	ICorProfilerInfo10* corProfilerInfo,
+	FunctionInfoCache* functionInfoCache,
+	const std::chrono::milliseconds samplingPeriod,
+	const std::chrono::milliseconds reportPeriod,
+	const std::atomic<UINT>& maxFrames,
+	InternCallback intern,
+	ReportCallback report) :
+	_corProfilerInfo(corProfilerInfo),
+	_functionInfoCache(functionInfoCache),
+	_samplingPeriod(samplingPeriod),
+	_reportPeriod(reportPeriod),
+	_maxFrames(maxFrames),
+	_intern(std::move(intern)),
+	_report(std::move(report)),
+	_walks(0),
+	_terminating(false)
+{
+}
+
+LibProfiler::StackSampler::~StackSampler()
+{
+	Stop();
+}
+
+void LibProfiler::StackSampler::Start()
+{
+	if (!_thread.joinable())
+		_thread = std::thread(&LibProfiler::StackSampler::WorkerLoop, this);
+}
+
+void LibProfiler::StackSampler::Stop()
+{
+	{
+		std::lock_guard guard(_mutex);
+		_terminating = true;
+	}
+	_stopRequested.notify_one();
+
+	if (_thread.joinable())
+		_thread.join();
+}
+
+void LibProfiler::StackSampler::SampleAllThreads()
+{
+	std::vector<UINT64> threadIds;
+	std::vector<std::vector<StackFrame>> frames;
+	if (FAILED(StackWalker::CaptureAllStackTraces(_corProfilerInfo, threadIds, frames, _functionInfoCache)))
+		return;
+
+	++_walks;
+	const auto maxFrames = _maxFrames.load(std::memory_order_relaxed);
+	for (const auto& threadFrames : frames)
+	{
+		// Threads without managed frames are not interesting
+		if (threadFrames.empty())
+			continue;
+
+		// Innermost frames are kept, same as for stacks captured on method enter
+		const auto count = std::min<std::size_t>(threadFrames.size(), maxFrames);
+		_framesBlob.clear();
+		for (std::size_t index = 0; index < count; ++index)
+			StackWalker::AppendFrame(_framesBlob, threadFrames[index].ModuleId, threadFrames[index].MethodToken);
+
+		++_histogram[_intern(_framesBlob)];
+	}
+}
+
+void LibProfiler::StackSampler::Report()
+{
+	if (_walks == 0)
+		return;
+
+	_report(_histogram, _walks);
+	_histogram.clear();
+	_walks = 0;
+}
+
+void LibProfiler::StackSampler::WorkerLoop()
+{
+	auto nextSample = std::chrono::steady_clock::now() + _samplingPeriod;
+	auto nextReport = std::chrono::steady_clock::now() + _reportPeriod;
+	while (true)
+	{
+		{
+			std::unique_lock lock(_mutex);
+			if (_stopRequested.wait_until(lock, nextSample, [this]() { return _terminating; }))
+				break;
+		}
+
+		SampleAllThreads();
+		// Slow walks skip samplings instead of catching up with a burst of them
+		const auto now = std::chrono::steady_clock::now();
+		nextSample = std::max(nextSample + _samplingPeriod, now);
+
+		if (now >= nextReport)
+		{
+			Report();
+			nextReport = now + _reportPeriod;
+		}
+	}
+
+	Report();
+}
\ No newline at end of file
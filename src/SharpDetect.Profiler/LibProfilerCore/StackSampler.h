@@ -0,0 +1,71 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "cor.h"
+#include "corprof.h"
+
+#include "FunctionInfoCache.h"
+
+namespace LibProfiler
+{
+	// Periodically walks all managed threads and counts how often each stack was seen
+	// Only the aggregated counts leave the sampler, once per report period
+	class StackSampler
+	{
+	public:
+		// Returns the id of the given frames blob, equal stacks must receive equal ids
+		using InternCallback = std::function<UINT32(std::span<const BYTE> frames)>;
+		// Receives the number of samples per stack trace id, walks is the number of samplings aggregated
+		using ReportCallback = std::function<void(const std::unordered_map<UINT32, UINT32>& histogram, UINT32 walks)>;
+
+		StackSampler(
+			ICorProfilerInfo10* corProfilerInfo,
+			FunctionInfoCache* functionInfoCache,
+			std::chrono::milliseconds samplingPeriod,
+			std::chrono::milliseconds reportPeriod,
+			const std::atomic<UINT>& maxFrames,
+			InternCallback intern,
+			ReportCallback report);
+		~StackSampler();
+		StackSampler(const StackSampler&) = delete;
+		StackSampler& operator=(const StackSampler&) = delete;
+
+		void Start();
+		// Reports the samples taken since the last report and stops the sampling thread
+		void Stop();
+
+	private:
+		void SampleAllThreads();
+		void Report();
+		void WorkerLoop();
+
+		ICorProfilerInfo10* _corProfilerInfo;
+		FunctionInfoCache* _functionInfoCache;
+		const std::chrono::milliseconds _samplingPeriod;
+		const std::chrono::milliseconds _reportPeriod;
+		// Owned by the caller and read on every walk, so that reconfigured depths apply to sampling as well
+		const std::atomic<UINT>& _maxFrames;
+		InternCallback _intern;
+		ReportCallback _report;
+		// Touched only by the sampling thread
+		std::unordered_map<UINT32, UINT32> _histogram;
+		UINT32 _walks;
+		std::vector<BYTE> _framesBlob;
+		std::mutex _mutex;
+		std::condition_variable _stopRequested;
+		bool _terminating;
+		std::thread _thread;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "StackTraceInterner.h"
+
+UINT32 LibProfiler::StackTraceInterner::GetCount() const
+{
+	return _count.load(std::memory_order_relaxed);
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "cor.h"
+
+namespace LibProfiler
+{
+	// Assigns ids to captured stack traces (frames blobs), so that repeating stacks are described only once
+	class StackTraceInterner
+	{
+	public:
+		// Returns the id of the given frames. The first caller to see a stack invokes define(id, frames)
+		// while still holding the lock, so its definition is published before anyone else can use the id
+		// Definitions published before a different discontinuities count (records may have been lost since)
+		// are published again under the same id
+		template<typename TDefine>
+		UINT32 Intern(const std::span<const BYTE> frames, const UINT64 discontinuities, TDefine&& define)
+		{
+			const std::string_view key(reinterpret_cast<const char*>(frames.data()), frames.size());
+			const auto hash = BlobHash { }(key);
+			auto& shard = _shards[hash % ShardsCount];
+
+			std::lock_guard lock(shard.mutex);
+			if (const auto it = shard.entries.find(key); it != shard.entries.end())
+			{
+				if (it->second.publishedDiscontinuities != discontinuities)
+				{
+					std::forward<TDefine>(define)(it->second.id, frames);
+					it->second.publishedDiscontinuities = discontinuities;
+				}
+				return it->second.id;
+			}
+
+			const auto id = _count.fetch_add(1, std::memory_order_relaxed);
+			shard.entries.emplace(std::string(key), Entry { id, discontinuities });
+			std::forward<TDefine>(define)(id, frames);
+			return id;
+		}
+
+		[[nodiscard]] UINT32 GetCount() const;
+
+	private:
+		struct BlobHash
+		{
+			using is_transparent = void;
+
+			std::size_t operator()(const std::string_view blob) const
+			{
+				return std::hash<std::string_view> { }(blob);
+			}
+		};
+
+		struct Entry
+		{
+			UINT32 id;
+			UINT64 publishedDiscontinuities;
+		};
+
+		struct Shard
+		{
+			std::mutex mutex;
+			std::unordered_map<std::string, Entry, BlobHash, std::equal_to<>> entries;
+		};
+
+		static constexpr std::size_t ShardsCount = 64;
+		std::array<Shard, ShardsCount> _shards;
+		std::atomic<UINT32> _count { 0 };
+	};
+}
\ No newline at end of file
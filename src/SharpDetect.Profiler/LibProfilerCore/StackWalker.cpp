@@ -3,6 +3,7 @@
 
 #include <atomic>
 #include <cstring>
+#include <utility>
 
 #ifndef _WIN32
 #include <unwind.h>
@@ -101,13 +102,27 @@ namespace
 		return false;
 	}
 #endif
+
+	HRESULT GetFunctionInfo(
+		ICorProfilerInfo10* corProfilerInfo,
+		FunctionInfoCache* functionInfoCache,
+		const FunctionID functionId,
+		ModuleID& moduleId,
+		mdMethodDef& methodToken)
+	{
+		if (functionInfoCache != nullptr)
+			return functionInfoCache->GetFunctionInfo(corProfilerInfo, functionId, moduleId, methodToken);
+
+		return corProfilerInfo->GetFunctionInfo(functionId, nullptr, &moduleId, &methodToken);
+	}
 }
 
 HRESULT StackWalker::CaptureStackTrace(
 	ICorProfilerInfo10* corProfilerInfo,
 	const ThreadID threadId,
 	std::vector<UINT64>& moduleIds,
-	std::vector<UINT32>& methodTokens)
+	std::vector<UINT32>& methodTokens,
+	FunctionInfoCache* functionInfoCache)
 {
 	if (corProfilerInfo == nullptr)
 	{
@@ -124,8 +139,10 @@ HRESULT StackWalker::CaptureStackTrace(
 		return E_FAIL;
 	}
 
+	const FunctionInfoCache::ReadScope readScope(functionInfoCache);
 	StackWalkContext context { };
 	context.CorProfilerInfo = corProfilerInfo;
+	context.FunctionInfos = functionInfoCache;
 	context.ModuleIds = &moduleIds;
 	context.MethodTokens = &methodTokens;
 
@@ -155,7 +172,48 @@ HRESULT StackWalker::CaptureStackTrace(
 HRESULT StackWalker::CaptureStackTraces(
 	ICorProfilerInfo10* corProfilerInfo,
 	const std::vector<UINT64>& threadIds,
-	std::vector<std::vector<StackFrame>>& frames)
+	std::vector<std::vector<StackFrame>>& frames,
+	std::vector<HRESULT>* threadResults,
+	FunctionInfoCache* functionInfoCache)
+{
+	if (corProfilerInfo == nullptr)
+	{
+		LOG_F(ERROR, "CorProfilerInfo is null.");
+		return E_POINTER;
+	}
+
+	if (FAILED(corProfilerInfo->SuspendRuntime()))
+	{
+		LOG_F(ERROR, "Failed to suspend runtime before capturing stack traces.");
+		return E_FAIL;
+	}
+
+	std::vector<HRESULT> results;
+	const auto overallResult = WalkThreads(corProfilerInfo, threadIds, frames, results, functionInfoCache);
+
+	if (FAILED(corProfilerInfo->ResumeRuntime()))
+	{
+		LOG_F(ERROR, "Failed to resume runtime after capturing stack traces.");
+		return E_FAIL;
+	}
+
+	for (std::size_t index = 0; index < threadIds.size(); ++index)
+	{
+		if (FAILED(results[index]))
+			LOG_F(WARNING, "Failed to capture stack trace for thread %" UINT_PTR_FORMAT ". Error: 0x%x.", threadIds[index], results[index]);
+	}
+
+	if (threadResults != nullptr)
+		*threadResults = std::move(results);
+
+	return overallResult;
+}
+
+HRESULT StackWalker::CaptureAllStackTraces(
+	ICorProfilerInfo10* corProfilerInfo,
+	std::vector<UINT64>& threadIds,
+	std::vector<std::vector<StackFrame>>& frames,
+	FunctionInfoCache* functionInfoCache)
 {
 	if (corProfilerInfo == nullptr)
 	{
@@ -169,9 +227,65 @@ HRESULT StackWalker::CaptureStackTraces(
 		return E_FAIL;
 	}
 
+	// Managed threads can not be created or destroyed until the runtime resumes
+	threadIds.clear();
+	ICorProfilerThreadEnum* threadEnum = nullptr;
+	auto hr = corProfilerInfo->EnumThreads(&threadEnum);
+	if (SUCCEEDED(hr))
+	{
+		ThreadID threadId;
+		while (threadEnum->Next(1, &threadId, nullptr) == S_OK)
+			threadIds.push_back(threadId);
+		threadEnum->Release();
+
+		std::vector<HRESULT> threadResults;
+		WalkThreads(corProfilerInfo, threadIds, frames, threadResults, functionInfoCache);
+
+		// Threads without a managed stack yet (or anymore) are expected to fail
+		std::size_t walked = 0;
+		for (std::size_t index = 0; index < threadIds.size(); ++index)
+		{
+			if (FAILED(threadResults[index]))
+				continue;
+
+			if (walked != index)
+			{
+				threadIds[walked] = threadIds[index];
+				frames[walked] = std::move(frames[index]);
+			}
+			++walked;
+		}
+		threadIds.resize(walked);
+		frames.resize(walked);
+	}
+	else
+	{
+		LOG_F(ERROR, "Failed to enumerate managed threads. Error: 0x%x.", hr);
+		frames.clear();
+	}
+
+	if (FAILED(corProfilerInfo->ResumeRuntime()))
+	{
+		LOG_F(ERROR, "Failed to resume runtime after capturing stack traces.");
+		return E_FAIL;
+	}
+
+	return hr;
+}
+
+HRESULT StackWalker::WalkThreads(
+	ICorProfilerInfo10* corProfilerInfo,
+	const std::vector<UINT64>& threadIds,
+	std::vector<std::vector<StackFrame>>& frames,
+	std::vector<HRESULT>& threadResults,
+	FunctionInfoCache* functionInfoCache)
+{
 	frames.clear();
 	frames.reserve(threadIds.size());
+	threadResults.clear();
+	threadResults.reserve(threadIds.size());
 
+	const FunctionInfoCache::ReadScope readScope(functionInfoCache);
 	HRESULT overallResult = S_OK;
 	for (auto&& threadId : threadIds)
 	{
@@ -180,6 +294,7 @@ HRESULT StackWalker::CaptureStackTraces(
 
 		StackWalkContext context { };
 		context.CorProfilerInfo = corProfilerInfo;
+		context.FunctionInfos = functionInfoCache;
 		context.ModuleIds = &moduleIds;
 		context.MethodTokens = &methodTokens;
 
@@ -191,6 +306,7 @@ HRESULT StackWalker::CaptureStackTraces(
 			nullptr,
 			0);
 
+		threadResults.push_back(hr);
 		if (SUCCEEDED(hr))
 		{
 			std::vector<StackFrame> threadFrames;
@@ -203,19 +319,12 @@ HRESULT StackWalker::CaptureStackTraces(
 		}
 		else
 		{
-			LOG_F(WARNING, "Failed to capture stack trace for thread %" UINT_PTR_FORMAT ". Error: 0x%x.", threadId, hr);
 			// Add empty frame list to maintain order
 			frames.emplace_back();
 			overallResult = hr;
 		}
 	}
 
-	if (FAILED(corProfilerInfo->ResumeRuntime()))
-	{
-		LOG_F(ERROR, "Failed to resume runtime after capturing stack traces.");
-		return E_FAIL;
-	}
-
 	return overallResult;
 }
 
@@ -223,7 +332,8 @@ HRESULT StackWalker::CaptureCurrentStackTrace(
 	ICorProfilerInfo10* corProfilerInfo,
 	const ULONG skipFrames,
 	const ULONG maxFrames,
-	std::vector<BYTE>& framesBlob)
+	std::vector<BYTE>& framesBlob,
+	FunctionInfoCache* functionInfoCache)
 {
 	if (corProfilerInfo == nullptr)
 	{
@@ -233,8 +343,10 @@ HRESULT StackWalker::CaptureCurrentStackTrace(
 
 	framesBlob.clear();
 
+	const FunctionInfoCache::ReadScope readScope(functionInfoCache);
 	CurrentStackWalkContext context { };
 	context.CorProfilerInfo = corProfilerInfo;
+	context.FunctionInfos = functionInfoCache;
 	context.FramesBlob = &framesBlob;
 	context.SkipFrames = skipFrames;
 	context.MaxFrames = maxFrames;
@@ -290,6 +402,14 @@ HRESULT StackWalker::CaptureCurrentStackTrace(
 	return S_OK;
 }
 
+void StackWalker::AppendFrame(std::vector<BYTE>& framesBlob, const UINT64 moduleId, const UINT32 methodToken)
+{
+	BYTE entry[sizeof(UINT64) + sizeof(UINT32)];
+	std::memcpy(entry, &moduleId, sizeof(UINT64));
+	std::memcpy(entry + sizeof(UINT64), &methodToken, sizeof(UINT32));
+	framesBlob.insert(framesBlob.end(), entry, entry + sizeof(entry));
+}
+
 HRESULT STDMETHODCALLTYPE StackWalker::CurrentStackSnapshotCallback(
 	const FunctionID funcId,
 	UINT_PTR ip,
@@ -313,17 +433,10 @@ HRESULT STDMETHODCALLTYPE StackWalker::CurrentStackSnapshotCallback(
 
 	ModuleID moduleId;
 	mdMethodDef methodToken;
-	HRESULT hr = walkContext->CorProfilerInfo->GetFunctionInfo(funcId, nullptr, &moduleId, &methodToken);
+	HRESULT hr = GetFunctionInfo(walkContext->CorProfilerInfo, walkContext->FunctionInfos, funcId, moduleId, methodToken);
 	if (SUCCEEDED(hr))
 	{
-		const auto moduleId64 = moduleId;
-		const auto methodToken32 = methodToken;
-
-		BYTE entry[sizeof(UINT64) + sizeof(UINT32)];
-		std::memcpy(entry, &moduleId64, sizeof(UINT64));
-		std::memcpy(entry + sizeof(UINT64), &methodToken32, sizeof(UINT32));
-		walkContext->FramesBlob->insert(walkContext->FramesBlob->end(), entry, entry + sizeof(entry));
-
+		AppendFrame(*walkContext->FramesBlob, moduleId, methodToken);
 		++walkContext->Appended;
 	}
 	else
@@ -352,7 +465,7 @@ HRESULT STDMETHODCALLTYPE StackWalker::StackSnapshotCallback(
 
 	ModuleID moduleId;
 	mdMethodDef methodToken;
-	HRESULT hr = walkContext->CorProfilerInfo->GetFunctionInfo(funcId, nullptr, &moduleId, &methodToken);
+	HRESULT hr = GetFunctionInfo(walkContext->CorProfilerInfo, walkContext->FunctionInfos, funcId, moduleId, methodToken);
 	if (SUCCEEDED(hr))
 	{
 		walkContext->ModuleIds->push_back(moduleId);
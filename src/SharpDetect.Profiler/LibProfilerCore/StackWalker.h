@@ -5,6 +5,7 @@
 
 #include <vector>
 #include "corprof.h"
+#include "FunctionInfoCache.h"
 
 namespace LibProfiler
 {
@@ -21,23 +22,39 @@ namespace LibProfiler
 			ICorProfilerInfo10* corProfilerInfo,
 			ThreadID threadId,
 			std::vector<UINT64>& moduleIds,
-			std::vector<UINT32>& methodTokens);
+			std::vector<UINT32>& methodTokens,
+			FunctionInfoCache* functionInfoCache = nullptr);
 
 		static HRESULT CaptureStackTraces(
 			ICorProfilerInfo10* corProfilerInfo,
 			const std::vector<UINT64>& threadIds,
-			std::vector<std::vector<StackFrame>>& frames);
+			std::vector<std::vector<StackFrame>>& frames,
+			std::vector<HRESULT>* threadResults = nullptr,
+			FunctionInfoCache* functionInfoCache = nullptr);
+
+		// Walks every managed thread, the threads are enumerated while the runtime is suspended
+		// Threads that could not be walked are left out of threadIds and frames
+		static HRESULT CaptureAllStackTraces(
+			ICorProfilerInfo10* corProfilerInfo,
+			std::vector<UINT64>& threadIds,
+			std::vector<std::vector<StackFrame>>& frames,
+			FunctionInfoCache* functionInfoCache = nullptr);
 
 		static HRESULT CaptureCurrentStackTrace(
 			ICorProfilerInfo10* corProfilerInfo,
 			ULONG skipFrames,
 			ULONG maxFrames,
-			std::vector<BYTE>& framesBlob);
+			std::vector<BYTE>& framesBlob,
+			FunctionInfoCache* functionInfoCache = nullptr);
+
+		// Appends a [u64 moduleId][u32 methodToken] frame
+		static void AppendFrame(std::vector<BYTE>& framesBlob, UINT64 moduleId, UINT32 methodToken);
 
 	private:
 		struct StackWalkContext
 		{
 			ICorProfilerInfo10* CorProfilerInfo;
+			FunctionInfoCache* FunctionInfos;
 			std::vector<UINT64>* ModuleIds;
 			std::vector<UINT32>* MethodTokens;
 		};
@@ -45,6 +62,7 @@ namespace LibProfiler
 		struct CurrentStackWalkContext
 		{
 			ICorProfilerInfo10* CorProfilerInfo;
+			FunctionInfoCache* FunctionInfos;
 			std::vector<BYTE>* FramesBlob;
 			ULONG SkipFrames;
 			ULONG MaxFrames;
@@ -52,6 +70,14 @@ namespace LibProfiler
 			ULONG Appended;
 		};
 
+		// The runtime must be suspended
+		static HRESULT WalkThreads(
+			ICorProfilerInfo10* corProfilerInfo,
+			const std::vector<UINT64>& threadIds,
+			std::vector<std::vector<StackFrame>>& frames,
+			std::vector<HRESULT>& threadResults,
+			FunctionInfoCache* functionInfoCache);
+
 		static HRESULT STDMETHODCALLTYPE StackSnapshotCallback(
 			FunctionID funcId,
 			UINT_PTR ip,
@@ -0,0 +1,35 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <bit>
+
+#include "PAL.h"
+#include "TrackedObjectCache.h"
+
+LibProfiler::TrackedObjectCache::TrackedObjectCache(const std::size_t capacity) :
+	_entries(capacity >= Ways ? std::bit_floor(capacity / Ways) * Ways : 0),
+	_setMask(_entries.size() / Ways - 1),
+	_counters(std::make_shared<TrackedObjectCacheCounters>())
+{
+	_counters->osThreadId = PAL_GetCurrentTid();
+}
+
+void LibProfiler::TrackedObjectCache::Insert(const ObjectID objectId, const TrackedObjectId trackedObjectId)
+{
+	if (objectId == 0 || _entries.empty())
+		return;
+
+	// Evicts the least recently used entry, unless the object is already cached
+	const auto set = GetSet(objectId);
+	auto way = std::size_t { 0 };
+	while (way < Ways - 1 && set[way].objectId != objectId)
+		way++;
+	std::copy_backward(set, set + way, set + way + 1);
+	set[0] = { objectId, trackedObjectId };
+}
+
+void LibProfiler::TrackedObjectCache::Clear()
+{
+	std::ranges::fill(_entries, TrackedObjectEntry { });
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "cor.h"
+
+#include "TrackedObjectId.h"
+
+namespace LibProfiler
+{
+	// Written only by the thread owning the cache, read by anyone
+	struct TrackedObjectCacheCounters
+	{
+		INT osThreadId { 0 };
+		std::atomic<UINT64> hits { 0 };
+		std::atomic<UINT64> misses { 0 };
+		// Entries kept / dropped when the cache was revalidated after a GC
+		std::atomic<UINT64> retained { 0 };
+		std::atomic<UINT64> dropped { 0 };
+	};
+
+	struct TrackedObjectCacheStatistics
+	{
+		// 0 for the sum over threads that no longer use the cache
+		INT osThreadId;
+		UINT64 hits;
+		UINT64 misses;
+		UINT64 retained;
+		UINT64 dropped;
+	};
+
+	// Set-associative cache of tracked object translations used by a single thread
+	class TrackedObjectCache
+	{
+	public:
+		static constexpr std::size_t Ways = 4;
+
+		// Capacity is rounded down to a power of two multiple of Ways, 0 disables the cache
+		explicit TrackedObjectCache(std::size_t capacity);
+
+		[[nodiscard]] std::optional<TrackedObjectId> Find(const ObjectID objectId)
+		{
+			if (objectId != 0 && !_entries.empty())
+			{
+				const auto set = GetSet(objectId);
+				for (std::size_t way = 0; way < Ways; way++)
+				{
+					if (set[way].objectId != objectId)
+						continue;
+
+					const auto entry = set[way];
+					if (way != 0)
+					{
+						std::copy_backward(set, set + way, set + way + 1);
+						set[0] = entry;
+					}
+					Add(_counters->hits, 1);
+					return entry.trackedObjectId;
+				}
+			}
+
+			Add(_counters->misses, 1);
+			return std::nullopt;
+		}
+		void Insert(ObjectID objectId, TrackedObjectId trackedObjectId);
+		// Keeps only entries of objects that the predicate considers unchanged, the rest is dropped
+		template<typename Predicate>
+		void Retain(Predicate&& isValid)
+		{
+			UINT64 retained = 0;
+			UINT64 dropped = 0;
+			for (std::size_t set = 0; set < _entries.size(); set += Ways)
+			{
+				std::size_t writeWay = 0;
+				for (std::size_t way = 0; way < Ways; way++)
+				{
+					const auto entry = _entries[set + way];
+					if (entry.objectId == 0)
+						continue;
+
+					if (isValid(entry.objectId))
+					{
+						_entries[set + writeWay++] = entry;
+						retained++;
+					}
+					else
+					{
+						dropped++;
+					}
+				}
+				for (; writeWay < Ways; writeWay++)
+					_entries[set + writeWay] = { };
+			}
+
+			Add(_counters->retained, retained);
+			Add(_counters->dropped, dropped);
+		}
+		void Clear();
+		[[nodiscard]] std::size_t GetCapacity() const { return _entries.size(); }
+		[[nodiscard]] const std::shared_ptr<TrackedObjectCacheCounters>& GetCounters() const { return _counters; }
+
+	private:
+		// Only the owning thread writes, so the counters do not need atomic read-modify-write
+		static void Add(std::atomic<UINT64>& counter, const UINT64 value)
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+
+		[[nodiscard]] TrackedObjectEntry* GetSet(const ObjectID objectId)
+		{
+			// Fibonacci hashing, hot objects sharing their low address bits still land in different sets
+			const auto hash = static_cast<UINT64>(objectId) * 0x9E3779B97F4A7C15;
+			return _entries.data() + (static_cast<std::size_t>(hash >> 32) & _setMask) * Ways;
+		}
+
+		// Sets of Ways entries, the most recently used entry of a set comes first, empty entries have objectId 0
+		std::vector<TrackedObjectEntry> _entries;
+		std::size_t _setMask;
+		std::shared_ptr<TrackedObjectCacheCounters> _counters;
+	};
+}
\ No newline at end of file
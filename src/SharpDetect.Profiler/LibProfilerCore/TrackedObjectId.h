@@ -3,9 +3,34 @@
 
 #pragma once
 
+#include <algorithm>
+#include <functional>
+#include <vector>
+
 #include "cor.h"
+#include "corprof.h"
 
 namespace LibProfiler
 {
 	using TrackedObjectId = UINT_PTR;
+
+	struct TrackedObjectEntry
+	{
+		ObjectID objectId;
+		TrackedObjectId trackedObjectId;
+	};
+
+	// Merges address-ordered entries into an address-ordered target
+	inline void MergeTrackedObjects(std::vector<TrackedObjectEntry>& target, const std::vector<TrackedObjectEntry>& source)
+	{
+		if (source.empty())
+			return;
+
+		const auto oldSize = static_cast<std::ptrdiff_t>(target.size());
+		target.insert(target.end(), source.cbegin(), source.cend());
+		// Only entries above the lowest merged address need to be shifted
+		const auto middle = target.begin() + oldSize;
+		const auto first = std::ranges::lower_bound(target.begin(), middle, source.front().objectId, std::less { }, &TrackedObjectEntry::objectId);
+		std::ranges::inplace_merge(first, middle, target.end(), std::less { }, &TrackedObjectEntry::objectId);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,70 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+#include "TrackedObjectTable.h"
+
+std::optional<LibProfiler::TrackedObjectId> LibProfiler::TrackedObjectTable::Find(const ObjectID objectId) const
+{
+	if (_size == 0 || objectId == EmptySlot)
+		return std::nullopt;
+
+	const auto mask = _slots.size() - 1;
+	for (auto index = GetSlotIndex(objectId);; index = (index + 1) & mask)
+	{
+		const auto& slot = _slots[index];
+		if (slot.objectId == objectId)
+			return slot.trackedObjectId;
+		if (slot.objectId == EmptySlot)
+			return std::nullopt;
+	}
+}
+
+void LibProfiler::TrackedObjectTable::Insert(const ObjectID objectId, const TrackedObjectId trackedObjectId)
+{
+	if ((_size + 1) * 4 > _slots.size() * 3)
+		Grow();
+
+	const auto mask = _slots.size() - 1;
+	auto index = GetSlotIndex(objectId);
+	while (_slots[index].objectId != EmptySlot)
+		index = (index + 1) & mask;
+
+	_slots[index] = { objectId, trackedObjectId };
+	_size++;
+}
+
+void LibProfiler::TrackedObjectTable::Clear()
+{
+	_slots = { };
+	_size = 0;
+	_shift = 0;
+}
+
+void LibProfiler::TrackedObjectTable::Grow()
+{
+	const auto capacity = std::max(MinCapacity, _slots.size() * 2);
+	auto slots = std::exchange(_slots, std::vector<TrackedObjectEntry>(capacity, { EmptySlot, 0 }));
+	_shift = 64 - std::countr_zero(capacity);
+
+	const auto mask = capacity - 1;
+	for (const auto& slot : slots)
+	{
+		if (slot.objectId == EmptySlot)
+			continue;
+
+		auto index = GetSlotIndex(slot.objectId);
+		while (_slots[index].objectId != EmptySlot)
+			index = (index + 1) & mask;
+		_slots[index] = slot;
+	}
+}
+
+std::size_t LibProfiler::TrackedObjectTable::GetSlotIndex(const ObjectID objectId) const
+{
+	// Fibonacci hashing, objects are aligned so the low bits of their addresses carry little information
+	return static_cast<std::size_t>((static_cast<UINT64>(objectId) * 0x9E3779B97F4A7C15) >> _shift);
+}
\ No newline at end of file
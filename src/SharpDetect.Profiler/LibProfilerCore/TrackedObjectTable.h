@@ -0,0 +1,52 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "cor.h"
+
+#include "TrackedObjectId.h"
+
+namespace LibProfiler
+{
+	// Open-addressing map from object addresses to tracked object identifiers
+	// Entries are stored inline (16 bytes each) instead of in separately allocated nodes
+	class TrackedObjectTable
+	{
+	public:
+		[[nodiscard]] std::optional<TrackedObjectId> Find(ObjectID objectId) const;
+		// The object must not be in the table yet
+		void Insert(ObjectID objectId, TrackedObjectId trackedObjectId);
+		// Releases the slots, objects tracked after a GC are unrelated to the ones before
+		void Clear();
+		[[nodiscard]] std::size_t GetSize() const { return _size; }
+		// Visits entries in no particular order
+		template<typename Visitor>
+		void ForEach(Visitor&& visitor) const
+		{
+			for (const auto& slot : _slots)
+			{
+				if (slot.objectId != EmptySlot)
+					visitor(slot);
+			}
+		}
+
+	private:
+		// Never a valid (aligned) object address
+		static constexpr ObjectID EmptySlot = ~ObjectID { 0 };
+		static constexpr std::size_t MinCapacity = 16;
+
+		void Grow();
+		[[nodiscard]] std::size_t GetSlotIndex(ObjectID objectId) const;
+
+		// Capacity is a power of two, at most 3/4 of the slots are used
+		std::vector<TrackedObjectEntry> _slots;
+		std::size_t _size { 0 };
+		// Selects the top bits of the hash, which index the slots
+		UINT _shift { 0 };
+	};
+}
\ No newline at end of file
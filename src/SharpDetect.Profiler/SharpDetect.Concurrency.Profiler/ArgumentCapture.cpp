@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <cstring>
+#include <span>
+#include <vector>
 
 #include "../lib/loguru/loguru.hpp"
 
@@ -190,12 +192,12 @@ HRESULT Profiler::ArgumentCapture::GetReferenceArrayArgument(
     std::memcpy(writePtr, &elementCount, sizeof(UINT));
     writePtr += sizeof(UINT);
 
-    // Read each element reference and resolve to tracked ID
-    for (UINT i = 0; i < elementCount; i++)
-    {
-        TranslateToTrackedObject(pData + i * sizeof(ObjectID), writePtr);
-        writePtr += elementSize;
-    }
+    // Resolve all element references to tracked IDs in one batch
+    std::vector<LibProfiler::TrackedObjectId> trackedObjectIds(elementCount);
+    _objectsTracker.TranslateMany(
+        std::span(reinterpret_cast<const ObjectID*>(pData), elementCount),
+        std::span(trackedObjectIds));
+    std::memcpy(writePtr, trackedObjectIds.data(), elementCount * elementSize);
 
     // Write offset info
     const UINT argInfo = (argument.index << 16) | totalSize;
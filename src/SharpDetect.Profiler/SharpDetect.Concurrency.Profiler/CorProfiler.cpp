@@ -2,12 +2,14 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <stack>
 #include <string>
 #include <utility>
@@ -30,6 +32,9 @@ Profiler::CorProfiler* ProfilerInstance;
 
 namespace
 {
+    // Upper bound of tracked object ids per GC event, keeps messages and their encoding buffers small
+    constexpr std::size_t TrackedObjectIdsChunkSize = 64 * 1024;
+
     // Per-thread scratch state of the ELT callbacks. Keeping it in a single thread_local object
     // costs one TLS lookup per callback instead of one per buffer
     struct EltThreadScratch
@@ -40,11 +45,48 @@ namespace
         std::vector<BYTE> argumentValues;
         std::vector<BYTE> argumentOffsets;
         std::vector<BYTE> stackFramesBlob;
+        // Hooked methods currently on the stack of the thread (innermost last), kept in shadow stack capture mode
+        std::vector<const Profiler::EltDecision*> shadowStack;
         std::vector<BYTE> returnValue;
         std::vector<char> fixedEventBuffer;
     };
 
     thread_local EltThreadScratch EltScratch;
+
+    Profiler::StackTraceCaptureMode ParseStackTraceCaptureMode(const std::string& value)
+    {
+        if (value == "shadowStack")
+            return Profiler::StackTraceCaptureMode::ShadowStack;
+        if (value != "snapshot")
+            LOG_F(WARNING, "Unknown stack trace capture mode \"%s\", falling back to stack snapshots.", value.c_str());
+        return Profiler::StackTraceCaptureMode::Snapshot;
+    }
+
+    LibIPC::EventSinkOptions CreateEventSinkOptions(const Profiler::Configuration& configuration)
+    {
+        LibIPC::EventSinkOptions options;
+        if (const auto kind = LibIPC::TryParseEventSinkKind(configuration.eventSink))
+            options.kind = kind.value();
+        else
+            LOG_F(WARNING, "Unknown event sink \"%s\", falling back to IPC event queue.", configuration.eventSink.c_str());
+
+        for (const auto& secondary : configuration.secondaryEventSinks)
+        {
+            if (const auto kind = LibIPC::TryParseEventSinkKind(secondary))
+                options.secondaryKinds.push_back(kind.value());
+            else
+                LOG_F(WARNING, "Ignoring unknown secondary event sink \"%s\".", secondary.c_str());
+        }
+        options.secondaryBufferMaxBytes = static_cast<std::size_t>(configuration.secondaryEventSinkBufferSize);
+
+        options.traceFile = LibIPC::TraceFileEndpoint{
+            configuration.traceFilePath.value_or(
+                "SharpDetect.trace." + std::to_string(LibProfiler::PAL_GetCurrentPid())),
+            configuration.traceFileSegmentSize,
+            configuration.traceFileMaxSize};
+        options.socketEndpoint = configuration.socketEndpoint.value_or(std::string());
+        return options;
+    }
 }
 
 Profiler::CorProfiler::CorProfiler(const Configuration &configuration) :
@@ -63,10 +105,32 @@ Profiler::CorProfiler::CorProfiler(const Configuration &configuration) :
         LibIPC::RegistrationEndpoint{
             configuration.registrationQueueName,
             configuration.registrationQueueFile.value_or(std::string()),
-            configuration.registrationQueueSize}),
+            configuration.registrationQueueSize},
+        CreateEventSinkOptions(configuration)),
     _coreModule(0),
     _pid(static_cast<UINT32>(LibProfiler::PAL_GetCurrentPid())),
     _threadIdCacheEpoch(0),
+    _objectsTracker(LibProfiler::GcWorkerPool::GetDefaultAdditionalWorkersCount(), configuration.trackedObjectCacheSize),
+    _gcPipeline(
+        _objectsTracker,
+        configuration.deferGcBookkeeping,
+        TrackedObjectIdsChunkSize,
+        {
+            [this](std::vector<LibProfiler::TrackedObjectId>& finalizationQueuedObjects)
+            {
+                SendGarbageCollectionApplying(finalizationQueuedObjects);
+            },
+            [this](const std::span<const LibProfiler::TrackedObjectId> trackedObjectIds)
+            {
+                SendGarbageCollectedObjects(trackedObjectIds);
+            },
+            [this](const UINT oldTrackedObjectsCount, const UINT newTrackedObjectsCount)
+            {
+                SendGarbageCollectionApplied(oldTrackedObjectsCount, newTrackedObjectsCount);
+            }
+        }),
+    _stackTraceCollectionMaxDepth(configuration.stackTraceCollectionMaxDepth),
+    _stackTraceCaptureMode(ParseStackTraceCaptureMode(configuration.stackTraceCaptureMode)),
     _argumentCapture(_corProfilerInfo, _objectsTracker),
     _typeInjector(
         _corProfilerInfo,
@@ -162,12 +226,38 @@ HRESULT STDMETHODCALLTYPE Profiler::CorProfiler::Initialize(IUnknown* pICorProfi
 
     _client.Send(LibIPC::Helpers::CreateProfilerInitiazeMsg(CreateMetadataMsg()));
     LOG_F(INFO, "Profiler initialized.");
+
+    if (_configuration.stackSamplingPeriod != 0)
+    {
+        _stackSampler.emplace(
+            _corProfilerInfo,
+            &_functionInfoCache,
+            std::chrono::milliseconds(_configuration.stackSamplingPeriod),
+            std::chrono::milliseconds(_configuration.stackSamplingReportPeriod),
+            _stackTraceCollectionMaxDepth,
+            [this](const std::span<const BYTE> frames) { return InternStackTrace(frames); },
+            [this](const std::unordered_map<UINT32, UINT32>& histogram, const UINT32 walks) { SendStackSampleHistogram(histogram, walks); });
+        _stackSampler->Start();
+        LOG_F(INFO, "Started stack sampling every %u ms.", _configuration.stackSamplingPeriod);
+    }
+
     return S_OK;
 }
 
 HRESULT Profiler::CorProfiler::InitializeProfilingFeatures() const
 {
-    auto hr = _corProfilerInfo->SetEventMask(_configuration.eventMask);
+    auto eventMask = _configuration.eventMask;
+    // Re-instrumenting already compiled methods is only possible if ReJIT was requested at startup
+    if (_configuration.enableRuntimeReconfiguration)
+        eventMask |= COR_PRF_MONITOR::COR_PRF_ENABLE_REJIT;
+    // Shadow stacks are balanced by unwind callbacks when frames are removed by exceptions
+    if (_stackTraceCaptureMode == StackTraceCaptureMode::ShadowStack)
+        eventMask |= COR_PRF_MONITOR::COR_PRF_MONITOR_EXCEPTIONS;
+    // Every stack walk resolves frames through the function info cache, its entries must be invalidated
+    // before function ids of an unloaded module get reused
+    eventMask |= COR_PRF_MONITOR::COR_PRF_MONITOR_MODULE_LOADS;
+
+    auto hr = _corProfilerInfo->SetEventMask(eventMask);
     if (FAILED(hr))
     {
         LOG_F(ERROR, "Could not set profiling flags. Error: 0x%x.", hr);
@@ -212,6 +302,25 @@ PROFILER_STUB TailcallStub(const FunctionIDOrClientID functionId, const COR_PRF_
 HRESULT STDMETHODCALLTYPE Profiler::CorProfiler::Shutdown()
 {
     _terminating = true;
+    // Remaining samples and GCs are reported before the client shuts down
+    if (_stackSampler.has_value())
+        _stackSampler->Stop();
+    _gcPipeline.Stop();
+    LOG_F(INFO, "Interned %u distinct stack traces.", _stackTraces.GetCount());
+    LOG_F(INFO, "Cached function info of %zu functions.", _functionInfoCache.GetCount());
+    for (const auto& statistics : _objectsTracker.GetCacheStatistics())
+    {
+        if (statistics.hits + statistics.misses == 0)
+            continue;
+
+        const auto owner = statistics.osThreadId != 0 ? "OS thread " + std::to_string(statistics.osThreadId) : std::string("exited threads");
+        LOG_F(INFO, "Tracked objects cache of %s: %llu hits, %llu misses, %llu entries kept and %llu dropped after GCs.",
+            owner.c_str(),
+            static_cast<unsigned long long>(statistics.hits),
+            static_cast<unsigned long long>(statistics.misses),
+            static_cast<unsigned long long>(statistics.retained),
+            static_cast<unsigned long long>(statistics.dropped));
+    }
     _client.Shutdown();
     return LibProfiler::CorProfilerBase::Shutdown();
 }
@@ -275,57 +384,65 @@ HRESULT STDMETHODCALLTYPE Profiler::CorProfiler::GarbageCollectionStarted(
     }
 
     auto collectedGenerations = std::vector<BOOL>(generationCollected, generationCollected + cGenerations);
-    _objectsTracker.ProcessGarbageCollectionStarted(std::move(collectedGenerations), std::move(ranges));
+    _gcPipeline.ProcessGarbageCollectionStarted(std::move(collectedGenerations), std::move(ranges));
     _client.SendPriority(LibIPC::Helpers::CreateGarbageCollectionStartMsg(CreateMetadataMsg()));
     return S_OK;
 }
 
 HRESULT STDMETHODCALLTYPE Profiler::CorProfiler::FinalizeableObjectQueued(const DWORD finalizerFlags, const ObjectID objectID)
 {
-    if (const auto trackedObjectId = _objectsTracker.TryGetTrackedObject(objectID))
-    {
-        auto guard = std::lock_guard(_finalizationQueuedMutex);
-        _finalizationQueuedTrackedObjects.push_back(*trackedObjectId);
-    }
-
+    // Runs on GC threads for every finalizable object, translation is deferred to GarbageCollectionFinished
+    _finalizationQueuedObjects.Append(objectID);
     return S_OK;
 }
 
 HRESULT STDMETHODCALLTYPE Profiler::CorProfiler::GarbageCollectionFinished()
 {
-    std::vector<UINT64> finalizationQueuedTrackedObjects;
-    {
-        auto guard = std::lock_guard(_finalizationQueuedMutex);
-        finalizationQueuedTrackedObjects.swap(_finalizationQueuedTrackedObjects);
-    }
+    // The pipeline translates the queued addresses against the tracker as it was before the GC
+    // In deferred mode that happens on its own thread, lookups inside the GC pause would wait for the GC itself
+    std::vector<ObjectID> finalizationQueuedObjects;
+    _finalizationQueuedObjects.Drain(finalizationQueuedObjects);
 
-    if (!finalizationQueuedTrackedObjects.empty())
+    // The pipeline may report the GC from its own thread, which is not known to the runtime
     {
-        _client.SendPriority(LibIPC::Helpers::CreateFinalizationQueuedTrackedObjectsMsg(
-            CreateMetadataMsg(),
-            std::move(finalizationQueuedTrackedObjects)));
+        auto guard = std::lock_guard(_gcFinishedMetadataMutex);
+        _gcFinishedMetadata.push_back(CreateMetadataMsg());
     }
+    _gcPipeline.ProcessGarbageCollectionFinished(std::move(finalizationQueuedObjects));
+    return S_OK;
+}
 
-    const auto oldSize = _objectsTracker.GetTrackedObjectsCount();
-    const auto gcContext = _objectsTracker.ProcessGarbageCollectionFinished();
-    auto& nextTrackedObjectIds = gcContext.GetNextTrackedObjects();
-    auto& previousTrackedObjectIds = gcContext.GetPreviousTrackedObjects();
-    std::vector<LibProfiler::TrackedObjectId> removedTrackedObjectIds;
-    for (auto&& previousTrackedObjectId : previousTrackedObjectIds)
+void Profiler::CorProfiler::SendGarbageCollectionApplying(std::vector<LibProfiler::TrackedObjectId>& finalizationQueuedObjects)
+{
     {
-        if (!nextTrackedObjectIds.contains(previousTrackedObjectId))
-            removedTrackedObjectIds.push_back(previousTrackedObjectId);
+        auto guard = std::lock_guard(_gcFinishedMetadataMutex);
+        _gcAppliedMetadata = std::move(_gcFinishedMetadata.front());
+        _gcFinishedMetadata.pop_front();
     }
-    if (!removedTrackedObjectIds.empty())
+
+    // Callbacks arrive in queue order, the payload encoding requires ascending ids
+    std::ranges::sort(finalizationQueuedObjects);
+    const auto duplicates = std::ranges::unique(finalizationQueuedObjects);
+    finalizationQueuedObjects.erase(duplicates.begin(), duplicates.end());
+    for (std::size_t offset = 0; offset < finalizationQueuedObjects.size(); offset += TrackedObjectIdsChunkSize)
     {
-        _client.SendPriority(LibIPC::Helpers::CreateGarbageCollectedTrackedObjectsMsg(
-            CreateMetadataMsg(),
-            std::move(removedTrackedObjectIds)));
+        const auto chunk = std::span<const UINT64>(finalizationQueuedObjects).subspan(
+            offset,
+            std::min(TrackedObjectIdsChunkSize, finalizationQueuedObjects.size() - offset));
+        _client.SendPriority(LibIPC::Helpers::CreateFinalizationQueuedTrackedObjectsMsg(LibIPC::MetadataMsg(_gcAppliedMetadata), chunk));
     }
+}
 
-    const auto newSize = _objectsTracker.GetTrackedObjectsCount();
-    _client.SendPriority(LibIPC::Helpers::CreateGarbageCollectionFinishMsg(CreateMetadataMsg(), oldSize, newSize));
-    return S_OK;
+void Profiler::CorProfiler::SendGarbageCollectedObjects(const std::span<const LibProfiler::TrackedObjectId> trackedObjectIds)
+{
+    // Removed ids are streamed in bounded chunks while the tracker finishes the GC, the sequence is terminated by GarbageCollectionFinish
+    _client.SendPriority(LibIPC::Helpers::CreateGarbageCollectedTrackedObjectsMsg(LibIPC::MetadataMsg(_gcAppliedMetadata), trackedObjectIds));
+}
+
+void Profiler::CorProfiler::SendGarbageCollectionApplied(const UINT oldTrackedObjectsCount, const UINT newTrackedObjectsCount)
+{
+    // Lookups wait until this returns, so no event can refer to the new addresses before the GC is reported
+    _client.SendPriority(LibIPC::Helpers::CreateGarbageCollectionFinishMsg(std::move(_gcAppliedMetadata), oldTrackedObjectsCount, newTrackedObjectsCount));
 }
 
 HRESULT STDMETHODCALLTYPE Profiler::CorProfiler::MovedReferences2(
@@ -334,7 +451,7 @@ HRESULT STDMETHODCALLTYPE Profiler::CorProfiler::MovedReferences2(
     ObjectID newObjectIDRangeStart[], 
     SIZE_T cObjectIDRangeLength[])
 {
-    _objectsTracker.ProcessMovingReferences(
+    _gcPipeline.ProcessMovingReferences(
         std::span(oldObjectIDRangeStart, cMovedObjectIDRanges),
         std::span(newObjectIDRangeStart, cMovedObjectIDRanges),
         std::span(cObjectIDRangeLength, cMovedObjectIDRanges));
@@ -346,7 +463,7 @@ HRESULT STDMETHODCALLTYPE Profiler::CorProfiler::SurvivingReferences2(
     ObjectID objectIDRangeStart[],
     SIZE_T cObjectIDRangeLength[])
 {
-    _objectsTracker.ProcessSurvivingReferences(
+    _gcPipeline.ProcessSurvivingReferences(
         std::span(objectIDRangeStart, cSurvivingObjectIDRanges),
         std::span(cObjectIDRangeLength, cSurvivingObjectIDRanges));
     return S_OK;
@@ -384,7 +501,18 @@ HRESULT STDMETHODCALLTYPE Profiler::CorProfiler::JITCompilationStarted(const Fun
         return E_FAIL;
     }
 
-    PatchMethodBody(moduleDef, mdTypeDef, mdMethodDef);
+    // Only methods that can be instrumented are ReJIT candidates, keep their original IL for rebuilding
+    if (_configuration.enableRuntimeReconfiguration &&
+        _rewriteRegistry.HasModuleInjectedMethods(moduleId) &&
+        !_rewriteRegistry.IsStub(moduleId, mdMethodDef))
+    {
+        LPCBYTE methodBody = nullptr;
+        ULONG methodBodySize = 0;
+        if (SUCCEEDED(_corProfilerInfo->GetILFunctionBody(moduleId, mdMethodDef, &methodBody, &methodBodySize)))
+            _reJitRegistry.AddCompiledMethod(moduleId, mdMethodDef, methodBody, methodBodySize);
+    }
+
+    PatchMethodBody(moduleDef, mdMethodDef);
     _client.Send(LibIPC::Helpers::CreateJitCompilationMsg(CreateMetadataMsg(), mdTypeDef, mdMethodDef));
     return S_OK;
 }
@@ -432,7 +560,24 @@ HRESULT STDMETHODCALLTYPE Profiler::CorProfiler::ModuleLoadFinished(ModuleID mod
     return S_OK;
 }
 
-HRESULT Profiler::CorProfiler::PatchMethodBody(const LibProfiler::ModuleDef& moduleDef, mdTypeDef mdTypeDef, mdMethodDef mdMethodDef)
+HRESULT STDMETHODCALLTYPE Profiler::CorProfiler::ModuleUnloadStarted(const ModuleID moduleId)
+{
+    // Function ids of the module may get reused once it is gone
+    _functionInfoCache.InvalidateModule(moduleId);
+    return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE Profiler::CorProfiler::FunctionUnloadStarted(const FunctionID functionId)
+{
+    _functionInfoCache.InvalidateFunction(functionId);
+    return S_OK;
+}
+
+HRESULT Profiler::CorProfiler::PatchMethodBody(
+    const LibProfiler::ModuleDef& moduleDef,
+    const mdMethodDef mdMethodDef,
+    ICorProfilerFunctionControl* functionControl,
+    const LPCBYTE originalMethodBody)
 {
     // If we are compiling injected method, skip it
     if (_rewriteRegistry.IsStub(moduleDef.GetModuleId(), mdMethodDef))
@@ -455,15 +600,23 @@ HRESULT Profiler::CorProfiler::PatchMethodBody(const LibProfiler::ModuleDef& mod
         tokensToRewrite,
         injectedMethods,
         fieldAccessIntrinsics,
-        _configuration.enableFieldsAccessInstrumentation,
+        _reJitRegistry.IsFieldsAccessInstrumentationEnabled(
+            moduleDef.GetModuleId(),
+            _configuration.enableFieldsAccessInstrumentation),
         _configuration.skipInstrumentationForAssemblies,
         _configuration.enableStackTraceCollection,
-        _configuration.stackTraceCollectionForFields)))
+        _configuration.stackTraceCollectionForFields,
+        functionControl,
+        originalMethodBody)))
     {
-        _client.Send(LibIPC::Helpers::CreateMethodBodyRewriteMsg(
-            CreateMetadataMsg(),
-            moduleDef.GetModuleId(),
-            mdMethodDef));
+        // A ReJIT replaces a body that was already reported when it was first compiled
+        if (functionControl == nullptr)
+        {
+            _client.Send(LibIPC::Helpers::CreateMethodBodyRewriteMsg(
+                CreateMetadataMsg(),
+                moduleDef.GetModuleId(),
+                mdMethodDef));
+        }
 
         return S_OK;
     }
@@ -471,6 +624,36 @@ HRESULT Profiler::CorProfiler::PatchMethodBody(const LibProfiler::ModuleDef& mod
     return E_FAIL;
 }
 
+HRESULT STDMETHODCALLTYPE Profiler::CorProfiler::GetReJITParameters(
+    const ModuleID moduleId,
+    const mdMethodDef methodId,
+    ICorProfilerFunctionControl* pFunctionControl)
+{
+    if (_terminating || !_metadataStore.HasModuleDef(moduleId))
+        return S_OK;
+
+    // Instrumentation is rebuilt from the original IL with the current settings
+    // If nothing gets rewritten, no body is set and the original IL is recompiled
+    const auto moduleDefPtr = _metadataStore.GetModuleDef(moduleId);
+    const auto originalMethodBody = _reJitRegistry.GetOriginalMethodBody(moduleId, methodId);
+    PatchMethodBody(
+        *moduleDefPtr,
+        methodId,
+        pFunctionControl,
+        originalMethodBody.empty() ? nullptr : originalMethodBody.data());
+    return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE Profiler::CorProfiler::ReJITError(
+    const ModuleID moduleId,
+    const mdMethodDef methodId,
+    const FunctionID functionId,
+    const HRESULT hrStatus)
+{
+    LOG_F(WARNING, "ReJIT of method TOK = %d in module %" UINT_PTR_FORMAT " failed. Error: 0x%x.", methodId, moduleId, hrStatus);
+    return S_OK;
+}
+
 static BOOL HasIndirects(const Profiler::MethodDescriptor& descriptor)
 {
     auto const indirectIt = std::ranges::find_if(
@@ -688,6 +871,7 @@ Profiler::EltDecision* Profiler::CorProfiler::GetEltDecision(const FunctionID fu
     decision.emitExitEvent = descriptor.rewritingDescriptor.emitExitEvent;
     decision.captureStackTraceOnEnter = descriptor.rewritingDescriptor.captureStackTraceOnEnter;
     decision.genericCapture.store(genericCapture, std::memory_order_relaxed);
+    decision.active.store(!_inactiveDescriptors.contains(descriptorPointer.get()), std::memory_order_relaxed);
 
     auto* stored = &decision;
     _eltDecisionLookup.emplace(functionId, stored);
@@ -703,9 +887,20 @@ HRESULT Profiler::CorProfiler::EnterMethod(const FunctionIDOrClientID functionOr
     if (decision == nullptr)
         return S_OK;
 
+    if (_stackTraceCaptureMode == StackTraceCaptureMode::ShadowStack)
+        EltScratch.shadowStack.push_back(decision);
+
     if (ShouldSuppressGenericCapture(*decision, eltInfo, EltCallbackKind::Enter))
         return S_OK;
 
+    if (!decision->active.load(std::memory_order_relaxed))
+    {
+        // Keep the argument stack balanced for a leave that may observe the descriptor re-activated
+        if (decision->pushesArgumentsFrame)
+            EltScratch.argsCallStack.emplace();
+        return S_OK;
+    }
+
     const auto moduleId = decision->moduleId;
     const auto methodDef = decision->methodDef;
 
@@ -786,15 +981,12 @@ HRESULT Profiler::CorProfiler::EnterMethod(const FunctionIDOrClientID functionOr
 
     // Capture stack trace if required
     auto& stackFramesBlob = scratch.stackFramesBlob;
-    bool hasStackFrames = false;
-    if (decision->captureStackTraceOnEnter)
+    std::optional<UINT32> stackTraceId;
+    if (decision->captureStackTraceOnEnter
+        && SUCCEEDED(CaptureStackTraceOnEnter(stackFramesBlob))
+        && !stackFramesBlob.empty())
     {
-        hasStackFrames = SUCCEEDED(LibProfiler::StackWalker::CaptureCurrentStackTrace(
-                _corProfilerInfo,
-                1,
-                _configuration.stackTraceCollectionMaxDepth,
-                stackFramesBlob))
-            && !stackFramesBlob.empty();
+        stackTraceId = InternStackTrace(stackFramesBlob);
     }
 
     // Notify about method enter with arguments
@@ -804,9 +996,7 @@ HRESULT Profiler::CorProfiler::EnterMethod(const FunctionIDOrClientID functionOr
         decision->enterWithArgsEventId,
         LibIPC::ByteSpanView { argumentValues.data(), argumentValues.size() },
         LibIPC::ByteSpanView { argumentOffsets.data(), argumentOffsets.size() },
-        hasStackFrames
-            ? std::make_optional(LibIPC::ByteSpanView { stackFramesBlob.data(), stackFramesBlob.size() })
-            : std::nullopt);
+        stackTraceId);
     return S_OK;
 }
 
@@ -816,12 +1006,26 @@ HRESULT Profiler::CorProfiler::LeaveMethod(const FunctionIDOrClientID functionOr
         return S_OK;
 
     auto* decision = reinterpret_cast<EltDecision*>(functionOrClientId.clientID);
-    if (decision == nullptr || !decision->emitExitEvent)
+    if (decision == nullptr)
+        return S_OK;
+
+    if (_stackTraceCaptureMode == StackTraceCaptureMode::ShadowStack)
+        PopShadowStackFrame(decision->functionId);
+
+    if (!decision->emitExitEvent)
         return S_OK;
 
     if (ShouldSuppressGenericCapture(*decision, eltInfo, EltCallbackKind::Leave))
         return S_OK;
 
+    if (!decision->active.load(std::memory_order_relaxed))
+    {
+        auto& argsCallStack = EltScratch.argsCallStack;
+        if (decision->pushesArgumentsFrame && !argsCallStack.empty())
+            argsCallStack.pop();
+        return S_OK;
+    }
+
     const auto moduleId = decision->moduleId;
     const auto methodDef = decision->methodDef;
 
@@ -924,6 +1128,10 @@ HRESULT STDMETHODCALLTYPE Profiler::CorProfiler::ExceptionUnwindFunctionEnter(co
     if (_terminating)
         return S_OK;
 
+    // Leave hooks are not called for frames removed by exceptions
+    if (_stackTraceCaptureMode == StackTraceCaptureMode::ShadowStack)
+        PopShadowStackFrame(functionId);
+
     ModuleID moduleId;
     mdMethodDef methodDef;
     HRESULT hr = _corProfilerInfo->GetFunctionInfo(functionId, nullptr, &moduleId, &methodDef);
@@ -970,10 +1178,45 @@ HRESULT Profiler::CorProfiler::TailcallMethod(FunctionIDOrClientID functionOrCli
     if (_terminating)
         return S_OK;
 
+    // The frame of the caller is replaced by the callee, which gets its own enter hook
+    const auto* decision = reinterpret_cast<EltDecision*>(functionOrClientId.clientID);
+    if (decision != nullptr && _stackTraceCaptureMode == StackTraceCaptureMode::ShadowStack)
+        PopShadowStackFrame(decision->functionId);
+
     LOG_F(WARNING, "Tailcall.");
     return E_NOTIMPL;
 }
 
+HRESULT Profiler::CorProfiler::CaptureStackTraceOnEnter(std::vector<BYTE>& framesBlob)
+{
+    const auto maxFrames = _stackTraceCollectionMaxDepth.load(std::memory_order_relaxed);
+    if (_stackTraceCaptureMode == StackTraceCaptureMode::Snapshot)
+    {
+        // Skips the frame being entered
+        return LibProfiler::StackWalker::CaptureCurrentStackTrace(_corProfilerInfo, 1, maxFrames, framesBlob, &_functionInfoCache);
+    }
+
+    // Innermost frame first, without the frame being entered (top of the shadow stack)
+    const auto& shadowStack = EltScratch.shadowStack;
+    const auto callers = shadowStack.empty() ? 0 : shadowStack.size() - 1;
+    const auto count = std::min<std::size_t>(callers, maxFrames);
+    framesBlob.clear();
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        const auto& frame = *shadowStack[callers - 1 - index];
+        LibProfiler::StackWalker::AppendFrame(framesBlob, frame.moduleId, frame.methodDef);
+    }
+    return S_OK;
+}
+
+void Profiler::CorProfiler::PopShadowStackFrame(const FunctionID functionId)
+{
+    // Unwinding reports every managed frame, only hooked ones were pushed
+    auto& shadowStack = EltScratch.shadowStack;
+    if (!shadowStack.empty() && shadowStack.back()->functionId == functionId)
+        shadowStack.pop_back();
+}
+
 std::shared_ptr<Profiler::MethodDescriptor> Profiler::CorProfiler::FindMethodDescriptor(const FunctionID functionId)
 {
     ModuleID moduleId;
@@ -1040,7 +1283,7 @@ void Profiler::CorProfiler::SendMethodEnterWithArguments(
     const USHORT interpretation,
     const LibIPC::ByteSpanView argumentValues,
     const LibIPC::ByteSpanView argumentInfos,
-    const std::optional<LibIPC::ByteSpanView> stackFrames)
+    const std::optional<UINT32> stackTraceId)
 {
     LibIPC::FixedEvents::WriteMethodEnterWithArguments(
         EltScratch.fixedEventBuffer,
@@ -1050,10 +1293,30 @@ void Profiler::CorProfiler::SendMethodEnterWithArguments(
         interpretation,
         argumentValues,
         argumentInfos,
-        stackFrames);
+        stackTraceId);
     _client.SendRaw(EltScratch.fixedEventBuffer.data(), EltScratch.fixedEventBuffer.size());
 }
 
+UINT32 Profiler::CorProfiler::InternStackTrace(const std::span<const BYTE> stackFrames)
+{
+    // Definitions are sent again once a sink may have lost them
+    const auto discontinuities = _client.GetEventDiscontinuitiesCount();
+    return _stackTraces.Intern(stackFrames, discontinuities, [this](const UINT32 stackTraceId, const std::span<const BYTE> frames)
+    {
+        // Sent under the interner lock, so the definition precedes every event using the id
+        auto& buffer = EltScratch.fixedEventBuffer;
+        LibIPC::FixedEvents::WriteStackTraceDefinition(buffer, stackTraceId, LibIPC::ByteSpanView { frames.data(), frames.size() });
+        _client.SendRaw(buffer.data(), buffer.size());
+    });
+}
+
+void Profiler::CorProfiler::SendStackSampleHistogram(const std::unordered_map<UINT32, UINT32>& histogram, const UINT32 walks)
+{
+    auto& buffer = EltScratch.fixedEventBuffer;
+    LibIPC::FixedEvents::WriteStackSampleHistogram(buffer, _configuration.stackSamplingPeriod, walks, histogram);
+    _client.SendRaw(buffer.data(), buffer.size());
+}
+
 void Profiler::CorProfiler::SendMethodExitWithArguments(
     const UINT64 moduleId,
     const UINT32 methodToken,
@@ -1079,74 +1342,215 @@ LibIPC::MetadataMsg Profiler::CorProfiler::CreateMetadataMsg(const UINT64 comman
     return LibIPC::Helpers::CreateMetadataMsg(_pid, GetCurrentThreadIdCached(), commandId);
 }
 
-void Profiler::CorProfiler::OnCreateStackSnapshot(const UINT64 commandId, const UINT64 targetThreadId)
+void Profiler::CorProfiler::OnCreateStackSnapshots(const std::vector<LibIPC::StackSnapshotRequest>& requests)
 {
-    LOG_F(INFO, "Received command to create stack snapshot for thread %" UINT_PTR_FORMAT " (commandId: %lu).", targetThreadId, commandId);
-
-    if (FAILED(CaptureStackTrace(commandId, targetThreadId)))
+    // Threads requested by several commands are walked only once
+    std::vector<UINT64> threadIds;
+    std::unordered_map<UINT64, std::size_t> threadIndices;
+    for (const auto& request : requests)
     {
-        LOG_F(ERROR, "Failed to capture stack trace for thread %" UINT_PTR_FORMAT ".", targetThreadId);
+        for (const auto threadId : request.targetThreadIds)
+        {
+            if (threadIndices.emplace(threadId, threadIds.size()).second)
+                threadIds.push_back(threadId);
+        }
     }
-}
 
-void Profiler::CorProfiler::OnCreateStackSnapshots(const UINT64 commandId, const std::vector<UINT64>& targetThreadIds)
-{
-    LOG_F(INFO, "Received command to create stack snapshots for %zu threads (commandId: %lu).", targetThreadIds.size(), commandId);
+    LOG_F(INFO, "Received %zu stack snapshot commands for %zu distinct threads.", requests.size(), threadIds.size());
 
     std::vector<std::vector<LibProfiler::StackFrame>> frames;
-    auto hr = LibProfiler::StackWalker::CaptureStackTraces(_corProfilerInfo, targetThreadIds, frames);
+    std::vector<HRESULT> threadResults;
+    auto hr = LibProfiler::StackWalker::CaptureStackTraces(_corProfilerInfo, threadIds, frames, &threadResults, &_functionInfoCache);
 
     if (FAILED(hr))
     {
         LOG_F(WARNING, "One or more stack traces failed to capture. Error: 0x%x.", hr);
     }
 
+    for (const auto& request : requests)
+    {
+        if (request.commandType == LibIPC::ProfilerCommandType::CreateStackSnapshot)
+        {
+            const auto threadId = request.targetThreadIds.front();
+            const auto index = threadIndices[threadId];
+            if (index >= threadResults.size() || FAILED(threadResults[index]))
+            {
+                LOG_F(ERROR, "Failed to capture stack trace for thread %" UINT_PTR_FORMAT ".", threadId);
+                continue;
+            }
+
+            SendStackSnapshot(request.commandId, threadId, frames[index]);
+        }
+        else
+        {
+            SendStackSnapshots(request.commandId, request.targetThreadIds, threadIndices, frames);
+        }
+    }
+}
+
+void Profiler::CorProfiler::SendStackSnapshot(
+    const UINT64 commandId,
+    const ThreadID threadId,
+    const std::vector<LibProfiler::StackFrame>& frames)
+{
+    std::vector<UINT64> moduleIds;
+    std::vector<UINT32> methodTokens;
+    moduleIds.reserve(frames.size());
+    methodTokens.reserve(frames.size());
+
+    for (const auto&[moduleId, methodToken] : frames)
+    {
+        moduleIds.push_back(moduleId);
+        methodTokens.push_back(methodToken);
+    }
+
+    _client.Send(LibIPC::Helpers::CreateStackTraceSnapshotMsg(
+        CreateMetadataMsg(commandId),
+        threadId,
+        std::move(moduleIds),
+        std::move(methodTokens)));
+    _client.OnCommandCompleted(commandId);
+
+    LOG_F(INFO, "Sent stack trace snapshot notification for thread %" UINT_PTR_FORMAT " with %zu frames (commandId: %lu).",
+        threadId, frames.size(), commandId);
+}
+
+void Profiler::CorProfiler::SendStackSnapshots(
+    const UINT64 commandId,
+    const std::vector<UINT64>& threadIds,
+    const std::unordered_map<UINT64, std::size_t>& threadIndices,
+    const std::vector<std::vector<LibProfiler::StackFrame>>& frames)
+{
     std::vector<LibIPC::StackTraceSnapshotMsgArgs> snapshots;
-    snapshots.reserve(frames.size());
+    snapshots.reserve(threadIds.size());
 
-    for (size_t i = 0; i < frames.size(); ++i)
+    for (const auto threadId : threadIds)
     {
+        // Nothing was captured if the runtime could not be suspended
+        const auto index = threadIndices.at(threadId);
+        if (index >= frames.size())
+            continue;
+
         std::vector<UINT64> moduleIds;
         std::vector<UINT32> methodTokens;
-        moduleIds.reserve(frames[i].size());
-        methodTokens.reserve(frames[i].size());
+        moduleIds.reserve(frames[index].size());
+        methodTokens.reserve(frames[index].size());
 
-        for (const auto&[moduleId, methodToken] : frames[i])
+        for (const auto&[moduleId, methodToken] : frames[index])
         {
             moduleIds.push_back(moduleId);
             methodTokens.push_back(methodToken);
         }
 
-        snapshots.emplace_back(targetThreadIds[i], std::move(moduleIds), std::move(methodTokens));
+        snapshots.emplace_back(threadId, std::move(moduleIds), std::move(methodTokens));
     }
 
-	const auto snapshotsCount = snapshots.size();
+    const auto snapshotsCount = snapshots.size();
     _client.Send(LibIPC::Helpers::CreateStackTraceSnapshotsMsg(CreateMetadataMsg(commandId), std::move(snapshots)));
+    _client.OnCommandCompleted(commandId);
     LOG_F(INFO, "Sent stack snapshots notification with %zu snapshots (commandId: %lu).", snapshotsCount, commandId);
 }
 
-HRESULT Profiler::CorProfiler::CaptureStackTrace(const UINT64 commandId, const ThreadID threadId)
+void Profiler::CorProfiler::OnSetMethodDescriptorActive(
+    const UINT64 commandId,
+    const std::string& declaringTypeFullName,
+    const std::string& methodName,
+    const bool active)
 {
-    std::vector<UINT64> moduleIds;
-    std::vector<UINT32> methodTokens;
+    std::unordered_set<const MethodDescriptor*> matched;
+    for (const auto& descriptor : _methodDescriptorRegistry.Descriptors())
+    {
+        if (descriptor->declaringTypeFullName == declaringTypeFullName && descriptor->methodName == methodName)
+            matched.insert(descriptor.get());
+    }
 
-    auto hr = LibProfiler::StackWalker::CaptureStackTrace(_corProfilerInfo, threadId, moduleIds, methodTokens);
+    if (matched.empty())
+    {
+        LOG_F(WARNING, "No method descriptor matches %s.%s (commandId: %lu).", declaringTypeFullName.c_str(), methodName.c_str(), commandId);
+        _client.OnCommandCompleted(commandId);
+        return;
+    }
 
-    if (FAILED(hr))
+    // Hooks stay installed, ELT callbacks of inactive descriptors return immediately
+    UINT updatedDecisions = 0;
     {
-        LOG_F(ERROR, "StackWalker::CaptureStackTrace failed. Error: 0x%x.", hr);
-        return hr;
+        auto guard = std::lock_guard(_eltDecisionMutex);
+        for (const auto* descriptor : matched)
+        {
+            if (active)
+                _inactiveDescriptors.erase(descriptor);
+            else
+                _inactiveDescriptors.insert(descriptor);
+        }
+
+        for (auto& decision : _eltDecisions)
+        {
+            if (!matched.contains(decision.descriptor))
+                continue;
+
+            decision.active.store(active, std::memory_order_relaxed);
+            ++updatedDecisions;
+        }
     }
 
-    const auto frameCount = moduleIds.size();
-    _client.Send(LibIPC::Helpers::CreateStackTraceSnapshotMsg(
-        CreateMetadataMsg(commandId),
-        threadId,
-        std::move(moduleIds),
-        std::move(methodTokens)));
+    LOG_F(INFO, "Method descriptor %s.%s %s, updated %u compiled functions (commandId: %lu).",
+        declaringTypeFullName.c_str(), methodName.c_str(), active ? "activated" : "deactivated", updatedDecisions, commandId);
+    _client.OnCommandCompleted(commandId);
+}
 
-    LOG_F(INFO, "Sent stack trace snapshot notification for thread %" UINT_PTR_FORMAT " with %zu frames (commandId: %lu).",
-        threadId, frameCount, commandId);
+void Profiler::CorProfiler::OnSetFieldsAccessInstrumentation(
+    const UINT64 commandId,
+    const std::vector<UINT64>& moduleIds,
+    const bool enabled)
+{
+    if (!_configuration.enableRuntimeReconfiguration)
+    {
+        LOG_F(WARNING, "Ignoring fields access instrumentation change, runtime reconfiguration is disabled (commandId: %lu).", commandId);
+        _client.OnCommandCompleted(commandId);
+        return;
+    }
 
-    return S_OK;
+    std::vector<ModuleID> rejitModuleIds;
+    std::vector<mdMethodDef> rejitMethodDefs;
+    for (const auto moduleId : moduleIds)
+    {
+        _reJitRegistry.SetFieldsAccessInstrumentation(moduleId, enabled ? TRUE : FALSE);
+        for (const auto methodDef : _reJitRegistry.GetCompiledMethods(moduleId))
+        {
+            // Injected stubs are never instrumented
+            if (_rewriteRegistry.IsStub(moduleId, methodDef))
+                continue;
+
+            rejitModuleIds.push_back(moduleId);
+            rejitMethodDefs.push_back(methodDef);
+        }
+    }
+
+    // Methods compiled from now on pick up the new setting in JITCompilationStarted, the rest is recompiled
+    if (!rejitMethodDefs.empty())
+    {
+        const auto hr = _corProfilerInfo->RequestReJIT(
+            static_cast<ULONG>(rejitMethodDefs.size()),
+            rejitModuleIds.data(),
+            rejitMethodDefs.data());
+        if (FAILED(hr))
+            LOG_F(ERROR, "Could not request ReJIT of %zu methods. Error: 0x%x.", rejitMethodDefs.size(), hr);
+    }
+
+    LOG_F(INFO, "Fields access instrumentation %s for %zu modules, requested ReJIT of %zu methods (commandId: %lu).",
+        enabled ? "enabled" : "disabled", moduleIds.size(), rejitMethodDefs.size(), commandId);
+    _client.OnCommandCompleted(commandId);
+}
+
+void Profiler::CorProfiler::OnSetStackTraceCollectionMaxDepth(const UINT64 commandId, const UINT maxDepth)
+{
+    _stackTraceCollectionMaxDepth.store(maxDepth, std::memory_order_relaxed);
+    LOG_F(INFO, "Stack trace collection max depth set to %u (commandId: %lu).", maxDepth, commandId);
+    _client.OnCommandCompleted(commandId);
+}
+
+void Profiler::CorProfiler::OnDrainBarrier(const UINT64 commandId, const UINT64 sequence, const bool flushed, const UINT64 flushedSequence)
+{
+    _client.Send(LibIPC::Helpers::CreateDrainBarrierMsg(CreateMetadataMsg(commandId), sequence, flushed, flushedSequence));
+    _client.OnCommandCompleted(commandId);
 }
@@ -8,7 +8,9 @@
 #include <functional>
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <optional>
+#include <span>
 #include <vector>
 
 #include "cor.h"
@@ -16,9 +18,15 @@
 #include "../LibIPC/Client.h"
 #include "../LibIPC/Messages.h"
 #include "../LibProfilerCore/CorProfilerBase.h"
+#include "../LibProfilerCore/FunctionInfoCache.h"
+#include "../LibProfilerCore/GarbageCollectionPipeline.h"
 #include "../LibMetadata/ModuleDef.h"
 #include "../LibMetadata/TypeClassification.h"
+#include "../LibProfilerCore/ObjectIdBuffer.h"
 #include "../LibProfilerCore/ObjectsTracker.h"
+#include "../LibProfilerCore/StackSampler.h"
+#include "../LibProfilerCore/StackTraceInterner.h"
+#include "../LibProfilerCore/StackWalker.h"
 #include "../LibDescriptors/Configuration.h"
 #include "../LibDescriptors/FieldAccessIntrinsicDescriptor.h"
 #include "../LibDescriptors/MethodDescriptor.h"
@@ -26,6 +34,7 @@
 #include "ArgumentCapture.h"
 #include "MetadataStore.h"
 #include "MethodDescriptorRegistry.h"
+#include "ReJitRegistry.h"
 #include "RewriteRegistry.h"
 #include "TypeInjector.h"
 
@@ -33,6 +42,7 @@ namespace Profiler
 {
 	enum class GenericCaptureState : UINT8 { Unresolved, Allow, Suppress };
 	enum class EltCallbackKind : UINT8 { Enter, Leave };
+	enum class StackTraceCaptureMode : UINT8 { Snapshot, ShadowStack };
 
 	struct EltDecision
 	{
@@ -51,6 +61,8 @@ namespace Profiler
 		bool emitExitEvent;
 		bool captureStackTraceOnEnter;
 		std::atomic<GenericCaptureState> genericCapture;
+		// Cleared when the analyzer deactivates the descriptor at runtime
+		std::atomic_bool active;
 	};
 
 	class CorProfiler final : public LibProfiler::CorProfilerBase, public LibIPC::ICommandHandler
@@ -60,20 +72,31 @@ namespace Profiler
 		HRESULT STDMETHODCALLTYPE Initialize(IUnknown* pICorProfilerInfoUnk) override;
 		HRESULT STDMETHODCALLTYPE Shutdown() override;
 		
-		void OnCreateStackSnapshot(UINT64 commandId, UINT64 targetThreadId) override;
-		void OnCreateStackSnapshots(UINT64 commandId, const std::vector<UINT64>& targetThreadIds) override;
+		void OnCreateStackSnapshots(const std::vector<LibIPC::StackSnapshotRequest>& requests) override;
+		void OnSetMethodDescriptorActive(
+			UINT64 commandId,
+			const std::string& declaringTypeFullName,
+			const std::string& methodName,
+			bool active) override;
+		void OnSetFieldsAccessInstrumentation(UINT64 commandId, const std::vector<UINT64>& moduleIds, bool enabled) override;
+		void OnSetStackTraceCollectionMaxDepth(UINT64 commandId, UINT maxDepth) override;
+		void OnDrainBarrier(UINT64 commandId, UINT64 sequence, bool flushed, UINT64 flushedSequence) override;
 
 		HRESULT STDMETHODCALLTYPE GarbageCollectionStarted(int cGenerations, BOOL generationCollected[], COR_PRF_GC_REASON reason) override;
 		HRESULT STDMETHODCALLTYPE GarbageCollectionFinished() override;
 		HRESULT STDMETHODCALLTYPE FinalizeableObjectQueued(DWORD finalizerFlags, ObjectID objectID) override;
 		HRESULT STDMETHODCALLTYPE JITCompilationStarted(FunctionID functionId, BOOL fIsSafeToBlock) override;
 		HRESULT STDMETHODCALLTYPE ModuleLoadFinished(ModuleID moduleId, HRESULT hrStatus) override;
+		HRESULT STDMETHODCALLTYPE ModuleUnloadStarted(ModuleID moduleId) override;
+		HRESULT STDMETHODCALLTYPE FunctionUnloadStarted(FunctionID functionId) override;
 		HRESULT STDMETHODCALLTYPE MovedReferences2(ULONG cMovedObjectIDRanges, ObjectID oldObjectIDRangeStart[], ObjectID newObjectIDRangeStart[], SIZE_T cObjectIDRangeLength[]) override;
 		HRESULT STDMETHODCALLTYPE SurvivingReferences2(ULONG cSurvivingObjectIDRanges, ObjectID objectIDRangeStart[], SIZE_T cObjectIDRangeLength[]) override;
 		HRESULT STDMETHODCALLTYPE ThreadCreated(ThreadID threadId) override;
 		HRESULT STDMETHODCALLTYPE ThreadDestroyed(ThreadID threadId) override;
 		HRESULT STDMETHODCALLTYPE ThreadNameChanged(ThreadID threadId, ULONG cchName, WCHAR name[]) override;
 		HRESULT STDMETHODCALLTYPE ExceptionUnwindFunctionEnter(FunctionID functionId) override;
+		HRESULT STDMETHODCALLTYPE GetReJITParameters(ModuleID moduleId, mdMethodDef methodId, ICorProfilerFunctionControl* pFunctionControl) override;
+		HRESULT STDMETHODCALLTYPE ReJITError(ModuleID moduleId, mdMethodDef methodId, FunctionID functionId, HRESULT hrStatus) override;
 
 		HRESULT EnterMethod(FunctionIDOrClientID functionId, COR_PRF_ELT_INFO eltInfo);
 		HRESULT LeaveMethod(FunctionIDOrClientID functionId, COR_PRF_ELT_INFO eltInfo);
@@ -86,7 +109,15 @@ namespace Profiler
 		[[nodiscard]] LibIPC::MetadataMsg CreateMetadataMsg() const;
 		[[nodiscard]] LibIPC::MetadataMsg CreateMetadataMsg(UINT64 commandId) const;
 		[[nodiscard]] UINT64 GetCurrentThreadIdCached() const;
-		HRESULT CaptureStackTrace(UINT64 commandId, ThreadID threadId);
+		void SendStackSnapshot(UINT64 commandId, ThreadID threadId, const std::vector<LibProfiler::StackFrame>& frames);
+		void SendStackSnapshots(
+			UINT64 commandId,
+			const std::vector<UINT64>& threadIds,
+			const std::unordered_map<UINT64, std::size_t>& threadIndices,
+			const std::vector<std::vector<LibProfiler::StackFrame>>& frames);
+		void SendGarbageCollectionApplying(std::vector<LibProfiler::TrackedObjectId>& finalizationQueuedObjects);
+		void SendGarbageCollectedObjects(std::span<const LibProfiler::TrackedObjectId> trackedObjectIds);
+		void SendGarbageCollectionApplied(UINT oldTrackedObjectsCount, UINT newTrackedObjectsCount);
 		void SendMethodEnter(UINT64 moduleId, UINT32 methodToken, USHORT interpretation);
 		void SendMethodExit(UINT64 moduleId, UINT32 methodToken, USHORT interpretation);
 		void SendMethodEnterWithArguments(
@@ -95,7 +126,11 @@ namespace Profiler
 			USHORT interpretation,
 			LibIPC::ByteSpanView argumentValues,
 			LibIPC::ByteSpanView argumentInfos,
-			std::optional<LibIPC::ByteSpanView> stackFrames);
+			std::optional<UINT32> stackTraceId);
+		UINT32 InternStackTrace(std::span<const BYTE> stackFrames);
+		void SendStackSampleHistogram(const std::unordered_map<UINT32, UINT32>& histogram, UINT32 walks);
+		HRESULT CaptureStackTraceOnEnter(std::vector<BYTE>& framesBlob);
+		static void PopShadowStackFrame(FunctionID functionId);
 		void SendMethodExitWithArguments(
 			UINT64 moduleId,
 			UINT32 methodToken,
@@ -103,7 +138,11 @@ namespace Profiler
 			LibIPC::ByteSpanView returnValue,
 			LibIPC::ByteSpanView byRefArgumentValues,
 			LibIPC::ByteSpanView byRefArgumentInfos);
-		HRESULT PatchMethodBody(const LibProfiler::ModuleDef& moduleDef, mdTypeDef mdTypeDef, mdMethodDef mdMethodDef);
+		HRESULT PatchMethodBody(
+			const LibProfiler::ModuleDef& moduleDef,
+			mdMethodDef mdMethodDef,
+			ICorProfilerFunctionControl* functionControl = nullptr,
+			LPCBYTE originalMethodBody = nullptr);
 		[[nodiscard]] GenericCaptureState ClassifyGenericValueCapture(FunctionID functionId, COR_PRF_FRAME_INFO frameInfo, const MethodDescriptor& descriptor);
 		[[nodiscard]] COR_PRF_FRAME_INFO GetFrameInfo(const EltDecision& decision, COR_PRF_ELT_INFO eltInfo, EltCallbackKind callback) const;
 		[[nodiscard]] bool ShouldSuppressGenericCapture(EltDecision& decision, COR_PRF_ELT_INFO eltInfo, EltCallbackKind callback);
@@ -119,16 +158,31 @@ namespace Profiler
 
 		MetadataStore _metadataStore;
 		LibProfiler::ObjectsTracker _objectsTracker;
-		std::vector<UINT64> _finalizationQueuedTrackedObjects;
-		std::mutex _finalizationQueuedMutex;
+		// Objects queued for finalization during the ongoing GC, translated once it finishes
+		LibProfiler::ObjectIdBuffer _finalizationQueuedObjects;
+		LibProfiler::GarbageCollectionPipeline _gcPipeline;
+		// Metadata of GC threads that finished GCs not yet applied by the pipeline, oldest first
+		std::deque<LibIPC::MetadataMsg> _gcFinishedMetadata;
+		std::mutex _gcFinishedMetadataMutex;
+		// Metadata of the GC being applied, touched only by the thread applying it
+		LibIPC::MetadataMsg _gcAppliedMetadata;
 		MethodDescriptorRegistry _methodDescriptorRegistry;
 		std::vector<FieldAccessIntrinsicDescriptor> _fieldAccessIntrinsics;
 		RewriteRegistry _rewriteRegistry;
+		ReJitRegistry _reJitRegistry;
+		std::atomic<UINT> _stackTraceCollectionMaxDepth;
+		const StackTraceCaptureMode _stackTraceCaptureMode;
+		LibProfiler::StackTraceInterner _stackTraces;
+		LibProfiler::FunctionInfoCache _functionInfoCache;
+		// Created once the runtime is attached, only if sampling was requested
+		std::optional<LibProfiler::StackSampler> _stackSampler;
 		ArgumentCapture _argumentCapture;
 		TypeInjector _typeInjector;
 
 		std::deque<EltDecision> _eltDecisions;
 		std::unordered_map<FunctionID, EltDecision*> _eltDecisionLookup;
 		std::mutex _eltDecisionMutex;
+		// Descriptors deactivated before their methods were compiled, guarded by _eltDecisionMutex
+		std::unordered_set<const MethodDescriptor*> _inactiveDescriptors;
 	};
 }
@@ -0,0 +1,46 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ReJitRegistry.h"
+
+void Profiler::ReJitRegistry::AddCompiledMethod(
+	const ModuleID moduleId,
+	const mdMethodDef methodDef,
+	const LPCBYTE methodBody,
+	const ULONG methodBodySize)
+{
+	auto guard = std::unique_lock(_methodsMutex);
+	const auto [it, inserted] = _originalMethodBodies.try_emplace(
+		std::make_pair(moduleId, methodDef),
+		methodBody,
+		methodBody + methodBodySize);
+	if (inserted)
+		_compiledMethods[moduleId].push_back(methodDef);
+}
+
+std::vector<mdMethodDef> Profiler::ReJitRegistry::GetCompiledMethods(const ModuleID moduleId)
+{
+	auto guard = std::shared_lock(_methodsMutex);
+	const auto it = _compiledMethods.find(moduleId);
+	return (it != _compiledMethods.cend()) ? it->second : std::vector<mdMethodDef>{};
+}
+
+std::vector<BYTE> Profiler::ReJitRegistry::GetOriginalMethodBody(const ModuleID moduleId, const mdMethodDef methodDef)
+{
+	auto guard = std::shared_lock(_methodsMutex);
+	const auto it = _originalMethodBodies.find(std::make_pair(moduleId, methodDef));
+	return (it != _originalMethodBodies.cend()) ? it->second : std::vector<BYTE>{};
+}
+
+void Profiler::ReJitRegistry::SetFieldsAccessInstrumentation(const ModuleID moduleId, const BOOL enabled)
+{
+	auto guard = std::unique_lock(_fieldsAccessInstrumentationMutex);
+	_fieldsAccessInstrumentation.insert_or_assign(moduleId, enabled);
+}
+
+BOOL Profiler::ReJitRegistry::IsFieldsAccessInstrumentationEnabled(const ModuleID moduleId, const BOOL defaultValue)
+{
+	auto guard = std::shared_lock(_fieldsAccessInstrumentationMutex);
+	const auto it = _fieldsAccessInstrumentation.find(moduleId);
+	return (it != _fieldsAccessInstrumentation.cend()) ? it->second : defaultValue;
+}
@@ -0,0 +1,44 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cor.h"
+#include "corprof.h"
+
+#include "../LibDescriptors/HashingUtils.h"
+
+namespace Profiler
+{
+	// Keeps the state needed to re-instrument already compiled methods when the configuration changes at runtime
+	class ReJitRegistry
+	{
+	public:
+		// Must be called before the method body is instrumented for the first time
+		void AddCompiledMethod(ModuleID moduleId, mdMethodDef methodDef, LPCBYTE methodBody, ULONG methodBodySize);
+		[[nodiscard]] std::vector<mdMethodDef> GetCompiledMethods(ModuleID moduleId);
+		// Empty if the method was not compiled by the JIT (its current body is the original one)
+		[[nodiscard]] std::vector<BYTE> GetOriginalMethodBody(ModuleID moduleId, mdMethodDef methodDef);
+
+		void SetFieldsAccessInstrumentation(ModuleID moduleId, BOOL enabled);
+		[[nodiscard]] BOOL IsFieldsAccessInstrumentationEnabled(ModuleID moduleId, BOOL defaultValue);
+
+	private:
+		using MethodId = std::pair<ModuleID, mdMethodDef>;
+		using MethodIdHasher = pair_hash<ModuleID, mdMethodDef>;
+
+		std::unordered_map<MethodId, std::vector<BYTE>, MethodIdHasher> _originalMethodBodies;
+		std::unordered_map<ModuleID, std::vector<mdMethodDef>> _compiledMethods;
+		std::shared_mutex _methodsMutex;
+
+		std::unordered_map<ModuleID, BOOL> _fieldsAccessInstrumentation;
+		std::shared_mutex _fieldsAccessInstrumentationMutex;
+	};
+}
@@ -40,6 +40,13 @@ void Profiler::RewriteRegistry::AddModuleInjectedMethods(const ModuleID moduleId
 	_injectedMethods.emplace(moduleId, std::move(injectedMethods));
 }
 
+BOOL Profiler::RewriteRegistry::HasModuleInjectedMethods(const ModuleID moduleId)
+{
+	auto guard = std::unique_lock(_injectedMethodsMutex);
+	const auto it = _injectedMethods.find(moduleId);
+	return it != _injectedMethods.cend() && !it->second.empty();
+}
+
 void Profiler::RewriteRegistry::AddModuleFieldAccessIntrinsics(const ModuleID moduleId, LibProfiler::FieldAccessIntrinsicsMap intrinsics)
 {
 	auto guard = std::unique_lock(_fieldAccessIntrinsicsMutex);
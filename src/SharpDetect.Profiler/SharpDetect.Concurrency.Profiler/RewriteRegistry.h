@@ -30,6 +30,7 @@ namespace Profiler
 		[[nodiscard]] std::unordered_map<mdToken, mdToken> GetModuleRewritings(ModuleID moduleId);
 
 		void AddModuleInjectedMethods(ModuleID moduleId, LibProfiler::InjectedMethodsMap injectedMethods);
+		[[nodiscard]] BOOL HasModuleInjectedMethods(ModuleID moduleId);
 
 		void AddModuleFieldAccessIntrinsics(ModuleID moduleId, LibProfiler::FieldAccessIntrinsicsMap intrinsics);
 
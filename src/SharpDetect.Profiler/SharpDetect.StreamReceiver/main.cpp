@@ -0,0 +1,176 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "../lib/loguru/loguru.hpp"
+
+#include "../LibIPC/SocketChannel.h"
+#include "../LibIPC/SocketStreamFormat.h"
+
+namespace
+{
+    struct ReceiverOptions
+    {
+        std::string endpoint;
+        double reportInterval { 1.0 };
+        UINT connections { 1 };
+    };
+
+    struct Throughput
+    {
+        UINT64 records { 0 };
+        UINT64 frames { 0 };
+        UINT64 bytes { 0 };
+    };
+
+    void PrintUsage()
+    {
+        std::fprintf(stderr,
+            "Usage: SharpDetect.StreamReceiver --listen <tcp://host:port | unix:///path>\n"
+            "                                  [--report-interval <seconds>] [--connections <count>]\n"
+            "\n"
+            "Stand-in for a remote analyzer: accepts event streams from the socket event sink,\n"
+            "validates their framing and reports the sustained throughput.\n");
+    }
+
+    bool TryParseArguments(const int argc, char** argv, ReceiverOptions& options)
+    {
+        for (auto i = 1; i + 1 < argc; i += 2)
+        {
+            const std::string argument(argv[i]);
+            const std::string value(argv[i + 1]);
+            try
+            {
+                if (argument == "--listen")
+                    options.endpoint = value;
+                else if (argument == "--report-interval")
+                    options.reportInterval = std::stod(value);
+                else if (argument == "--connections")
+                    options.connections = static_cast<UINT>(std::stoul(value));
+                else
+                    return false;
+            }
+            catch (const std::exception&)
+            {
+                return false;
+            }
+        }
+
+        return argc % 2 == 1 && !options.endpoint.empty() && options.reportInterval > 0;
+    }
+
+    void Report(const char* label, const Throughput& throughput, const double seconds)
+    {
+        std::printf(
+            "%s: %llu events in %llu frames (%.2f MiB) in %.3f s: %.0f events/s, %.2f MiB/s\n",
+            label,
+            static_cast<unsigned long long>(throughput.records),
+            static_cast<unsigned long long>(throughput.frames),
+            static_cast<double>(throughput.bytes) / (1024.0 * 1024.0),
+            seconds,
+            seconds > 0 ? static_cast<double>(throughput.records) / seconds : 0.0,
+            seconds > 0 ? static_cast<double>(throughput.bytes) / (1024.0 * 1024.0) / seconds : 0.0);
+        std::fflush(stdout);
+    }
+
+    bool ReceiveStream(const LibIPC::SocketChannel& connection, const double reportInterval)
+    {
+        namespace SocketStreamFormat = LibIPC::SocketStreamFormat;
+        SocketStreamFormat::StreamHeader header { };
+        if (!connection.ReceiveAll(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            header.magic != SocketStreamFormat::StreamMagic ||
+            header.version != SocketStreamFormat::Version)
+        {
+            std::fprintf(stderr, "Rejected connection with an unrecognized stream header.\n");
+            return false;
+        }
+        std::printf("Receiving events from process %u.\n", header.pid);
+
+        Throughput total;
+        Throughput interval;
+        UINT64 expectedSequence = 0;
+        std::vector<char> batch;
+        const auto start = std::chrono::steady_clock::now();
+        auto intervalStart = start;
+        SocketStreamFormat::FrameHeader frame { };
+        while (connection.ReceiveAll(reinterpret_cast<char*>(&frame), sizeof(frame)))
+        {
+            batch.resize(frame.size);
+            if (!connection.ReceiveAll(batch.data(), batch.size()))
+            {
+                std::fprintf(stderr, "Stream ended in the middle of a frame.\n");
+                break;
+            }
+
+            // Gaps mean the producer dropped batches because this receiver could not keep up
+            if (frame.firstSequence != expectedSequence)
+                std::fprintf(stderr, "Sequence gap: expected %llu, received %llu.\n",
+                    static_cast<unsigned long long>(expectedSequence),
+                    static_cast<unsigned long long>(frame.firstSequence));
+            expectedSequence = frame.firstSequence + frame.recordCount;
+
+            for (auto* throughput : { &total, &interval })
+            {
+                throughput->records += frame.recordCount;
+                throughput->bytes += sizeof(frame) + frame.size;
+                ++throughput->frames;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            const auto elapsed = std::chrono::duration<double>(now - intervalStart).count();
+            if (elapsed >= reportInterval)
+            {
+                Report("Interval", interval, elapsed);
+                interval = { };
+                intervalStart = now;
+            }
+        }
+
+        Report("Total", total, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        return true;
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    loguru::g_stderr_verbosity = loguru::Verbosity_WARNING;
+
+    ReceiverOptions options;
+    if (!TryParseArguments(argc, argv, options))
+    {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    const auto listener = LibIPC::SocketChannel::Listen(options.endpoint);
+    if (!listener.IsValid())
+    {
+        std::fprintf(stderr, "Could not listen on %s.\n", options.endpoint.c_str());
+        return EXIT_FAILURE;
+    }
+
+    std::printf("Listening on %s", options.endpoint.c_str());
+    if (const auto port = listener.GetLocalPort(); port > 0)
+        std::printf(" (port %d)", port);
+    std::printf(".\n");
+    std::fflush(stdout);
+
+    for (UINT connection = 0; connection < options.connections; ++connection)
+    {
+        const auto channel = listener.Accept();
+        if (!channel.IsValid())
+        {
+            std::fprintf(stderr, "Could not accept connection.\n");
+            return EXIT_FAILURE;
+        }
+        ReceiveStream(channel, options.reportInterval);
+    }
+
+    return EXIT_SUCCESS;
+}
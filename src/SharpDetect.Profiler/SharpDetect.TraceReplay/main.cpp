@@ -0,0 +1,242 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../lib/loguru/loguru.hpp"
+
+#include "../LibIPC/IpqLibrary.h"
+#include "../LibIPC/IpqProducer.h"
+#include "../LibIPC/TraceFileReader.h"
+#include "../LibProfilerCore/PAL.h"
+
+namespace
+{
+    struct ReplayOptions
+    {
+        std::string tracePath;
+        std::string ipqPath;
+        std::string queueName;
+        std::string queueFile;
+        std::string queueSemaphoreName;
+        UINT queueSize { 20 * 1024 * 1024 };
+        std::optional<std::string> registrationName;
+        std::string registrationFile;
+        UINT registrationSize { 64 * 1024 };
+        INT pid { 0 };
+        // Events per second, zero replays at full speed
+        double rate { 0 };
+        UINT repeat { 1 };
+    };
+
+    struct ReplayStatistics
+    {
+        UINT64 records { 0 };
+        UINT64 batches { 0 };
+        UINT64 bytes { 0 };
+    };
+
+    void PrintUsage()
+    {
+        std::fprintf(stderr,
+            "Usage: SharpDetect.TraceReplay --trace <path> --queue-name <name> --queue-file <file>\n"
+            "                               --queue-semaphore <name> [--queue-size <bytes>]\n"
+            "                               [--ipq <library>] [--rate <events/s>] [--repeat <count>]\n"
+            "                               [--registration-name <name> --registration-file <file>\n"
+            "                                [--registration-size <bytes>] [--pid <pid>]]\n"
+            "\n"
+            "Replays a trace recorded by the trace file event sink into an IPC event queue.\n"
+            "Without --rate the trace is replayed as fast as the consumer drains the queue.\n"
+            "The IPQ library path defaults to the SharpDetect_IPQ_PATH environment variable.\n");
+    }
+
+    bool TryParseArguments(const int argc, char** argv, ReplayOptions& options)
+    {
+        for (auto i = 1; i < argc; ++i)
+        {
+            const std::string argument(argv[i]);
+            if (i + 1 >= argc)
+            {
+                std::fprintf(stderr, "Missing value for %s.\n", argument.c_str());
+                return false;
+            }
+
+            const std::string value(argv[++i]);
+            try
+            {
+                if (argument == "--trace")
+                    options.tracePath = value;
+                else if (argument == "--ipq")
+                    options.ipqPath = value;
+                else if (argument == "--queue-name")
+                    options.queueName = value;
+                else if (argument == "--queue-file")
+                    options.queueFile = value;
+                else if (argument == "--queue-semaphore")
+                    options.queueSemaphoreName = value;
+                else if (argument == "--queue-size")
+                    options.queueSize = static_cast<UINT>(std::stoul(value));
+                else if (argument == "--registration-name")
+                    options.registrationName = value;
+                else if (argument == "--registration-file")
+                    options.registrationFile = value;
+                else if (argument == "--registration-size")
+                    options.registrationSize = static_cast<UINT>(std::stoul(value));
+                else if (argument == "--pid")
+                    options.pid = std::stoi(value);
+                else if (argument == "--rate")
+                    options.rate = std::stod(value);
+                else if (argument == "--repeat")
+                    options.repeat = static_cast<UINT>(std::stoul(value));
+                else
+                {
+                    std::fprintf(stderr, "Unknown argument %s.\n", argument.c_str());
+                    return false;
+                }
+            }
+            catch (const std::exception&)
+            {
+                std::fprintf(stderr, "Invalid value %s for %s.\n", value.c_str(), argument.c_str());
+                return false;
+            }
+        }
+
+        if (options.ipqPath.empty())
+        {
+            if (const auto ipqPathStringPointer = std::getenv("SharpDetect_IPQ_PATH"))
+                options.ipqPath = ipqPathStringPointer;
+        }
+
+        if (options.pid == 0)
+            options.pid = LibProfiler::PAL_GetCurrentPid();
+
+        return !options.tracePath.empty() &&
+            !options.ipqPath.empty() &&
+            !options.queueName.empty() &&
+            !options.queueSemaphoreName.empty() &&
+            options.rate >= 0;
+    }
+
+    // Whole recorded batches are enqueued as-is, so the consumer sees the same messages as during recording
+    void ReplayFullSpeed(LibIPC::TraceFileReader& reader, LibIPC::IpqProducer& producer, ReplayStatistics& statistics)
+    {
+        LibIPC::TraceBatch batch { };
+        while (reader.ReadNextBatch(batch))
+        {
+            producer.SendBatch(batch.data, batch.size);
+            statistics.records += batch.recordCount;
+            statistics.bytes += batch.size;
+            ++statistics.batches;
+        }
+    }
+
+    // Records are re-batched and paced against the wall clock to keep a steady event rate
+    void ReplayAtRate(
+        LibIPC::TraceFileReader& reader,
+        LibIPC::IpqProducer& producer,
+        const double rate,
+        const std::chrono::steady_clock::time_point start,
+        ReplayStatistics& statistics)
+    {
+        std::vector<char> buffer;
+        LibIPC::TraceBatch batch { };
+        while (reader.ReadNextBatch(batch))
+        {
+            std::size_t offset = 0;
+            const char* record = nullptr;
+            std::size_t size = 0;
+            while (LibIPC::TraceFileReader::TryReadRecord(batch, offset, record, size))
+            {
+                const auto due = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(static_cast<double>(statistics.records) / rate));
+                if (std::chrono::steady_clock::now() < due)
+                {
+                    // Do not hold back already paced records while waiting
+                    producer.Flush();
+                    std::this_thread::sleep_until(due);
+                }
+
+                buffer.assign(record, record + size);
+                producer.Send(buffer);
+                statistics.bytes += LibIPC::IpqProducer::RecordHeaderSize + size;
+                ++statistics.records;
+            }
+            ++statistics.batches;
+        }
+        producer.Flush();
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    loguru::g_stderr_verbosity = loguru::Verbosity_WARNING;
+
+    ReplayOptions options;
+    if (!TryParseArguments(argc, argv, options))
+    {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        LibIPC::TraceFileReader reader(options.tracePath);
+        LibIPC::IpqLibrary library(options.ipqPath);
+        LibIPC::IpqProducer producer(
+            library,
+            options.queueName,
+            options.queueFile,
+            options.queueSemaphoreName,
+            static_cast<INT>(options.queueSize));
+
+        if (options.registrationName.has_value())
+        {
+            const auto result = library.RegisterProcess(
+                options.registrationName.value(),
+                options.registrationFile,
+                static_cast<INT>(options.registrationSize),
+                options.pid);
+            if (result != 0)
+            {
+                std::fprintf(stderr, "Could not register process %d (error %d).\n", options.pid, result);
+                return EXIT_FAILURE;
+            }
+        }
+
+        ReplayStatistics statistics;
+        const auto start = std::chrono::steady_clock::now();
+        for (UINT iteration = 0; iteration < options.repeat; ++iteration)
+        {
+            reader.Rewind();
+            if (options.rate > 0)
+                ReplayAtRate(reader, producer, options.rate, start, statistics);
+            else
+                ReplayFullSpeed(reader, producer, statistics);
+        }
+        producer.Flush();
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::printf(
+            "Replayed %llu events in %llu batches (%.2f MiB) in %.3f s: %.0f events/s, %.2f MiB/s\n",
+            static_cast<unsigned long long>(statistics.records),
+            static_cast<unsigned long long>(statistics.batches),
+            static_cast<double>(statistics.bytes) / (1024.0 * 1024.0),
+            elapsed,
+            elapsed > 0 ? static_cast<double>(statistics.records) / elapsed : 0.0,
+            elapsed > 0 ? static_cast<double>(statistics.bytes) / (1024.0 * 1024.0) / elapsed : 0.0);
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "Replay failed: %s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
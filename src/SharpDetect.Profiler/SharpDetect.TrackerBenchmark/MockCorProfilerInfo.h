@@ -0,0 +1,222 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+
+#include "cor.h"
+#include "corprof.h"
+
+namespace Benchmark
+{
+    // Runtime stand-in for stack walks: DoStackSnapshot reports the frames of the stack set by SetStack and
+    // GetFunctionInfo resolves functions under a lock, as the runtime does. All other methods are not implemented
+    class MockCorProfilerInfo final : public ICorProfilerInfo10
+    {
+    public:
+        // Functions [0, count) get ids spaced like method descriptors, 512 methods per module
+        explicit MockCorProfilerInfo(const std::size_t functionsCount)
+        {
+            for (std::size_t index = 0; index < functionsCount; ++index)
+            {
+                const auto moduleId = static_cast<ModuleID>(ModulesStart + (index / MethodsPerModule) * ModuleIdStride);
+                const auto methodToken = static_cast<mdMethodDef>(mdtMethodDef | (index % MethodsPerModule + 1));
+                _functions.emplace(GetFunctionId(index), FunctionInfo { moduleId, methodToken });
+            }
+        }
+
+        [[nodiscard]] static FunctionID GetFunctionId(const std::size_t index)
+        {
+            return static_cast<FunctionID>(FunctionsStart + index * FunctionIdStride);
+        }
+
+        void SetStack(const std::span<const FunctionID> stack)
+        {
+            _stack = stack;
+        }
+
+        [[nodiscard]] std::size_t GetFunctionInfoCalls() const
+        {
+            return _functionInfoCalls.load(std::memory_order_relaxed);
+        }
+
+        HRESULT STDMETHODCALLTYPE GetFunctionInfo(
+            const FunctionID functionId,
+            ClassID* pClassId,
+            ModuleID* pModuleId,
+            mdToken* pToken) override
+        {
+            _functionInfoCalls.fetch_add(1, std::memory_order_relaxed);
+            std::lock_guard lock(_functionsMutex);
+            const auto it = _functions.find(functionId);
+            if (it == _functions.cend())
+                return E_INVALIDARG;
+
+            if (pClassId != nullptr)
+                *pClassId = 0;
+            if (pModuleId != nullptr)
+                *pModuleId = it->second.moduleId;
+            if (pToken != nullptr)
+                *pToken = it->second.methodToken;
+            return S_OK;
+        }
+
+        HRESULT STDMETHODCALLTYPE DoStackSnapshot(
+            ThreadID thread,
+            StackSnapshotCallback* callback,
+            ULONG32 infoFlags,
+            void* clientData,
+            BYTE context[],
+            ULONG32 contextSize) override
+        {
+            for (const auto functionId : _stack)
+            {
+                if (callback(functionId, 0, 0, 0, nullptr, clientData) != S_OK)
+                    return CORPROF_E_STACKSNAPSHOT_ABORTED;
+            }
+            return S_OK;
+        }
+
+        // IUnknown
+        HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) override { return E_NOINTERFACE; }
+        ULONG STDMETHODCALLTYPE AddRef() override { return 1; }
+        ULONG STDMETHODCALLTYPE Release() override { return 1; }
+
+        // ICorProfilerInfo
+        HRESULT STDMETHODCALLTYPE GetClassFromObject(ObjectID objectId, ClassID* pClassId) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetClassFromToken(ModuleID moduleId, mdTypeDef typeDef, ClassID* pClassId) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetCodeInfo(FunctionID functionId, LPCBYTE* pStart, ULONG* pcSize) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetEventMask(DWORD* pdwEvents) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetFunctionFromIP(LPCBYTE ip, FunctionID* pFunctionId) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetFunctionFromToken(ModuleID moduleId, mdToken token, FunctionID* pFunctionId) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetHandleFromThread(ThreadID threadId, HANDLE* phThread) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetObjectSize(ObjectID objectId, ULONG* pcSize) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE IsArrayClass(ClassID classId, CorElementType* pBaseElemType, ClassID* pBaseClassId, ULONG* pcRank) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetThreadInfo(ThreadID threadId, DWORD* pdwWin32ThreadId) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetCurrentThreadID(ThreadID* pThreadId) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetClassIDInfo(ClassID classId, ModuleID* pModuleId, mdTypeDef* pTypeDefToken) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE SetEventMask(DWORD dwEvents) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE SetEnterLeaveFunctionHooks(FunctionEnter* pFuncEnter, FunctionLeave* pFuncLeave, FunctionTailcall* pFuncTailcall) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE SetFunctionIDMapper(FunctionIDMapper* pFunc) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetTokenAndMetaDataFromFunction(FunctionID functionId, REFIID riid, IUnknown** ppImport, mdToken* pToken) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetModuleInfo(ModuleID moduleId, LPCBYTE* ppBaseLoadAddress, ULONG cchName, ULONG* pcchName, WCHAR szName[], AssemblyID* pAssemblyId) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetModuleMetaData(ModuleID moduleId, DWORD dwOpenFlags, REFIID riid, IUnknown** ppOut) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetILFunctionBody(ModuleID moduleId, mdMethodDef methodId, LPCBYTE* ppMethodHeader, ULONG* pcbMethodSize) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetILFunctionBodyAllocator(ModuleID moduleId, IMethodMalloc** ppMalloc) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE SetILFunctionBody(ModuleID moduleId, mdMethodDef methodid, LPCBYTE pbNewILMethodHeader) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetAppDomainInfo(AppDomainID appDomainId, ULONG cchName, ULONG* pcchName, WCHAR szName[], ProcessID* pProcessId) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetAssemblyInfo(AssemblyID assemblyId, ULONG cchName, ULONG* pcchName, WCHAR szName[], AppDomainID* pAppDomainId, ModuleID* pModuleId) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE SetFunctionReJIT(FunctionID functionId) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE ForceGC(void) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE SetILInstrumentedCodeMap(FunctionID functionId, BOOL fStartJit, ULONG cILMapEntries, COR_IL_MAP rgILMapEntries[]) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetInprocInspectionInterface(IUnknown** ppicd) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetInprocInspectionIThisThread(IUnknown** ppicd) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetThreadContext(ThreadID threadId, ContextID* pContextId) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE BeginInprocDebugging(BOOL fThisThreadOnly, DWORD* pdwProfilerContext) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE EndInprocDebugging(DWORD dwProfilerContext) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetILToNativeMapping(FunctionID functionId, ULONG32 cMap, ULONG32* pcMap, COR_DEBUG_IL_TO_NATIVE_MAP map[]) override { return E_NOTIMPL; }
+
+        // ICorProfilerInfo2
+        HRESULT STDMETHODCALLTYPE SetEnterLeaveFunctionHooks2(FunctionEnter2* pFuncEnter, FunctionLeave2* pFuncLeave, FunctionTailcall2* pFuncTailcall) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetFunctionInfo2(FunctionID funcId, COR_PRF_FRAME_INFO frameInfo, ClassID* pClassId, ModuleID* pModuleId, mdToken* pToken, ULONG32 cTypeArgs, ULONG32* pcTypeArgs, ClassID typeArgs[]) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetStringLayout(ULONG* pBufferLengthOffset, ULONG* pStringLengthOffset, ULONG* pBufferOffset) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetClassLayout(ClassID classID, COR_FIELD_OFFSET rFieldOffset[], ULONG cFieldOffset, ULONG* pcFieldOffset, ULONG* pulClassSize) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetClassIDInfo2(ClassID classId, ModuleID* pModuleId, mdTypeDef* pTypeDefToken, ClassID* pParentClassId, ULONG32 cNumTypeArgs, ULONG32* pcNumTypeArgs, ClassID typeArgs[]) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetCodeInfo2(FunctionID functionID, ULONG32 cCodeInfos, ULONG32* pcCodeInfos, COR_PRF_CODE_INFO codeInfos[]) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetClassFromTokenAndTypeArgs(ModuleID moduleID, mdTypeDef typeDef, ULONG32 cTypeArgs, ClassID typeArgs[], ClassID* pClassID) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetFunctionFromTokenAndTypeArgs(ModuleID moduleID, mdMethodDef funcDef, ClassID classId, ULONG32 cTypeArgs, ClassID typeArgs[], FunctionID* pFunctionID) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE EnumModuleFrozenObjects(ModuleID moduleID, ICorProfilerObjectEnum** ppEnum) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetArrayObjectInfo(ObjectID objectId, ULONG32 cDimensions, ULONG32 pDimensionSizes[], int pDimensionLowerBounds[], BYTE** ppData) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetBoxClassLayout(ClassID classId, ULONG32* pBufferOffset) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetThreadAppDomain(ThreadID threadId, AppDomainID* pAppDomainId) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetRVAStaticAddress(ClassID classId, mdFieldDef fieldToken, void** ppAddress) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetAppDomainStaticAddress(ClassID classId, mdFieldDef fieldToken, AppDomainID appDomainId, void** ppAddress) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetThreadStaticAddress(ClassID classId, mdFieldDef fieldToken, ThreadID threadId, void** ppAddress) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetContextStaticAddress(ClassID classId, mdFieldDef fieldToken, ContextID contextId, void** ppAddress) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetStaticFieldInfo(ClassID classId, mdFieldDef fieldToken, COR_PRF_STATIC_TYPE* pFieldInfo) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetGenerationBounds(ULONG cObjectRanges, ULONG* pcObjectRanges, COR_PRF_GC_GENERATION_RANGE ranges[]) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetObjectGeneration(ObjectID objectId, COR_PRF_GC_GENERATION_RANGE* range) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetNotifiedExceptionClauseInfo(COR_PRF_EX_CLAUSE_INFO* pinfo) override { return E_NOTIMPL; }
+
+        // ICorProfilerInfo3
+        HRESULT STDMETHODCALLTYPE EnumJITedFunctions(ICorProfilerFunctionEnum** ppEnum) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE RequestProfilerDetach(DWORD dwExpectedCompletionMilliseconds) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE SetFunctionIDMapper2(FunctionIDMapper2* pFunc, void* clientData) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetStringLayout2(ULONG* pStringLengthOffset, ULONG* pBufferOffset) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE SetEnterLeaveFunctionHooks3(FunctionEnter3* pFuncEnter3, FunctionLeave3* pFuncLeave3, FunctionTailcall3* pFuncTailcall3) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE SetEnterLeaveFunctionHooks3WithInfo(FunctionEnter3WithInfo* pFuncEnter3WithInfo, FunctionLeave3WithInfo* pFuncLeave3WithInfo, FunctionTailcall3WithInfo* pFuncTailcall3WithInfo) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetFunctionEnter3Info(FunctionID functionId, COR_PRF_ELT_INFO eltInfo, COR_PRF_FRAME_INFO* pFrameInfo, ULONG* pcbArgumentInfo, COR_PRF_FUNCTION_ARGUMENT_INFO* pArgumentInfo) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetFunctionLeave3Info(FunctionID functionId, COR_PRF_ELT_INFO eltInfo, COR_PRF_FRAME_INFO* pFrameInfo, COR_PRF_FUNCTION_ARGUMENT_RANGE* pRetvalRange) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetFunctionTailcall3Info(FunctionID functionId, COR_PRF_ELT_INFO eltInfo, COR_PRF_FRAME_INFO* pFrameInfo) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE EnumModules(ICorProfilerModuleEnum** ppEnum) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetRuntimeInformation(USHORT* pClrInstanceId, COR_PRF_RUNTIME_TYPE* pRuntimeType, USHORT* pMajorVersion, USHORT* pMinorVersion, USHORT* pBuildNumber, USHORT* pQFEVersion, ULONG cchVersionString, ULONG* pcchVersionString, WCHAR szVersionString[]) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetThreadStaticAddress2(ClassID classId, mdFieldDef fieldToken, AppDomainID appDomainId, ThreadID threadId, void** ppAddress) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetAppDomainsContainingModule(ModuleID moduleId, ULONG32 cAppDomainIds, ULONG32* pcAppDomainIds, AppDomainID appDomainIds[]) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetModuleInfo2(ModuleID moduleId, LPCBYTE* ppBaseLoadAddress, ULONG cchName, ULONG* pcchName, WCHAR szName[], AssemblyID* pAssemblyId, DWORD* pdwModuleFlags) override { return E_NOTIMPL; }
+
+        // ICorProfilerInfo4
+        HRESULT STDMETHODCALLTYPE EnumThreads(ICorProfilerThreadEnum** ppEnum) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE InitializeCurrentThread(void) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE RequestReJIT(ULONG cFunctions, ModuleID moduleIds[], mdMethodDef methodIds[]) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE RequestRevert(ULONG cFunctions, ModuleID moduleIds[], mdMethodDef methodIds[], HRESULT status[]) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetCodeInfo3(FunctionID functionID, ReJITID reJitId, ULONG32 cCodeInfos, ULONG32* pcCodeInfos, COR_PRF_CODE_INFO codeInfos[]) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetFunctionFromIP2(LPCBYTE ip, FunctionID* pFunctionId, ReJITID* pReJitId) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetReJITIDs(FunctionID functionId, ULONG cReJitIds, ULONG* pcReJitIds, ReJITID reJitIds[]) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetILToNativeMapping2(FunctionID functionId, ReJITID reJitId, ULONG32 cMap, ULONG32* pcMap, COR_DEBUG_IL_TO_NATIVE_MAP map[]) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE EnumJITedFunctions2(ICorProfilerFunctionEnum** ppEnum) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetObjectSize2(ObjectID objectId, SIZE_T* pcSize) override { return E_NOTIMPL; }
+
+        // ICorProfilerInfo5
+        HRESULT STDMETHODCALLTYPE GetEventMask2(DWORD* pdwEventsLow, DWORD* pdwEventsHigh) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE SetEventMask2(DWORD dwEventsLow, DWORD dwEventsHigh) override { return E_NOTIMPL; }
+
+        // ICorProfilerInfo6
+        HRESULT STDMETHODCALLTYPE EnumNgenModuleMethodsInliningThisMethod(ModuleID inlinersModuleId, ModuleID inlineeModuleId, mdMethodDef inlineeMethodId, BOOL* incompleteData, ICorProfilerMethodEnum** ppEnum) override { return E_NOTIMPL; }
+
+        // ICorProfilerInfo7
+        HRESULT STDMETHODCALLTYPE ApplyMetaData(ModuleID moduleId) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetInMemorySymbolsLength(ModuleID moduleId, DWORD* pCountSymbolBytes) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE ReadInMemorySymbols(ModuleID moduleId, DWORD symbolsReadOffset, BYTE* pSymbolBytes, DWORD countSymbolBytes, DWORD* pCountSymbolBytesRead) override { return E_NOTIMPL; }
+
+        // ICorProfilerInfo8
+        HRESULT STDMETHODCALLTYPE IsFunctionDynamic(FunctionID functionId, BOOL* isDynamic) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetFunctionFromIP3(LPCBYTE ip, FunctionID* functionId, ReJITID* pReJitId) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetDynamicFunctionInfo(FunctionID functionId, ModuleID* moduleId, PCCOR_SIGNATURE* ppvSig, ULONG* pbSig, ULONG cchName, ULONG* pcchName, WCHAR wszName[]) override { return E_NOTIMPL; }
+
+        // ICorProfilerInfo9
+        HRESULT STDMETHODCALLTYPE GetNativeCodeStartAddresses(FunctionID functionID, ReJITID reJitId, ULONG32 cCodeStartAddresses, ULONG32* pcCodeStartAddresses, UINT_PTR codeStartAddresses[]) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetILToNativeMapping3(UINT_PTR pNativeCodeStartAddress, ULONG32 cMap, ULONG32* pcMap, COR_DEBUG_IL_TO_NATIVE_MAP map[]) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetCodeInfo4(UINT_PTR pNativeCodeStartAddress, ULONG32 cCodeInfos, ULONG32* pcCodeInfos, COR_PRF_CODE_INFO codeInfos[]) override { return E_NOTIMPL; }
+
+        // ICorProfilerInfo10
+        HRESULT STDMETHODCALLTYPE EnumerateObjectReferences(ObjectID objectId, ObjectReferenceCallback callback, void* clientData) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE IsFrozenObject(ObjectID objectId, BOOL* pbFrozen) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetLOHObjectSizeThreshold(DWORD* pThreshold) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE RequestReJITWithInliners(DWORD dwRejitFlags, ULONG cFunctions, ModuleID moduleIds[], mdMethodDef methodIds[]) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE SuspendRuntime(void) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE ResumeRuntime(void) override { return E_NOTIMPL; }
+
+    private:
+        struct FunctionInfo
+        {
+            ModuleID moduleId;
+            mdMethodDef methodToken;
+        };
+
+        static constexpr UINT_PTR FunctionsStart = 0x7f0000010000;
+        static constexpr UINT_PTR FunctionIdStride = 0x38;
+        static constexpr UINT_PTR ModulesStart = 0x7e0000000000;
+        static constexpr UINT_PTR ModuleIdStride = 0x1000;
+        static constexpr std::size_t MethodsPerModule = 512;
+
+        std::unordered_map<FunctionID, FunctionInfo> _functions;
+        std::mutex _functionsMutex;
+        std::span<const FunctionID> _stack;
+        std::atomic<std::size_t> _functionInfoCalls { 0 };
+    };
+}
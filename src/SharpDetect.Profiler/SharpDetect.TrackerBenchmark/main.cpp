@@ -0,0 +1,725 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <optional>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "../lib/loguru/loguru.hpp"
+
+#include "../LibProfilerCore/FunctionInfoCache.h"
+#include "../LibProfilerCore/GarbageCollectionPipeline.h"
+#include "../LibProfilerCore/ObjectsTracker.h"
+#include "../LibProfilerCore/StackWalker.h"
+
+#include "MockCorProfilerInfo.h"
+
+namespace
+{
+    constexpr ObjectID HeapStart = 0x10000000;
+    constexpr SIZE_T ObjectSize = 32;
+    // Same granularity as the regions of the runtime GC (4 MB / 64 KB objects are in the same order of magnitude)
+    constexpr std::size_t RegionCapacity = 64 * 1024;
+    constexpr std::size_t MaxGeneration = COR_PRF_GC_GEN_2;
+    // Same chunking as the profiler uses when reporting removed tracked objects
+    constexpr std::size_t TrackedObjectIdsChunkSize = 64 * 1024;
+    // Lock-heavy code keeps walking the same few hundred call paths
+    constexpr std::size_t DistinctStacks = 256;
+
+    struct BenchmarkOptions
+    {
+        std::string scenario { "ranges" };
+        std::size_t objects { 1000000 };
+        std::vector<std::size_t> rangeCounts { 1000, 10000, 100000 };
+        std::vector<std::size_t> additionalWorkers { 0, 1, 3, 7 };
+        // The runtime reports references in batches, not all at once
+        std::size_t rangesPerCallback { 1024 };
+        std::size_t iterations { 5 };
+        // Generations collected by consecutive GCs of the heap scenario, repeated until enough GCs were performed
+        std::vector<std::size_t> pattern { 0, 0, 0, 1, 0, 0, 0, 2 };
+        std::size_t collections { 32 };
+        std::vector<std::size_t> survivalPercents { 10, 50, 90 };
+        std::size_t compactingPercent { 90 };
+        std::size_t runLength { 8 };
+        std::size_t seed { 42 };
+        bool deferred { false };
+        std::size_t functions { 4096 };
+        std::size_t frames { 32 };
+        std::size_t walks { 100000 };
+    };
+
+    struct SyntheticRanges
+    {
+        std::vector<ObjectID> survivingStarts;
+        std::vector<SIZE_T> survivingLengths;
+        std::vector<ObjectID> movedOldStarts;
+        std::vector<ObjectID> movedNewStarts;
+        std::vector<SIZE_T> movedLengths;
+    };
+
+    struct Measurement
+    {
+        double callbacksMs;
+        double finishMs;
+    };
+
+    // Contiguous part of the synthetic heap, all objects within it belong to the same generation
+    struct Region
+    {
+        ObjectID start;
+        std::size_t generation;
+        // Offsets of live objects (ascending)
+        std::vector<std::uint32_t> live;
+        // Objects are never allocated below this offset again
+        std::size_t used;
+        bool released;
+    };
+
+    struct SyntheticHeap
+    {
+        std::vector<Region> regions;
+        std::vector<ObjectID> freeRegions;
+        ObjectID nextRegionStart { HeapStart };
+        // Region receiving new objects of each generation (index into regions)
+        std::array<std::optional<std::size_t>, MaxGeneration + 1> tails;
+    };
+
+    struct SyntheticCollection
+    {
+        std::vector<BOOL> collectedGenerations;
+        std::vector<COR_PRF_GC_GENERATION_RANGE> bounds;
+        SyntheticRanges ranges;
+        std::size_t collectedObjects { 0 };
+    };
+
+    struct CollectionMeasurement
+    {
+        double trackMs;
+        double startMs;
+        double callbacksMs;
+        double finishMs;
+        double applyMs;
+        std::size_t ranges;
+        std::size_t collectedObjects;
+    };
+
+    void PrintUsage()
+    {
+        std::fprintf(stderr,
+            "Usage: SharpDetect.TrackerBenchmark [--scenario ranges|heap|stacks] [--objects <count>]\n"
+            "                                    [--workers <additional workers,...>] [--ranges-per-callback <count>]\n"
+            "\n"
+            "  ranges scenario:                  [--ranges <count,...>] [--iterations <count>]\n"
+            "    Measures how long the objects tracker spends in surviving / moved references callbacks\n"
+            "    and in finishing a compacting gen0 GC over synthetic range sets.\n"
+            "\n"
+            "  heap scenario:                    [--pattern <generation,...>] [--collections <count>]\n"
+            "                                    [--survival <gen0 %%,gen1 %%,gen2 %%>] [--compacting <%%>]\n"
+            "                                    [--run-length <objects>] [--seed <value>] [--deferred <0|1>]\n"
+            "    Simulates a region-based heap of <objects> tracked objects (70%% gen2, 10%% gen1, 20%% gen0)\n"
+            "    and runs a sequence of GCs over it. Before each GC, another 20%% of <objects> is allocated.\n"
+            "    Survivors are picked in runs of <run-length> objects on average, regions are either compacted\n"
+            "    (survivors move into the next generation) or swept (the region is promoted in place).\n"
+            "    Reports median time per GC phase for each collected generation and peak memory of the process,\n"
+            "    which includes the synthetic heap itself (4 bytes per live object). Uses the first --workers value.\n"
+            "    With --deferred 1, GC callbacks only record the ranges and the tracker is updated on a background\n"
+            "    thread, the time until it catches up is reported separately from the pause.\n"
+            "\n"
+            "  stacks scenario:                  [--functions <count>] [--frames <depth>] [--walks <count>]\n"
+            "                                    [--iterations <count>] [--seed <value>]\n"
+            "    Captures <walks> stack traces of <frames> frames from a mocked runtime, cycling over a fixed set\n"
+            "    of stacks built from <functions> distinct functions. Compares resolving each frame through\n"
+            "    the runtime with resolving it through the function info cache.\n");
+    }
+
+    std::vector<std::size_t> ParseList(const std::string& value)
+    {
+        std::vector<std::size_t> result;
+        std::stringstream stream(value);
+        std::string item;
+        while (std::getline(stream, item, ','))
+            result.push_back(static_cast<std::size_t>(std::stoull(item)));
+        return result;
+    }
+
+    bool TryParseArguments(const int argc, char** argv, BenchmarkOptions& options)
+    {
+        for (auto i = 1; i < argc; ++i)
+        {
+            const std::string argument(argv[i]);
+            if (i + 1 >= argc)
+            {
+                std::fprintf(stderr, "Missing value for %s.\n", argument.c_str());
+                return false;
+            }
+
+            const std::string value(argv[++i]);
+            try
+            {
+                if (argument == "--scenario")
+                    options.scenario = value;
+                else if (argument == "--objects")
+                    options.objects = static_cast<std::size_t>(std::stoull(value));
+                else if (argument == "--ranges")
+                    options.rangeCounts = ParseList(value);
+                else if (argument == "--workers")
+                    options.additionalWorkers = ParseList(value);
+                else if (argument == "--ranges-per-callback")
+                    options.rangesPerCallback = static_cast<std::size_t>(std::stoull(value));
+                else if (argument == "--iterations")
+                    options.iterations = static_cast<std::size_t>(std::stoull(value));
+                else if (argument == "--pattern")
+                    options.pattern = ParseList(value);
+                else if (argument == "--collections")
+                    options.collections = static_cast<std::size_t>(std::stoull(value));
+                else if (argument == "--survival")
+                    options.survivalPercents = ParseList(value);
+                else if (argument == "--compacting")
+                    options.compactingPercent = static_cast<std::size_t>(std::stoull(value));
+                else if (argument == "--run-length")
+                    options.runLength = static_cast<std::size_t>(std::stoull(value));
+                else if (argument == "--seed")
+                    options.seed = static_cast<std::size_t>(std::stoull(value));
+                else if (argument == "--deferred")
+                    options.deferred = std::stoull(value) != 0;
+                else if (argument == "--functions")
+                    options.functions = static_cast<std::size_t>(std::stoull(value));
+                else if (argument == "--frames")
+                    options.frames = static_cast<std::size_t>(std::stoull(value));
+                else if (argument == "--walks")
+                    options.walks = static_cast<std::size_t>(std::stoull(value));
+                else
+                {
+                    std::fprintf(stderr, "Unknown argument %s.\n", argument.c_str());
+                    return false;
+                }
+            }
+            catch (const std::exception&)
+            {
+                std::fprintf(stderr, "Invalid value %s for %s.\n", value.c_str(), argument.c_str());
+                return false;
+            }
+        }
+
+        const auto isPercent = [](const std::size_t value) { return value <= 100; };
+        const auto isGeneration = [](const std::size_t value) { return value <= MaxGeneration; };
+        return (options.scenario == "ranges" || options.scenario == "heap" || options.scenario == "stacks") &&
+            options.objects > 0 &&
+            options.rangesPerCallback > 0 &&
+            options.iterations > 0 &&
+            !options.rangeCounts.empty() &&
+            !options.additionalWorkers.empty() &&
+            !options.pattern.empty() &&
+            std::ranges::all_of(options.pattern, isGeneration) &&
+            options.collections > 0 &&
+            options.survivalPercents.size() == MaxGeneration + 1 &&
+            std::ranges::all_of(options.survivalPercents, isPercent) &&
+            isPercent(options.compactingPercent) &&
+            options.runLength > 0 &&
+            options.functions > 0 &&
+            options.frames > 0 &&
+            options.walks > 0;
+    }
+
+    // Splits the heap into equally sized ranges, even ones survive in place and odd ones are compacted
+    // into a separate region, as if promoted into a different generation
+    SyntheticRanges CreateRanges(const std::size_t objects, const std::size_t rangeCount)
+    {
+        SyntheticRanges ranges;
+        const auto heapEnd = HeapStart + objects * ObjectSize;
+        const auto rangeLength = std::max<SIZE_T>(ObjectSize, (objects / rangeCount) * ObjectSize);
+        auto destination = heapEnd + rangeLength;
+        auto index = 0;
+        for (auto start = HeapStart; start < heapEnd; start += rangeLength, ++index)
+        {
+            const auto length = std::min<SIZE_T>(rangeLength, heapEnd - start);
+            if (index % 2 == 0)
+            {
+                ranges.survivingStarts.push_back(start);
+                ranges.survivingLengths.push_back(length);
+            }
+            else
+            {
+                ranges.movedOldStarts.push_back(start);
+                ranges.movedNewStarts.push_back(destination);
+                ranges.movedLengths.push_back(length);
+                destination += length;
+            }
+        }
+        return ranges;
+    }
+
+    // Reports to the tracker directly or through a GC pipeline
+    template<typename Target>
+    void ReportRanges(Target& tracker, SyntheticRanges& ranges, const std::size_t batch)
+    {
+        for (std::size_t offset = 0; offset < ranges.movedOldStarts.size(); offset += batch)
+        {
+            const auto count = std::min(batch, ranges.movedOldStarts.size() - offset);
+            tracker.ProcessMovingReferences(
+                std::span(ranges.movedOldStarts).subspan(offset, count),
+                std::span(ranges.movedNewStarts).subspan(offset, count),
+                std::span(ranges.movedLengths).subspan(offset, count));
+        }
+        for (std::size_t offset = 0; offset < ranges.survivingStarts.size(); offset += batch)
+        {
+            const auto count = std::min(batch, ranges.survivingStarts.size() - offset);
+            tracker.ProcessSurvivingReferences(
+                std::span(ranges.survivingStarts).subspan(offset, count),
+                std::span(ranges.survivingLengths).subspan(offset, count));
+        }
+    }
+
+    Measurement RunGarbageCollection(
+        const BenchmarkOptions& options,
+        const std::size_t additionalWorkers,
+        SyntheticRanges& ranges)
+    {
+        LibProfiler::ObjectsTracker tracker(additionalWorkers);
+        for (std::size_t index = 0; index < options.objects; ++index)
+            static_cast<void>(tracker.GetTrackedObject(HeapStart + index * ObjectSize));
+
+        std::vector<BOOL> collectedGenerations { TRUE, FALSE, FALSE, FALSE, FALSE };
+        std::vector<COR_PRF_GC_GENERATION_RANGE> bounds {
+            { COR_PRF_GC_GEN_0, HeapStart, options.objects * ObjectSize, options.objects * ObjectSize } };
+        tracker.ProcessGarbageCollectionStarted(std::move(collectedGenerations), std::move(bounds));
+
+        const auto callbacksStart = std::chrono::steady_clock::now();
+        ReportRanges(tracker, ranges, options.rangesPerCallback);
+        const auto finishStart = std::chrono::steady_clock::now();
+        const auto gcContext = tracker.ProcessGarbageCollectionFinished();
+        const auto finishEnd = std::chrono::steady_clock::now();
+
+        return {
+            std::chrono::duration<double, std::milli>(finishStart - callbacksStart).count(),
+            std::chrono::duration<double, std::milli>(finishEnd - finishStart).count() };
+    }
+
+    double Median(std::vector<double>& values)
+    {
+        std::ranges::sort(values);
+        return values[values.size() / 2];
+    }
+
+    double ElapsedMs(const std::chrono::steady_clock::time_point start, const std::chrono::steady_clock::time_point end)
+    {
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    std::size_t GetPeakMemoryBytes()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters { };
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return 0;
+        return counters.PeakWorkingSetSize;
+#else
+        rusage usage { };
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+        // Reported in kilobytes
+        return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+    }
+
+    std::size_t OpenRegion(SyntheticHeap& heap, const std::size_t generation)
+    {
+        // Released regions are reused, so new objects appear at addresses of collected ones
+        auto start = heap.nextRegionStart;
+        if (!heap.freeRegions.empty())
+        {
+            start = heap.freeRegions.back();
+            heap.freeRegions.pop_back();
+        }
+        else
+        {
+            heap.nextRegionStart += RegionCapacity * ObjectSize;
+        }
+
+        heap.regions.push_back({ start, generation, { }, 0, false });
+        heap.tails[generation] = heap.regions.size() - 1;
+        return heap.regions.size() - 1;
+    }
+
+    ObjectID Allocate(SyntheticHeap& heap, const std::size_t generation)
+    {
+        auto tail = heap.tails[generation];
+        if (!tail.has_value() || heap.regions[*tail].used == RegionCapacity)
+            tail = OpenRegion(heap, generation);
+
+        auto& region = heap.regions[*tail];
+        const auto offset = region.used++;
+        region.live.push_back(static_cast<std::uint32_t>(offset));
+        return region.start + offset * ObjectSize;
+    }
+
+    std::size_t CountLiveObjects(const SyntheticHeap& heap)
+    {
+        std::size_t count = 0;
+        for (const auto& region : heap.regions)
+            count += region.live.size();
+        return count;
+    }
+
+    // Collects generations up to (including) the given one, survivors of compacted regions are moved
+    // into the next generation, swept regions are promoted with survivors staying in place
+    SyntheticCollection Collect(
+        SyntheticHeap& heap,
+        const std::size_t condemnedGeneration,
+        const BenchmarkOptions& options,
+        std::mt19937_64& random)
+    {
+        SyntheticCollection collection;
+        collection.collectedGenerations.assign(COR_PRF_GC_PINNED_OBJECT_HEAP + 1, FALSE);
+        for (std::size_t generation = 0; generation <= condemnedGeneration; generation++)
+            collection.collectedGenerations[generation] = TRUE;
+
+        for (const auto& region : heap.regions)
+        {
+            collection.bounds.push_back({
+                static_cast<COR_PRF_GC_GENERATION>(region.generation),
+                region.start,
+                region.used * ObjectSize,
+                RegionCapacity * ObjectSize });
+        }
+
+        // Survivors of collected generations are never compacted into regions that are being collected
+        for (std::size_t generation = 0; generation <= condemnedGeneration; generation++)
+            heap.tails[generation].reset();
+
+        std::uniform_int_distribution<std::size_t> percent(0, 99);
+        std::geometric_distribution<std::size_t> runLength(1.0 / static_cast<double>(options.runLength));
+        std::vector<ObjectID> releasedRegions;
+        const auto condemnedRegions = heap.regions.size();
+        for (std::size_t index = 0; index < condemnedRegions; index++)
+        {
+            if (heap.regions[index].generation > condemnedGeneration)
+                continue;
+
+            const auto generation = heap.regions[index].generation;
+            const auto start = heap.regions[index].start;
+            const auto live = std::move(heap.regions[index].live);
+            std::vector<std::uint32_t> survivors;
+            for (std::size_t offset = 0; offset < live.size();)
+            {
+                const auto end = std::min(live.size(), offset + runLength(random) + 1);
+                if (percent(random) < options.survivalPercents[generation])
+                    survivors.insert(survivors.end(), live.begin() + offset, live.begin() + end);
+                offset = end;
+            }
+
+            collection.collectedObjects += live.size() - survivors.size();
+            const auto target = std::min(generation + 1, MaxGeneration);
+            auto& ranges = collection.ranges;
+            if (percent(random) < options.compactingPercent)
+            {
+                std::optional<std::uint32_t> previous;
+                for (const auto survivor : survivors)
+                {
+                    const auto oldStart = start + survivor * ObjectSize;
+                    const auto newStart = Allocate(heap, target);
+                    if (previous.has_value() && *previous + 1 == survivor &&
+                        ranges.movedNewStarts.back() + ranges.movedLengths.back() == newStart)
+                    {
+                        ranges.movedLengths.back() += ObjectSize;
+                    }
+                    else
+                    {
+                        ranges.movedOldStarts.push_back(oldStart);
+                        ranges.movedNewStarts.push_back(newStart);
+                        ranges.movedLengths.push_back(ObjectSize);
+                    }
+                    previous = survivor;
+                }
+
+                heap.regions[index].released = true;
+                releasedRegions.push_back(start);
+            }
+            else
+            {
+                std::optional<std::uint32_t> previous;
+                for (const auto survivor : survivors)
+                {
+                    if (previous.has_value() && *previous + 1 == survivor)
+                    {
+                        ranges.survivingLengths.back() += ObjectSize;
+                    }
+                    else
+                    {
+                        ranges.survivingStarts.push_back(start + survivor * ObjectSize);
+                        ranges.survivingLengths.push_back(ObjectSize);
+                    }
+                    previous = survivor;
+                }
+
+                auto& region = heap.regions[index];
+                region.generation = target;
+                region.released = survivors.empty();
+                if (region.released)
+                    releasedRegions.push_back(start);
+                region.live = std::move(survivors);
+            }
+        }
+
+        std::erase_if(heap.regions, [](const Region& region) { return region.released; });
+        heap.freeRegions.insert(heap.freeRegions.end(), releasedRegions.begin(), releasedRegions.end());
+        heap.tails = { };
+        for (std::size_t index = 0; index < heap.regions.size(); index++)
+        {
+            if (heap.regions[index].used < RegionCapacity)
+                heap.tails[heap.regions[index].generation] = index;
+        }
+        return collection;
+    }
+
+    int RunHeapScenario(const BenchmarkOptions& options)
+    {
+        std::mt19937_64 random(options.seed);
+        SyntheticHeap heap;
+        LibProfiler::ObjectsTracker tracker(options.additionalWorkers.front());
+        // Written by the thread applying the GC, read once the pipeline was flushed
+        // Removed objects are visited while the tracker finishes the GC, so their time is part of finishing (or applying)
+        std::size_t lastRemovedObjects = 0;
+        LibProfiler::GarbageCollectionPipeline pipeline(tracker, options.deferred, TrackedObjectIdsChunkSize, {
+            [&](std::vector<LibProfiler::TrackedObjectId>&) { lastRemovedObjects = 0; },
+            [&](const std::span<const LibProfiler::TrackedObjectId> chunk) { lastRemovedObjects += chunk.size(); },
+            [](UINT, UINT) { } });
+        const auto allocationsPerCycle = std::max<std::size_t>(options.objects / 5, 1);
+
+        const auto populateStart = std::chrono::steady_clock::now();
+        const std::array<std::size_t, MaxGeneration + 1> initialObjects {
+            allocationsPerCycle, options.objects / 10, options.objects - allocationsPerCycle - options.objects / 10 };
+        for (auto generation = MaxGeneration + 1; generation-- > 0;)
+        {
+            for (std::size_t index = 0; index < initialObjects[generation]; index++)
+                static_cast<void>(tracker.GetTrackedObject(Allocate(heap, generation)));
+        }
+        const auto populateEnd = std::chrono::steady_clock::now();
+
+        std::printf("%zu tracked objects, %zu allocated between GCs, %zu GCs, survival %zu/%zu/%zu%%, %zu%% compacting%s\n",
+            options.objects, allocationsPerCycle, options.collections,
+            options.survivalPercents[0], options.survivalPercents[1], options.survivalPercents[2],
+            options.compactingPercent, options.deferred ? ", deferred bookkeeping" : "");
+        std::printf("initial heap tracked in %.3f ms\n", ElapsedMs(populateStart, populateEnd));
+
+        std::array<std::vector<CollectionMeasurement>, MaxGeneration + 1> measurements;
+        for (std::size_t collection = 0; collection < options.collections; collection++)
+        {
+            // The first GC sees the initial heap, later ones see objects allocated since the previous GC
+            auto trackMs = 0.0;
+            if (collection > 0)
+            {
+                const auto trackStart = std::chrono::steady_clock::now();
+                for (std::size_t index = 0; index < allocationsPerCycle; index++)
+                    static_cast<void>(tracker.GetTrackedObject(Allocate(heap, COR_PRF_GC_GEN_0)));
+                trackMs = ElapsedMs(trackStart, std::chrono::steady_clock::now());
+            }
+
+            const auto condemnedGeneration = options.pattern[collection % options.pattern.size()];
+            auto synthetic = Collect(heap, condemnedGeneration, options, random);
+            const auto ranges = synthetic.ranges.survivingStarts.size() + synthetic.ranges.movedOldStarts.size();
+
+            const auto startStart = std::chrono::steady_clock::now();
+            pipeline.ProcessGarbageCollectionStarted(std::move(synthetic.collectedGenerations), std::move(synthetic.bounds));
+            const auto callbacksStart = std::chrono::steady_clock::now();
+            ReportRanges(pipeline, synthetic.ranges, options.rangesPerCallback);
+            const auto finishStart = std::chrono::steady_clock::now();
+            pipeline.ProcessGarbageCollectionFinished({ });
+            const auto applyStart = std::chrono::steady_clock::now();
+            pipeline.Flush();
+            const auto applyEnd = std::chrono::steady_clock::now();
+
+            if (lastRemovedObjects != synthetic.collectedObjects)
+            {
+                std::fprintf(stderr, "GC #%zu removed %zu tracked objects, expected %zu.\n",
+                    collection, lastRemovedObjects, synthetic.collectedObjects);
+                return EXIT_FAILURE;
+            }
+
+            measurements[condemnedGeneration].push_back({
+                trackMs,
+                ElapsedMs(startStart, callbacksStart),
+                ElapsedMs(callbacksStart, finishStart),
+                ElapsedMs(finishStart, applyStart),
+                ElapsedMs(applyStart, applyEnd),
+                ranges,
+                lastRemovedObjects });
+        }
+
+        std::printf("%10s %5s %10s %10s %10s %10s %15s %12s %11s %11s\n", "generation", "GCs", "ranges", "removed",
+            "track [ms]", "start [ms]", "callbacks [ms]", "finish [ms]", "apply [ms]", "pause [ms]");
+        for (std::size_t generation = 0; generation <= MaxGeneration; generation++)
+        {
+            const auto& gcs = measurements[generation];
+            if (gcs.empty())
+                continue;
+
+            std::vector<double> track, start, callbacks, finish, apply, pause;
+            std::size_t ranges = 0;
+            std::size_t removedObjects = 0;
+            for (const auto& gc : gcs)
+            {
+                track.push_back(gc.trackMs);
+                start.push_back(gc.startMs);
+                callbacks.push_back(gc.callbacksMs);
+                finish.push_back(gc.finishMs);
+                apply.push_back(gc.applyMs);
+                pause.push_back(gc.startMs + gc.callbacksMs + gc.finishMs);
+                ranges += gc.ranges;
+                removedObjects += gc.collectedObjects;
+            }
+
+            std::printf("%10zu %5zu %10zu %10zu %10.3f %10.3f %15.3f %12.3f %11.3f %11.3f\n",
+                generation,
+                gcs.size(),
+                ranges / gcs.size(),
+                removedObjects / gcs.size(),
+                Median(track),
+                Median(start),
+                Median(callbacks),
+                Median(finish),
+                Median(apply),
+                Median(pause));
+        }
+
+        const auto trackedObjects = tracker.GetTrackedObjectsCount();
+        const auto liveObjects = CountLiveObjects(heap);
+        std::printf("%u tracked objects after %zu GCs, peak memory %.1f MB\n",
+            trackedObjects, options.collections, static_cast<double>(GetPeakMemoryBytes()) / (1024 * 1024));
+        if (trackedObjects != liveObjects)
+        {
+            std::fprintf(stderr, "Tracker holds %u objects, expected %zu.\n", trackedObjects, liveObjects);
+            return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    int RunRangesScenario(const BenchmarkOptions& options)
+    {
+        std::printf("%zu tracked objects, %zu ranges per callback, median of %zu iterations\n",
+            options.objects, options.rangesPerCallback, options.iterations);
+        std::printf("%10s %10s %15s %15s %15s\n", "ranges", "workers", "callbacks [ms]", "finish [ms]", "pause [ms]");
+        for (const auto rangeCount : options.rangeCounts)
+        {
+            auto ranges = CreateRanges(options.objects, std::max<std::size_t>(rangeCount, 1));
+            for (const auto additionalWorkers : options.additionalWorkers)
+            {
+                std::vector<double> callbacks;
+                std::vector<double> finish;
+                std::vector<double> pause;
+                for (std::size_t iteration = 0; iteration < options.iterations; ++iteration)
+                {
+                    const auto measurement = RunGarbageCollection(options, additionalWorkers, ranges);
+                    callbacks.push_back(measurement.callbacksMs);
+                    finish.push_back(measurement.finishMs);
+                    pause.push_back(measurement.callbacksMs + measurement.finishMs);
+                }
+
+                std::printf("%10zu %10zu %15.3f %15.3f %15.3f\n",
+                    ranges.survivingStarts.size() + ranges.movedOldStarts.size(),
+                    additionalWorkers + 1,
+                    Median(callbacks),
+                    Median(finish),
+                    Median(pause));
+            }
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    // Returns the duration of all walks in milliseconds
+    double RunStackWalks(
+        Benchmark::MockCorProfilerInfo& corProfilerInfo,
+        const std::vector<std::vector<FunctionID>>& stacks,
+        const BenchmarkOptions& options,
+        LibProfiler::FunctionInfoCache* functionInfoCache)
+    {
+        std::vector<BYTE> framesBlob;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t walk = 0; walk < options.walks; ++walk)
+        {
+            corProfilerInfo.SetStack(stacks[walk % stacks.size()]);
+            static_cast<void>(LibProfiler::StackWalker::CaptureCurrentStackTrace(
+                &corProfilerInfo, 0, static_cast<ULONG>(options.frames), framesBlob, functionInfoCache));
+        }
+        return ElapsedMs(start, std::chrono::steady_clock::now());
+    }
+
+    int RunStacksScenario(const BenchmarkOptions& options)
+    {
+        std::mt19937_64 random(options.seed);
+        std::uniform_int_distribution<std::size_t> functionIndices(0, options.functions - 1);
+        std::vector<std::vector<FunctionID>> stacks(DistinctStacks);
+        for (auto& stack : stacks)
+        {
+            stack.resize(options.frames);
+            for (auto& functionId : stack)
+                functionId = Benchmark::MockCorProfilerInfo::GetFunctionId(functionIndices(random));
+        }
+
+        std::printf("%zu walks of %zu frames over %zu distinct stacks of %zu functions, median of %zu iterations\n",
+            options.walks, options.frames, stacks.size(), options.functions, options.iterations);
+        std::printf("%10s %15s %15s %15s %20s\n", "resolver", "walks [ms]", "walk [ns]", "frame [ns]", "runtime calls");
+        for (const auto cached : { false, true })
+        {
+            std::vector<double> durations;
+            std::size_t runtimeCalls = 0;
+            for (std::size_t iteration = 0; iteration < options.iterations; ++iteration)
+            {
+                // Every iteration starts cold, so the reported time includes populating the cache
+                Benchmark::MockCorProfilerInfo corProfilerInfo(options.functions);
+                LibProfiler::FunctionInfoCache functionInfoCache;
+                durations.push_back(RunStackWalks(corProfilerInfo, stacks, options, cached ? &functionInfoCache : nullptr));
+                runtimeCalls = corProfilerInfo.GetFunctionInfoCalls();
+            }
+
+            const auto median = Median(durations);
+            const auto walkNs = median * 1e6 / static_cast<double>(options.walks);
+            std::printf("%10s %15.3f %15.1f %15.2f %20zu\n",
+                cached ? "cache" : "runtime",
+                median,
+                walkNs,
+                walkNs / static_cast<double>(options.frames),
+                runtimeCalls);
+        }
+
+        return EXIT_SUCCESS;
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    loguru::g_stderr_verbosity = loguru::Verbosity_WARNING;
+
+    BenchmarkOptions options;
+    if (!TryParseArguments(argc, argv, options))
+    {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    if (options.scenario == "stacks")
+        return RunStacksScenario(options);
+
+    return options.scenario == "heap"
+        ? RunHeapScenario(options)
+        : RunRangesScenario(options);
+}
@@ -16,6 +16,7 @@ internal sealed class RecordedEventFormatter(IFormatterResolver resolver)
     private const int UnionMemberCount = 2;
     private const int MethodCallMemberCount = 3;
     private const int MethodCallWithArgumentsMemberCount = 6;
+    private const int TrackedObjectIdsMemberCount = 1;
 
     private readonly IMessagePackFormatter<RecordedEvent> _envelopeFormatter = resolver.GetFormatterWithVerify<RecordedEvent>();
 
@@ -110,6 +111,22 @@ internal sealed class RecordedEventFormatter(IFormatterResolver resolver)
                 return true;
             }
 
+            case RecordedEventType.GarbageCollectedTrackedObjects when memberCount == TrackedObjectIdsMemberCount:
+            {
+                var removedTrackedObjectIds = ReadTrackedObjectIds(ref reader);
+                recordedEvent = new RecordedEvent(metadata,
+                    new GarbageCollectedTrackedObjectsRecordedEvent(removedTrackedObjectIds));
+                return true;
+            }
+
+            case RecordedEventType.FinalizationQueuedTrackedObjects when memberCount == TrackedObjectIdsMemberCount:
+            {
+                var finalizationQueuedTrackedObjectIds = ReadTrackedObjectIds(ref reader);
+                recordedEvent = new RecordedEvent(metadata,
+                    new FinalizationQueuedTrackedObjectsRecordedEvent(finalizationQueuedTrackedObjectIds));
+                return true;
+            }
+
             default:
                 return false;
         }
@@ -125,6 +142,21 @@ internal sealed class RecordedEventFormatter(IFormatterResolver resolver)
         return new MdMethodDef(reader.ReadInt32());
     }
 
+    private static TrackedObjectId[] ReadTrackedObjectIds(ref MessagePackReader reader)
+    {
+        // Encoded as TrackedObjectIdRuns by the profiler
+        var payload = reader.ReadBytes();
+        if (payload is null)
+            throw new MessagePackSerializationException("Missing tracked object ids payload.");
+
+        var sequence = payload.Value;
+        ReadOnlySpan<byte> span = sequence.IsSingleSegment ? sequence.FirstSpan : sequence.ToArray();
+        if (!TrackedObjectIdRuns.TryDecode(span, out var ids))
+            throw new MessagePackSerializationException("Malformed tracked object ids payload.");
+
+        return ids;
+    }
+
     private static byte[]? ReadPayload(ref MessagePackReader reader)
     {
         var payload = reader.ReadBytes();
@@ -44,6 +44,43 @@ public class EventBatchReaderTests
         return record;
     }
 
+    private static byte[] StackTraceDefinitionRecord(uint stackTraceId, byte[] stackFrames)
+    {
+        var record = new byte[sizeof(byte) + sizeof(uint) + stackFrames.Length];
+        record[0] = (byte)RecordedEventType.StackTraceDefinition;
+        BinaryPrimitives.WriteUInt32LittleEndian(record.AsSpan(sizeof(byte)), stackTraceId);
+        stackFrames.CopyTo(record.AsSpan(sizeof(byte) + sizeof(uint)));
+        return record;
+    }
+
+    private static byte[] FixedMethodEnterWithInternedStackRecord(uint stackTraceId)
+    {
+        // No argument blobs, the stack frames slot refers to an interned stack trace
+        var body = sizeof(byte) + FixedEventFormat.HeaderSize;
+        var record = new byte[body + 4 * sizeof(uint)];
+        record[0] = (byte)RecordedEventType.MethodEnterWithArguments;
+        BinaryPrimitives.WriteUInt32LittleEndian(record.AsSpan(body + 2 * sizeof(uint)), 0xFFFFFFFEu);
+        BinaryPrimitives.WriteUInt32LittleEndian(record.AsSpan(body + 3 * sizeof(uint)), stackTraceId);
+        return record;
+    }
+
+    private static byte[] StackSampleHistogramRecord(uint samplingPeriod, uint walks, params (uint StackTraceId, uint Count)[] entries)
+    {
+        var record = new byte[sizeof(byte) + 3 * sizeof(uint) + entries.Length * 2 * sizeof(uint)];
+        record[0] = (byte)RecordedEventType.StackSampleHistogram;
+        BinaryPrimitives.WriteUInt32LittleEndian(record.AsSpan(sizeof(byte)), samplingPeriod);
+        BinaryPrimitives.WriteUInt32LittleEndian(record.AsSpan(sizeof(byte) + sizeof(uint)), walks);
+        BinaryPrimitives.WriteUInt32LittleEndian(record.AsSpan(sizeof(byte) + 2 * sizeof(uint)), (uint)entries.Length);
+        for (var index = 0; index < entries.Length; index++)
+        {
+            var offset = sizeof(byte) + 3 * sizeof(uint) + index * 2 * sizeof(uint);
+            BinaryPrimitives.WriteUInt32LittleEndian(record.AsSpan(offset), entries[index].StackTraceId);
+            BinaryPrimitives.WriteUInt32LittleEndian(record.AsSpan(offset + sizeof(uint)), entries[index].Count);
+        }
+
+        return record;
+    }
+
     private static uint[] PidsOf(ReadOnlySpan<RecordedEvent> events, int count)
     {
         var pids = new uint[count];
@@ -187,6 +224,91 @@ public class EventBatchReaderTests
         Assert.Equal<uint>([2], PidsOf(destination, result.Count));
     }
 
+    [Fact]
+    public void ReadInto_ResolvesInternedStackTracesAcrossBatches()
+    {
+        var reader = new EventBatchReader(new StubParser(), ReceiverPid);
+        byte[] stackFrames = [1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12];
+        reader.SetBatch(EventBatchProtocolTests.BuildBatch(
+            StackTraceDefinitionRecord(3, stackFrames),
+            FixedMethodEnterWithInternedStackRecord(3)));
+
+        var destination = new RecordedEvent[8];
+        var first = reader.ReadInto(destination);
+        reader.SetBatch(EventBatchProtocolTests.BuildBatch(FixedMethodEnterWithInternedStackRecord(3)));
+        var second = reader.ReadInto(destination.AsSpan(first.Count));
+
+        Assert.Equal(1, first.Count);
+        Assert.Equal(1, second.Count);
+        Assert.Equal(0, first.FailedRecords + second.FailedRecords);
+        foreach (var recordedEvent in destination[..2])
+        {
+            var args = Assert.IsType<MethodEnterWithArgumentsRecordedEvent>(recordedEvent.EventArgs);
+            Assert.Equal(stackFrames, args.StackFrames);
+        }
+    }
+
+    [Fact]
+    public void ReadInto_KeepsRecordsReferringToUndefinedStackTracesWithoutFrames()
+    {
+        var reader = new EventBatchReader(new StubParser(), ReceiverPid);
+        reader.SetBatch(EventBatchProtocolTests.BuildBatch(FixedMethodEnterWithInternedStackRecord(7), Record(1)));
+
+        var destination = new RecordedEvent[8];
+        var result = reader.ReadInto(destination);
+
+        Assert.Equal(2, result.Count);
+        Assert.Equal(0, result.FailedRecords);
+        var args = Assert.IsType<MethodEnterWithArgumentsRecordedEvent>(destination[0].EventArgs);
+        Assert.NotNull(args.StackFrames);
+        Assert.Empty(args.StackFrames);
+        Assert.Equal<uint>([ReceiverPid, 1], PidsOf(destination, result.Count));
+    }
+
+    [Fact]
+    public void ReadInto_ResolvesStackSampleHistograms()
+    {
+        var reader = new EventBatchReader(new StubParser(), ReceiverPid);
+        byte[] firstStack = [1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12];
+        byte[] secondStack = [12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1];
+        reader.SetBatch(EventBatchProtocolTests.BuildBatch(
+            StackTraceDefinitionRecord(0, firstStack),
+            StackTraceDefinitionRecord(1, secondStack),
+            StackSampleHistogramRecord(10, 100, (1, 40), (0, 100))));
+
+        var destination = new RecordedEvent[8];
+        var result = reader.ReadInto(destination);
+
+        Assert.Equal(1, result.Count);
+        Assert.Equal(0, result.FailedRecords);
+        Assert.Equal(ReceiverPid, destination[0].Metadata.Pid);
+        var args = Assert.IsType<StackSampleHistogramRecordedEvent>(destination[0].EventArgs);
+        Assert.Equal(10u, args.SamplingPeriodMilliseconds);
+        Assert.Equal(100u, args.Walks);
+        Assert.Equal(2, args.Samples.Length);
+        Assert.Equal(secondStack, args.Samples[0].StackFrames);
+        Assert.Equal(40u, args.Samples[0].Count);
+        Assert.Equal(firstStack, args.Samples[1].StackFrames);
+        Assert.Equal(100u, args.Samples[1].Count);
+    }
+
+    [Fact]
+    public void ReadInto_KeepsSamplesOfUndefinedStackTracesWithoutFrames()
+    {
+        var reader = new EventBatchReader(new StubParser(), ReceiverPid);
+        reader.SetBatch(EventBatchProtocolTests.BuildBatch(StackSampleHistogramRecord(10, 1, (5, 1)), Record(1)));
+
+        var destination = new RecordedEvent[8];
+        var result = reader.ReadInto(destination);
+
+        Assert.Equal(2, result.Count);
+        Assert.Equal(0, result.FailedRecords);
+        var args = Assert.IsType<StackSampleHistogramRecordedEvent>(destination[0].EventArgs);
+        var sample = Assert.Single(args.Samples);
+        Assert.Empty(sample.StackFrames);
+        Assert.Equal(1u, sample.Count);
+    }
+
     [Fact]
     public void ReadInto_ReturnsNothingWhenNoBatchIsSet()
     {
@@ -0,0 +1,88 @@
+// Copyright 2026 Andrej Čižmárik and Contributors
+// SPDX-License-Identifier: Apache-2.0
+
+using SharpDetect.Core.Events;
+using SharpDetect.Core.Events.Profiler;
+using Xunit;
+
+namespace SharpDetect.Core.Tests.Events;
+
+public class TrackedObjectIdRunsTests
+{
+    private static TrackedObjectId[] Ids(params ulong[] values)
+        => values.Select(value => new TrackedObjectId((nuint)value)).ToArray();
+
+    [Fact]
+    public void TryDecode_ReadsProfilerEncoding()
+    {
+        // Shared with the native encoder tests
+        byte[] payload = [0x05, 0x01, 0x02, 0x06, 0x00, 0xBD, 0x01, 0x00];
+
+        Assert.True(TrackedObjectIdRuns.TryDecode(payload, out var ids));
+        Assert.Equal(Ids(1, 2, 3, 10, 200), ids);
+    }
+
+    [Fact]
+    public void Encode_MatchesProfilerEncoding()
+    {
+        var payload = TrackedObjectIdRuns.Encode(Ids(1, 2, 3, 10, 200));
+
+        Assert.Equal(new byte[] { 0x05, 0x01, 0x02, 0x06, 0x00, 0xBD, 0x01, 0x00 }, payload);
+    }
+
+    [Fact]
+    public void EmptySet_RoundTrips()
+    {
+        var payload = TrackedObjectIdRuns.Encode([]);
+
+        Assert.Equal(new byte[] { 0x00 }, payload);
+        Assert.True(TrackedObjectIdRuns.TryDecode(payload, out var ids));
+        Assert.Empty(ids);
+    }
+
+    [Fact]
+    public void RandomSets_RoundTrip()
+    {
+        var random = new Random(42);
+        for (var iteration = 0; iteration < 100; iteration++)
+        {
+            var values = new List<ulong>();
+            var value = (ulong)random.Next(1000);
+            var count = random.Next(5000);
+            for (var index = 0; index < count; index++)
+            {
+                values.Add(value);
+                value += random.Next(8) == 0 ? (ulong)random.Next(1, 100000) : 1;
+            }
+
+            var expected = Ids(values.ToArray());
+            Assert.True(TrackedObjectIdRuns.TryDecode(TrackedObjectIdRuns.Encode(expected), out var ids));
+            Assert.Equal(expected, ids);
+        }
+    }
+
+    [Fact]
+    public void WholeCollectedGeneration_FitsIntoFewBytes()
+    {
+        var expected = Enumerable.Range(1_000_000, 1_000_000)
+            .Select(value => new TrackedObjectId((nuint)value))
+            .ToArray();
+
+        var payload = TrackedObjectIdRuns.Encode(expected);
+
+        Assert.Equal(9, payload.Length);
+        Assert.True(TrackedObjectIdRuns.TryDecode(payload, out var ids));
+        Assert.Equal(expected, ids);
+    }
+
+    [Theory]
+    [InlineData(new byte[0])]
+    [InlineData(new byte[] { 0x02, 0x01, 0x80 })]
+    [InlineData(new byte[] { 0x01, 0x01 })]
+    [InlineData(new byte[] { 0x02, 0x01, 0x05 })]
+    [InlineData(new byte[] { 0x03, 0x01, 0x00 })]
+    public void MalformedPayload_IsRejected(byte[] payload)
+    {
+        Assert.False(TrackedObjectIdRuns.TryDecode(payload, out _));
+    }
+}
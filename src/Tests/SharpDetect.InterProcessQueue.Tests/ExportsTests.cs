@@ -119,4 +119,35 @@ public unsafe class ExportsTests : InterProcessQueueTestsBase
             Exports.DestroyConsumerImpl(consumerHandle);
         }
     }
+
+    [Fact]
+    public void Exports_DequeueWithInfiniteTimeout_ReturnsNothingToReadWhenWoken()
+    {
+        // Arrange (dedicated semaphore, other tests may leave unconsumed signals behind)
+        const string semaphoreName = "SHARPDETECT_IPQ_Exports_Wake_Test_Semaphore";
+        var consumerHandle = Exports.CreateConsumerImpl(TestQueueName, TestFileName, semaphoreName, TestQueueSize);
+        Assert.NotEqual(0, consumerHandle);
+
+        try
+        {
+            var dequeueTask = Task.Run(() =>
+            {
+                byte* dataPtr = null;
+                var size = 0;
+                return Exports.DequeueWithTimeoutImpl(consumerHandle, &dataPtr, &size, timeoutMs: -1);
+            });
+
+            // Act
+            Assert.False(dequeueTask.Wait(TimeSpan.FromMilliseconds(100)));
+            Exports.WakeConsumerImpl(consumerHandle);
+
+            // Assert
+            Assert.True(dequeueTask.Wait(TimeSpan.FromSeconds(5)));
+            Assert.Equal(DequeueErrorType.NothingToRead, dequeueTask.Result);
+        }
+        finally
+        {
+            Exports.DestroyConsumerImpl(consumerHandle);
+        }
+    }
 }